@@ -0,0 +1,97 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#ifndef DEVOPCUA_CACHEFILE_H
+#define DEVOPCUA_CACHEFILE_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace DevOpcua {
+
+/**
+ * @brief Write a length-prefixed string (" <length>:<bytes>") to a cache file.
+ *
+ * Any bytes (including white space and NUL) survive the round trip.
+ *
+ * @param os  output stream
+ * @param str  string to write
+ */
+inline void
+writeToken (std::ostream &os, const std::string &str)
+{
+    os << ' ' << str.length() << ':' << str;
+}
+
+/**
+ * @brief Read a length-prefixed string written by writeToken.
+ *
+ * @param is  input stream
+ * @param[out] str  string read
+ * @return true if a complete token was read
+ */
+inline bool
+readToken (std::istream &is, std::string &str)
+{
+    size_t len;
+    char c;
+    if (!(is >> len) || !is.get(c) || c != ':')
+        return false;
+    str.resize(len);
+    return len == 0 || is.read(&str[0], len);
+}
+
+/**
+ * @brief Write the header line of a cache file.
+ *
+ * @param os  output stream
+ * @param magic  file type marker
+ * @param version  file format version
+ * @param tags  strings that the contents depend on (library version, server fingerprint, ...)
+ */
+inline void
+writeCacheHeader (std::ostream &os, const std::string &magic, const unsigned int version,
+                  const std::vector<std::string> &tags)
+{
+    os << magic << ' ' << version;
+    for (const auto &tag : tags)
+        writeToken(os, tag);
+    os << '\n';
+}
+
+/**
+ * @brief Read and check the header line of a cache file.
+ *
+ * @param is  input stream
+ * @param magic  expected file type marker
+ * @param version  expected file format version
+ * @param tags  expected tags (in the order they were written)
+ * @return true if the file matches, false if it is damaged or stale
+ */
+inline bool
+readCacheHeader (std::istream &is, const std::string &magic, const unsigned int version,
+                 const std::vector<std::string> &tags)
+{
+    std::string m, tag;
+    unsigned int v;
+    if (!(is >> m >> v) || m != magic || v != version)
+        return false;
+    for (const auto &expected : tags)
+        if (!readToken(is, tag) || tag != expected)
+            return false;
+    return true;
+}
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_CACHEFILE_H
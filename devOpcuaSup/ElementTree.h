@@ -34,7 +34,9 @@ namespace DevOpcua {
  *
  * The tree implementation makes heavy use of C++ smart pointers:
  * Each Element has a shared_ptr to its parent.
- * Each Node has a std::vector of weak_ptr to its children.
+ * Each Node has a std::vector of weak_ptr to its children (keeping their order)
+ * and a hash index of the same weak_ptrs by child name, so that findChild()
+ * does not depend on the number of children.
  * That way any Leaf can freely be added or removed and all intermediate
  * Nodes are properly added, ref-counted and deleted.
  *
@@ -46,6 +48,8 @@ namespace DevOpcua {
  *    and methods          void NE::setParent(std::shared_ptr<NE> parent);
  *                         void NE::addChild(std::weak_ptr<NE> child);
  *                         std::shared_ptr<NE> findChild(const std::string &name)
+ *    (findChild is called once per path element of every leaf that is added,
+ *     it should use a hash lookup)
  *
  * E is the common base class of Node Element (NE) and Leaf Element
  *    with the method      void E::setParent(std::shared_ptr<E> parent);
@@ -77,28 +81,9 @@ public:
      */
     std::shared_ptr<E> nearestNode(std::list<std::string> &path)
     {
-        bool found;
-
-        if (path.empty())
-            return std::shared_ptr<E>();
-
-        // Starting from unnamed root node
-        std::shared_ptr<E> elem = rootElement.lock();
-
-        // Walk down the chain of children as long as names match
-        do {
-            auto part = path.begin();
-            found = false;
-            if (elem && !elem->isLeaf()) {
-                auto nextelem = elem->findChild(*part);
-                if (nextelem) {
-                    found = true;
-                    elem = std::move(nextelem);
-                    path.pop_front();
-                }
-            }
-        } while (found && !path.empty());
-
+        std::list<std::string>::const_iterator part = path.cbegin();
+        std::shared_ptr<E> elem = nearestNode(part, path.cend());
+        path.erase(path.cbegin(), part);
         return elem;
     }
 
@@ -114,19 +99,20 @@ public:
     void addLeaf (std::shared_ptr<E> leaf, const std::list<std::string> &fullpath, I *item)
     {
         std::shared_ptr<E> elem(leaf);
-        std::list<std::string> path(fullpath);
+        auto part = fullpath.cbegin();
 
-        auto branch = nearestNode(path);
+        auto branch = nearestNode(part, fullpath.cend());
 
         if (branch && branch->isLeaf())
             throw std::runtime_error(SB() << "can't add leaf to existing leaf " << branch->name);
-        if (path.empty()) {
+        if (part == fullpath.cend()) {
             if (rootElement.lock())
                 throw std::runtime_error(SB() << "root node does already exist");
             rootElement = elem;
         } else {
-            path.pop_back(); // remove the leaf name
-            for (auto rit = path.crbegin(); rit != path.crend(); ++rit) {
+            // Create the missing intermediate nodes bottom-up, skipping the leaf name
+            auto rit = fullpath.crbegin();
+            for (++rit; rit.base() != part; ++rit) {
                 auto node = std::make_shared<NE>(*rit, item);
                 node->addChild(elem);
                 elem->setParent(node);
@@ -148,6 +134,35 @@ public:
     void setRoot(std::shared_ptr<E> root) { rootElement = root; }
 
 private:
+    /**
+     * @brief Walk down the tree along a path without modifying it.
+     *
+     * @param[in,out] part  first path element; on return first element not found in the tree
+     * @param[in] end  end of the path
+     *
+     * @return shared_ptr to the nearest existing node in the tree, shared_ptr<>() if no overlap
+     */
+    std::shared_ptr<E> nearestNode(std::list<std::string>::const_iterator &part,
+                                   const std::list<std::string>::const_iterator end)
+    {
+        if (part == end)
+            return std::shared_ptr<E>();
+
+        // Starting from unnamed root node
+        std::shared_ptr<E> elem = rootElement.lock();
+
+        // Walk down the chain of children as long as names match
+        while (elem && !elem->isLeaf() && part != end) {
+            auto nextelem = elem->findChild(*part);
+            if (!nextelem)
+                break;
+            elem = std::move(nextelem);
+            ++part;
+        }
+
+        return elem;
+    }
+
     std::weak_ptr<E> rootElement;
 };
 
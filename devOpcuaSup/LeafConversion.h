@@ -0,0 +1,466 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#ifndef DEVOPCUA_LEAFCONVERSION_H
+#define DEVOPCUA_LEAFCONVERSION_H
+
+#include <limits>
+#include <type_traits>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include <epicsTypes.h>
+
+#include "StringConversion.h"
+
+namespace DevOpcua {
+
+typedef std::map<epicsUInt32, std::string> EnumChoices;
+
+inline const char *epicsTypeString (const epicsInt8 &) { return "epicsInt8"; }
+inline const char *epicsTypeString (const epicsUInt8 &) { return "epicsUInt8"; }
+inline const char *epicsTypeString (const epicsInt16 &) { return "epicsInt16"; }
+inline const char *epicsTypeString (const epicsUInt16 &) { return "epicsUInt16"; }
+inline const char *epicsTypeString (const epicsInt32 &) { return "epicsInt32"; }
+inline const char *epicsTypeString (const epicsUInt32 &) { return "epicsUInt32"; }
+inline const char *epicsTypeString (const epicsInt64 &) { return "epicsInt64"; }
+inline const char *epicsTypeString (const epicsUInt64 &) { return "epicsUInt64"; }
+inline const char *epicsTypeString (const epicsFloat32 &) { return "epicsFloat32"; }
+inline const char *epicsTypeString (const epicsFloat64 &) { return "epicsFloat64"; }
+inline const char *epicsTypeString (const char *) { return "epicsString"; }
+
+namespace detail {
+
+// Numeric categories for the range check dispatch
+typedef std::integral_constant<int, 0> FloatingCategory;
+typedef std::integral_constant<int, 1> SignedCategory;
+typedef std::integral_constant<int, 2> UnsignedCategory;
+
+template<typename T>
+struct numericCategory
+    : std::integral_constant<int, std::is_floating_point<T>::value ? 0 : std::is_signed<T>::value ? 1 : 2>
+{};
+
+// True if every value of FROM is representable in TO (no check needed)
+template<typename TO, typename FROM>
+struct isWidening
+    : std::integral_constant<bool,
+          std::is_floating_point<TO>::value
+              ? (!std::is_floating_point<FROM>::value || sizeof(FROM) <= sizeof(TO))
+              : (std::is_integral<FROM>::value
+                 && (std::is_signed<TO>::value || !std::is_signed<FROM>::value)
+                 && std::numeric_limits<FROM>::digits <= std::numeric_limits<TO>::digits)>
+{};
+
+template<typename TO, typename FROM, typename TOCAT, typename FROMCAT>
+struct RangeCheck
+{
+    // Any conversion from or to floating point
+    static bool check (const FROM &value)
+    {
+        return !(value < std::numeric_limits<TO>::lowest() || value > std::numeric_limits<TO>::max());
+    }
+};
+
+template<typename TO, typename FROM>
+struct RangeCheck<TO, FROM, SignedCategory, SignedCategory>
+{
+    static bool check (const FROM &value)
+    {
+        return !(value < static_cast<FROM>(std::numeric_limits<TO>::min())
+                 || value > static_cast<FROM>(std::numeric_limits<TO>::max()));
+    }
+};
+
+template<typename TO, typename FROM>
+struct RangeCheck<TO, FROM, UnsignedCategory, UnsignedCategory>
+{
+    static bool check (const FROM &value)
+    {
+        return !(value > static_cast<FROM>(std::numeric_limits<TO>::max()));
+    }
+};
+
+template<typename TO, typename FROM>
+struct RangeCheck<TO, FROM, SignedCategory, UnsignedCategory>
+{
+    // Only reached if TO is narrower than FROM, so TO's max fits into FROM
+    static bool check (const FROM &value)
+    {
+        return !(value > static_cast<FROM>(std::numeric_limits<TO>::max()));
+    }
+};
+
+template<typename TO, typename FROM>
+struct RangeCheck<TO, FROM, UnsignedCategory, SignedCategory>
+{
+    static bool check (const FROM &value)
+    {
+        typedef typename std::make_unsigned<FROM>::type UFROM;
+        return !(value < 0)
+               && (std::numeric_limits<FROM>::digits <= std::numeric_limits<TO>::digits
+                   || !(static_cast<UFROM>(value) > static_cast<UFROM>(std::numeric_limits<TO>::max())));
+    }
+};
+
+template<typename TO, typename FROM>
+inline bool
+isWithinRange (const FROM &, std::true_type /* isWidening */)
+{
+    return true;
+}
+
+template<typename TO, typename FROM>
+inline bool
+isWithinRange (const FROM &value, std::false_type /* isWidening */)
+{
+    return RangeCheck<TO, FROM,
+                      typename numericCategory<TO>::type, typename numericCategory<FROM>::type>::check(value);
+}
+
+} // namespace detail
+
+/**
+ * @brief Range check for converting a number between two numeric types.
+ *
+ * The check is selected at compile time from the signedness and widths
+ * of both types, so that no comparisons between signed and unsigned values
+ * are generated, and conversions to a wider type need no check at all.
+ *
+ * @tparam TO  target type
+ * @param value  value to convert
+ *
+ * @return true if value can be converted to TO without leaving its range
+ */
+template<typename TO, typename FROM>
+inline bool
+isWithinRange (const FROM &value)
+{
+    return detail::isWithinRange<TO>(value, detail::isWidening<TO, FROM>());
+}
+
+/**
+ * @brief Backend-neutral kind of an OPC UA scalar value.
+ */
+enum class ScalarKind {
+    unsupported,
+    boolean,
+    sByte,
+    byte,
+    int16,
+    uInt16,
+    int32,
+    uInt32,
+    int64,
+    uInt64,
+    float32,
+    float64,
+    enumeration,
+    string,
+    localizedText
+};
+
+/**
+ * @brief Result of a scalar conversion.
+ */
+enum class ConversionResult {
+    ok,          /**< value converted */
+    outOfRange,  /**< value does not fit the target */
+    unsupported  /**< no conversion for this kind of value */
+};
+
+/**
+ * @brief Conversion core shared by the data element leafs of all client libraries.
+ *
+ * Implements the conversions between the EPICS types used by device support
+ * and OPC UA scalar values once, for all client libraries. Array values
+ * are passed as memory blocks of matching element type, see copyArray().
+ *
+ * Access to the client library's variant type is provided by a traits class:
+ *
+ * @code
+ * struct Traits {
+ *     typedef ... Variant;         // the library's variant type
+ *     typedef ... Status;          // the library's status code type
+ *     typedef ... SByte;           // OPC UA built-in numeric types
+ *     ...                          // (Byte, Int16, UInt16, Int32, UInt32,
+ *     typedef ... Double;          //  Int64, UInt64, Float)
+ *
+ *     static ScalarKind kindOf(const Variant &);
+ *     static bool getBoolean(const Variant &);
+ *     static void get(const Variant &, T &);       // for each numeric type T
+ *     static void getText(const Variant &, const char *&str, size_t &len);
+ *     static Status setBoolean(Variant &, bool);
+ *     static Status set(Variant &, const T);       // for each numeric type T
+ *     static Status setText(Variant &, ScalarKind kind, const char *str, size_t len,
+ *                           const Variant &incoming);
+ * };
+ * @endcode
+ *
+ * The client specific part of the leaf (queues, locking, alarms, debug output)
+ * stays in the leaf class, which calls these functions for the conversion itself.
+ */
+template<typename Traits>
+class LeafConversion
+{
+public:
+    typedef typename Traits::Variant Variant;
+    typedef typename Traits::Status Status;
+
+    /**
+     * @brief Convert an incoming scalar value to an EPICS type.
+     *
+     * @param[in] data  incoming OPC UA value
+     * @param[out] value  converted value (may be changed on failure)
+     * @param[in] enumChoices  enum definition (if the value is an enum), nullptr otherwise
+     *
+     * @return conversion result
+     */
+    template<typename ET>
+    static ConversionResult
+    toEpics (const Variant &data, ET &value, const EnumChoices *enumChoices = nullptr)
+    {
+        switch (Traits::kindOf(data)) {
+        case ScalarKind::boolean:
+            value = Traits::getBoolean(data);
+            return ConversionResult::ok;
+        case ScalarKind::sByte:
+            return fetch<typename Traits::SByte>(data, value);
+        case ScalarKind::byte:
+            return fetch<typename Traits::Byte>(data, value);
+        case ScalarKind::int16:
+            return fetch<typename Traits::Int16>(data, value);
+        case ScalarKind::uInt16:
+            return fetch<typename Traits::UInt16>(data, value);
+        case ScalarKind::int32:
+            return fetch<typename Traits::Int32>(data, value);
+        case ScalarKind::uInt32:
+            return fetch<typename Traits::UInt32>(data, value);
+        case ScalarKind::int64:
+            return fetch<typename Traits::Int64>(data, value);
+        case ScalarKind::uInt64:
+            return fetch<typename Traits::UInt64>(data, value);
+        case ScalarKind::float32:
+            return fetch<typename Traits::Float>(data, value);
+        case ScalarKind::float64:
+            return fetch<typename Traits::Double>(data, value);
+        case ScalarKind::enumeration:
+        {
+            ConversionResult result = fetch<typename Traits::Int32>(data, value);
+            if (result == ConversionResult::ok && enumChoices
+                && enumChoices->find(static_cast<epicsUInt32>(value)) == enumChoices->end())
+                result = ConversionResult::outOfRange;
+            return result;
+        }
+        case ScalarKind::string:
+        case ScalarKind::localizedText:
+        {
+            const char *str;
+            size_t len;
+            Traits::getText(data, str, len);
+            return parseNumber(str, len, value) ? ConversionResult::ok : ConversionResult::outOfRange;
+        }
+        default:
+            return ConversionResult::unsupported;
+        }
+    }
+
+    /**
+     * @brief Convert an EPICS value to an outgoing scalar value.
+     *
+     * @param[in] value  EPICS value
+     * @param[in] kind  kind of the outgoing value
+     * @param[in] incoming  current incoming value (supplies e.g. the locale of a localized text)
+     * @param[out] outgoing  outgoing OPC UA value
+     * @param[in] enumChoices  enum definition (if the value is an enum), nullptr otherwise
+     * @param[out] status  status of the client library's set operation (set if ok)
+     *
+     * @return conversion result
+     */
+    template<typename ET>
+    static ConversionResult
+    fromEpics (const ET &value, const ScalarKind kind, const Variant &incoming, Variant &outgoing,
+               const EnumChoices *enumChoices, Status &status)
+    {
+        switch (kind) {
+        case ScalarKind::boolean:
+            status = Traits::setBoolean(outgoing, value != 0);
+            return ConversionResult::ok;
+        case ScalarKind::sByte:
+            return store<typename Traits::SByte>(value, outgoing, status);
+        case ScalarKind::byte:
+            return store<typename Traits::Byte>(value, outgoing, status);
+        case ScalarKind::int16:
+            return store<typename Traits::Int16>(value, outgoing, status);
+        case ScalarKind::uInt16:
+            return store<typename Traits::UInt16>(value, outgoing, status);
+        case ScalarKind::int32:
+        case ScalarKind::enumeration:
+            if (!isWithinRange<typename Traits::Int32>(value)
+                || (enumChoices && enumChoices->find(static_cast<epicsUInt32>(value)) == enumChoices->end()))
+                return ConversionResult::outOfRange;
+            status = Traits::set(outgoing, static_cast<typename Traits::Int32>(value));
+            return ConversionResult::ok;
+        case ScalarKind::uInt32:
+            return store<typename Traits::UInt32>(value, outgoing, status);
+        case ScalarKind::int64:
+            return store<typename Traits::Int64>(value, outgoing, status);
+        case ScalarKind::uInt64:
+            return store<typename Traits::UInt64>(value, outgoing, status);
+        case ScalarKind::float32:
+            return store<typename Traits::Float>(value, outgoing, status);
+        case ScalarKind::float64:
+            return store<typename Traits::Double>(value, outgoing, status);
+        case ScalarKind::string:
+        case ScalarKind::localizedText:
+        {
+            char strval[maxNumberStringLength + 1];
+            size_t len = formatNumber(strval, sizeof(strval), value);
+            if (!len)
+                return ConversionResult::outOfRange;
+            status = Traits::setText(outgoing, kind, strval, len, incoming);
+            return ConversionResult::ok;
+        }
+        default:
+            return ConversionResult::unsupported;
+        }
+    }
+
+    /**
+     * @brief Convert an EPICS string to an outgoing boolean, numeric or enum scalar value.
+     *
+     * Enum values are matched against the enum choice strings first,
+     * then as a number, in case a choice string starts with a number
+     * but means a different value.
+     *
+     * @param[in] value  input characters
+     * @param[in] len  number of input characters
+     * @param[in] kind  kind of the outgoing value
+     * @param[out] outgoing  outgoing OPC UA value
+     * @param[in] enumChoices  enum definition (if the value is an enum), nullptr otherwise
+     * @param[out] status  status of the client library's set operation (set if ok)
+     *
+     * @return conversion result
+     */
+    static ConversionResult
+    fromString (const char *value, const size_t len, const ScalarKind kind, Variant &outgoing,
+                const EnumChoices *enumChoices, Status &status)
+    {
+        switch (kind) {
+        case ScalarKind::boolean:
+            status = Traits::setBoolean(outgoing, strchr("YyTt1", *value) != nullptr);
+            return ConversionResult::ok;
+        case ScalarKind::sByte:
+            return parse<typename Traits::SByte>(value, len, outgoing, status);
+        case ScalarKind::byte:
+            return parse<typename Traits::Byte>(value, len, outgoing, status);
+        case ScalarKind::int16:
+            return parse<typename Traits::Int16>(value, len, outgoing, status);
+        case ScalarKind::uInt16:
+            return parse<typename Traits::UInt16>(value, len, outgoing, status);
+        case ScalarKind::int32:
+        case ScalarKind::enumeration:
+        {
+            typename Traits::Int32 val = 0;
+            bool valid = parseNumber(value, len, val);
+            if (enumChoices) {
+                bool found = false;
+                for (const auto &it : *enumChoices)
+                    if (it.second.length() == len && it.second.compare(0, len, value, len) == 0) {
+                        found = isWithinRange<typename Traits::Int32>(it.first);
+                        val = static_cast<typename Traits::Int32>(it.first);
+                        break;
+                    }
+                if (!found && valid && val >= 0)
+                    found = enumChoices->find(static_cast<epicsUInt32>(val)) != enumChoices->end();
+                valid = found;
+            }
+            if (!valid)
+                return ConversionResult::outOfRange;
+            status = Traits::set(outgoing, val);
+            return ConversionResult::ok;
+        }
+        case ScalarKind::uInt32:
+            return parse<typename Traits::UInt32>(value, len, outgoing, status);
+        case ScalarKind::int64:
+            return parse<typename Traits::Int64>(value, len, outgoing, status);
+        case ScalarKind::uInt64:
+            return parse<typename Traits::UInt64>(value, len, outgoing, status);
+        case ScalarKind::float32:
+            return parse<typename Traits::Float>(value, len, outgoing, status);
+        case ScalarKind::float64:
+            return parse<typename Traits::Double>(value, len, outgoing, status);
+        default:
+            return ConversionResult::unsupported;
+        }
+    }
+
+    /**
+     * @brief Copy the elements of an incoming array into an EPICS array.
+     *
+     * The element types must match (checked by the caller).
+     *
+     * @param[out] value  EPICS array
+     * @param[in] num  capacity of the EPICS array
+     * @param[in] data  incoming array elements
+     * @param[in] size  number of incoming array elements
+     *
+     * @return number of elements copied
+     */
+    template<typename ET>
+    static epicsUInt32
+    copyArray (ET *value, const epicsUInt32 num, const void *data, const size_t size)
+    {
+        epicsUInt32 n = size < num ? static_cast<epicsUInt32>(size) : num;
+        if (n)
+            memcpy(value, data, sizeof(ET) * n);
+        return n;
+    }
+
+private:
+    template<typename OT, typename ET>
+    static ConversionResult
+    fetch (const Variant &data, ET &value)
+    {
+        OT v;
+        Traits::get(data, v);
+        if (!isWithinRange<ET>(v))
+            return ConversionResult::outOfRange;
+        value = static_cast<ET>(v);
+        return ConversionResult::ok;
+    }
+
+    template<typename OT, typename ET>
+    static ConversionResult
+    store (const ET &value, Variant &outgoing, Status &status)
+    {
+        if (!isWithinRange<OT>(value))
+            return ConversionResult::outOfRange;
+        status = Traits::set(outgoing, static_cast<OT>(value));
+        return ConversionResult::ok;
+    }
+
+    template<typename OT>
+    static ConversionResult
+    parse (const char *value, const size_t len, Variant &outgoing, Status &status)
+    {
+        OT val;
+        if (!parseNumber(value, len, val))
+            return ConversionResult::outOfRange;
+        status = Traits::set(outgoing, val);
+        return ConversionResult::ok;
+    }
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_LEAFCONVERSION_H
@@ -0,0 +1,139 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#ifndef DEVOPCUA_LRUCACHE_H
+#define DEVOPCUA_LRUCACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace DevOpcua {
+
+/**
+ * @brief A map of limited size that drops its least recently used entry when full.
+ *
+ * Pointers and references to values stay valid until their entry is
+ * erased or evicted. Not thread safe: the user has to provide locking.
+ *
+ * @tparam K  key type
+ * @tparam V  value type (default constructible)
+ * @tparam Compare  strict weak ordering of the keys
+ */
+template<typename K, typename V, typename Compare = std::less<K>>
+class LruCache
+{
+    typedef std::list<std::pair<K, V>> List;
+
+public:
+    /**
+     * @brief Construct an empty cache.
+     * @param capacity  max number of entries (at least one entry is kept)
+     */
+    explicit LruCache(const size_t capacity = 1)
+        : maxSize(capacity)
+        , evictions(0)
+    {}
+
+    /**
+     * @brief Set the max number of entries, evicting the least recently used ones.
+     * @param capacity  max number of entries (at least one entry is kept)
+     */
+    void setCapacity(const size_t capacity)
+    {
+        maxSize = capacity;
+        while (entries.size() > 1 && entries.size() > maxSize)
+            evictOne();
+    }
+
+    size_t capacity() const { return maxSize; }
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+    /**
+     * @brief Number of entries dropped to make room for new ones.
+     */
+    unsigned long evicted() const { return evictions; }
+
+    /**
+     * @brief Look up an entry and mark it most recently used.
+     * @param key  key to look up
+     * @return pointer to the value (nullptr if not found)
+     */
+    V *find(const K &key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+            return nullptr;
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    /**
+     * @brief Insert a default constructed value (or get the existing one)
+     * and mark it most recently used.
+     *
+     * The least recently used entry is evicted if the cache is full.
+     *
+     * @param key  key of the entry
+     * @return reference to the value
+     */
+    V &insert(const K &key)
+    {
+        if (V *value = find(key))
+            return *value;
+        while (entries.size() && entries.size() >= maxSize)
+            evictOne();
+        entries.emplace_front(key, V());
+        index.emplace(key, entries.begin());
+        return entries.front().second;
+    }
+
+    /**
+     * @brief Remove an entry (if present).
+     * @param key  key of the entry
+     */
+    void erase(const K &key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+            return;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+    /**
+     * @brief Remove all entries.
+     */
+    void clear()
+    {
+        index.clear();
+        entries.clear();
+    }
+
+private:
+    void evictOne()
+    {
+        index.erase(entries.back().first);
+        entries.pop_back();
+        evictions++;
+    }
+
+    List entries;                                             /**< entries, most recently used first */
+    std::map<K, typename List::iterator, Compare> index;      /**< entries by key */
+    size_t maxSize;                                           /**< max number of entries */
+    unsigned long evictions;                                  /**< number of evicted entries */
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_LRUCACHE_H
@@ -0,0 +1,121 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#ifndef DEVOPCUA_RECONNECTPOLICY_H
+#define DEVOPCUA_RECONNECTPOLICY_H
+
+#include <algorithm>
+
+#include <epicsTime.h>
+
+namespace DevOpcua {
+
+/**
+ * @brief Delay before a reconnect attempt, growing exponentially.
+ *
+ * @param delay  delay before the first attempt [s]
+ * @param consecutive  number of consecutive attempts so far
+ * @param factor  growth factor per attempt (<= 1: fixed delay)
+ * @param max  upper limit of the delay [s] (at least delay)
+ * @return delay [s]
+ */
+inline double
+backoffDelay (const double delay, const unsigned int consecutive, const double factor, const double max)
+{
+    double d = delay;
+    if (factor > 1.0) {
+        const double limit = std::max(delay, max);
+        for (unsigned int i = 1; i < consecutive && d < limit; i++)
+            d *= factor;
+        d = std::min(d, limit);
+    }
+    return d;
+}
+
+/**
+ * @brief Randomize a delay by +/- a fraction.
+ *
+ * @param delay  delay [s]
+ * @param jitter  max. fraction of the delay to add or subtract (<= 0: none)
+ * @param random  uniform random number in [0,1)
+ * @return randomized delay [s]
+ */
+inline double
+jitterDelay (const double delay, const double jitter, const double random)
+{
+    if (jitter <= 0.0)
+        return delay;
+    return delay * (1.0 + jitter * (2.0 * random - 1.0));
+}
+
+/**
+ * @brief Uniform random number in [0,1) from a linear congruential generator.
+ *
+ * Good enough for spreading out reconnects, not for cryptographic use.
+ *
+ * @param seed  generator state (updated)
+ * @return random number
+ */
+inline double
+lcgRandom (unsigned int &seed)
+{
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) / 16777216.0;
+}
+
+/**
+ * @brief Token bucket limiting the rate of events.
+ *
+ * Refills at the given rate, holding up to max(1, rate) tokens.
+ * Starts full. Not thread safe: the user has to provide locking.
+ */
+class TokenBucket
+{
+public:
+    TokenBucket()
+        : tokens(0.0)
+        , started(false)
+    {}
+
+    /**
+     * @brief Take a token if one is available.
+     *
+     * @param now  current time
+     * @param rate  refill rate [tokens/s] (<= 0: no limit)
+     * @return 0 if a token was taken, else the time until the next token [s]
+     */
+    double take(const epicsTime &now, const double rate)
+    {
+        if (rate <= 0.0)
+            return 0.0;
+        const double burst = std::max(1.0, rate);
+        if (!started) {
+            tokens = burst;
+            started = true;
+        } else {
+            tokens = std::min(burst, tokens + (now - refilled) * rate);
+        }
+        refilled = now;
+        if (tokens >= 1.0) {
+            tokens -= 1.0;
+            return 0.0;
+        }
+        return (1.0 - tokens) / rate;
+    }
+
+private:
+    double tokens;          /**< available tokens */
+    epicsTime refilled;     /**< time of last refill */
+    bool started;           /**< a token was taken before */
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_RECONNECTPOLICY_H
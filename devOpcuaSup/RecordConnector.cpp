@@ -198,7 +198,45 @@ RecordConnector::requestRecordProcessing (const ProcessReason reason)
     case ProcessReason::writeRequest : callback = &writeRequestCallback; break;
     }
     callbackSetPriority(prec->prio, callback);
-    callbackRequest(callback);
+    if (ProcessingBarrier *barrier = ProcessingBarrier::current())
+        barrier->held.push_back(callback);
+    else
+        callbackRequest(callback);
+}
+
+static epicsThreadPrivateId barrierId = nullptr;
+static epicsThreadOnceId barrierOnce = EPICS_THREAD_ONCE_INIT;
+
+static void
+barrierInit (void *)
+{
+    barrierId = epicsThreadPrivateCreate();
+}
+
+ProcessingBarrier::ProcessingBarrier ()
+{
+    epicsThreadOnce(&barrierOnce, barrierInit, nullptr);
+    outer = current();
+    epicsThreadPrivateSet(barrierId, this);
+}
+
+ProcessingBarrier::~ProcessingBarrier ()
+{
+    epicsThreadPrivateSet(barrierId, outer);
+    if (outer) {
+        outer->held.insert(outer->held.end(), held.begin(), held.end());
+    } else {
+        for (auto callback : held)
+            callbackRequest(callback);
+    }
+}
+
+ProcessingBarrier *
+ProcessingBarrier::current ()
+{
+    if (!barrierId)
+        return nullptr; // no barrier created yet
+    return static_cast<ProcessingBarrier *>(epicsThreadPrivateGet(barrierId));
 }
 
 RecordConnector *
@@ -216,6 +254,13 @@ RecordConnector::findRecordConnector (const std::string &name)
     return result;
 }
 
+bool
+RecordConnector::hasInterest() const
+{
+    // Unlocked reads: the result is only used as a hint
+    return ellCount(&prec->mlis) > 0 || prec->flnk.type != CONSTANT;
+}
+
 std::set<RecordConnector *>
 RecordConnector::glob(const std::string &pattern)
 {
@@ -18,6 +18,7 @@
 #include <cstddef>
 #include <iostream>
 #include <set>
+#include <vector>
 
 #include <epicsMutex.h>
 #include <dbCommon.h>
@@ -123,6 +124,13 @@ public:
 
     int debug() const { return prec->tpro; }
 
+    /**
+     * @brief Check if anybody uses the updates of the record.
+     *
+     * @return true if the record has monitors (CA/PVA clients, CP links) or a forward link
+     */
+    bool hasInterest() const;
+
     /**
      * @brief Find record connector by record name.
      *
@@ -146,6 +154,7 @@ public:
     IOSCANPVT ioscanpvt;
     ProcessReason reason;
     ConnectionStatus connState = ConnectionStatus::down;
+    void **arrayBuffer = nullptr;  /**< record's array buffer pointer (bptr), set if zero-copy mode is enabled */
 
 private:
     dbCommon *prec;
@@ -159,6 +168,34 @@ private:
     epicsCallback writeRequestCallback;
 };
 
+/**
+ * @brief Hold back the record processing requested by the current thread
+ * until the end of the scope.
+ *
+ * Used to process the records of a read or write group together,
+ * after all of them got their data or status.
+ */
+class ProcessingBarrier
+{
+public:
+    ProcessingBarrier();
+    ~ProcessingBarrier();
+
+    /**
+     * @brief Get the innermost barrier of the current thread.
+     * @return pointer to barrier (nullptr if none)
+     */
+    static ProcessingBarrier *current();
+
+private:
+    friend class RecordConnector;
+    ProcessingBarrier(const ProcessingBarrier &) = delete;
+    ProcessingBarrier &operator=(const ProcessingBarrier &) = delete;
+
+    ProcessingBarrier *outer;              /**< enclosing barrier of the thread */
+    std::vector<epicsCallback *> held;     /**< processing requests held back */
+};
+
 } // namespace DevOpcua
 
 #endif // RECORDCONNECTOR_H
@@ -27,12 +27,18 @@
 #include <unistd.h>
 #endif
 
+#include <algorithm>
+
 #include <shareLib.h>
 #include <epicsThread.h>
 #include <epicsTimer.h>
+#include <epicsMutex.h>
+#include <epicsGuard.h>
+#include <epicsTime.h>
 #include <errlog.h>
 
 #include "iocshVariables.h"
+#include "ReconnectPolicy.h"
 
 #ifndef HOST_NAME_MAX
   #define HOST_NAME_MAX 256
@@ -328,26 +334,69 @@ protected:
         return cleaned;
     }
 
-    /** @brief Delay timer for reconnecting whenever connection is down. */
+    /**
+     * @brief Delay timer for reconnecting whenever connection is down.
+     *
+     * The delay starts at opcua_ConnectTimeout and grows by opcua_ConnectBackoffFactor
+     * with every consecutive attempt, up to opcua_ConnectBackoffMax. It is randomized
+     * by +/- opcua_ConnectBackoffJitter (fraction) to keep sessions of many IOCs from
+     * reconnecting in lockstep. All sessions of the IOC share a rate limit of
+     * opcua_ReconnectRate attempts per second.
+     */
     class AutoConnect : public epicsTimerNotify {
     public:
         AutoConnect(Session &client, const double delay, epicsTimerQueueActive *queue)
             : timer(queue->createTimer())
             , client(client)
             , delay(delay)
+            , consecutive(0)
+            , attempts(0)
         {}
         virtual ~AutoConnect() override { timer.destroy(); }
-        void start() { timer.start(*this, delay); }
+        void start() { timer.start(*this, nextDelay()); }
+        void reset() { consecutive = 0; }
+        unsigned int attemptsConsecutive() const { return consecutive; }
+        unsigned long attemptsTotal() const { return attempts; }
         virtual expireStatus expire(const epicsTime &/*currentTime*/) override {
+            double wait = rateLimit();
+            if (wait > 0.0)
+                return expireStatus(restart, wait);
+            consecutive++;
+            attempts++;
             client.connect(false);
             return expireStatus(noRestart); // client.connect() starts the timer on failure
         }
     private:
+        double nextDelay() {
+            double d = backoffDelay(delay, consecutive, opcua_ConnectBackoffFactor, opcua_ConnectBackoffMax);
+            epicsGuard<epicsMutex> G(reconnectLock);
+            return jitterDelay(d, opcua_ConnectBackoffJitter, lcgRandom(reconnectSeed));
+        }
+        // Returns 0 if an attempt is allowed now, else the time to wait [s]
+        static double rateLimit() {
+            epicsGuard<epicsMutex> G(reconnectLock);
+            double wait = reconnectBucket.take(epicsTime::getCurrent(), opcua_ReconnectRate);
+            if (wait <= 0.0) {
+                reconnectAttempts++;
+                return 0.0;
+            }
+            reconnectsDelayed++;
+            // spread the waiting sessions over the following refill periods
+            return wait * (1.0 + lcgRandom(reconnectSeed));
+        }
         epicsTimer &timer;
         Session &client;
         const double delay;
+        unsigned int consecutive;          /**< attempts since last successful connect */
+        unsigned long attempts;            /**< total attempts */
     };
 
+    static epicsMutex reconnectLock;        /**< lock for reconnect rate limiter and jitter */
+    static TokenBucket reconnectBucket;     /**< rate limiter for reconnect attempts */
+    static unsigned int reconnectSeed;      /**< jitter random number generator state */
+    static unsigned long reconnectAttempts; /**< reconnect attempts (all sessions) */
+    static unsigned long reconnectsDelayed; /**< reconnect attempts delayed by the rate limiter */
+
     static epicsTimerQueueActive *queue;   /**< timer queue for session reconnects */
 
     const std::string name;                /**< unique session name */
@@ -0,0 +1,326 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#ifndef DEVOPCUA_STRINGCONVERSION_H
+#define DEVOPCUA_STRINGCONVERSION_H
+
+#include <limits>
+#include <type_traits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+
+namespace DevOpcua {
+
+/**
+ * @brief Conversions between numbers and strings for the data element leafs.
+ *
+ * All conversions work on caller supplied buffers and report errors
+ * through their return value: they never allocate memory and never throw.
+ * Input strings do not need to be null terminated (e.g. OPC UA strings).
+ *
+ * Integer parsing follows strtol() with base 0: leading whitespace and
+ * an optional sign are accepted, a leading "0x" or "0X" selects hexadecimal,
+ * a leading "0" selects octal. Parsing stops at the first character that is
+ * not part of the number; the end position is returned to the caller.
+ * In contrast to strtol(), values outside the range of the target type
+ * are reported as failure instead of being clamped, and a minus sign
+ * is rejected for unsigned targets.
+ *
+ * Floating point parsing uses strtod() on a bounded, null terminated local copy
+ * of the input (for null terminated input strings, directly on the input).
+ *
+ * Formatting produces the same text as std::to_string()
+ * ("%f" for floating point numbers).
+ */
+
+/** Maximum length of a formatted number (excluding the terminating null). */
+const size_t maxNumberStringLength = 320;
+
+namespace detail {
+
+inline bool isSpace (const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+inline int digitValue (const char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    return 99;
+}
+
+// Parse an integer into its magnitude and sign.
+// Returns pointer behind the last consumed character, str if nothing was consumed.
+// Sets overflow if the magnitude does not fit into unsigned long long.
+inline const char *
+parseMagnitude (const char *str, const char *end,
+                unsigned long long &magnitude, bool &negative, bool &overflow)
+{
+    const char *p = str;
+    magnitude = 0;
+    negative = false;
+    overflow = false;
+
+    while (p < end && isSpace(*p))
+        ++p;
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    unsigned int base = 10;
+    if (p < end && *p == '0') {
+        if (p + 2 < end && (p[1] == 'x' || p[1] == 'X') && digitValue(p[2]) < 16) {
+            base = 16;
+            p += 2;
+        } else {
+            base = 8;
+        }
+    }
+
+    const char *digits = p;
+    const unsigned long long limit = std::numeric_limits<unsigned long long>::max() / base;
+    for (; p < end; ++p) {
+        unsigned int d = static_cast<unsigned int>(digitValue(*p));
+        if (d >= base)
+            break;
+        if (magnitude > limit || magnitude * base > std::numeric_limits<unsigned long long>::max() - d)
+            overflow = true;
+        magnitude = magnitude * base + d;
+    }
+    if (p == digits)
+        return str;
+    return p;
+}
+
+template<typename T>
+inline bool
+fromMagnitude (const unsigned long long magnitude, const bool negative, T &value,
+               std::true_type /* is_signed */)
+{
+    typedef typename std::make_unsigned<T>::type UT;
+    const unsigned long long maxPos = static_cast<UT>(std::numeric_limits<T>::max());
+    if (negative) {
+        if (magnitude > maxPos + 1ULL)
+            return false;
+        // Negate in the unsigned domain to avoid overflow on the minimum value
+        value = static_cast<T>(static_cast<UT>(0) - static_cast<UT>(magnitude));
+    } else {
+        if (magnitude > maxPos)
+            return false;
+        value = static_cast<T>(magnitude);
+    }
+    return true;
+}
+
+template<typename T>
+inline bool
+fromMagnitude (const unsigned long long magnitude, const bool negative, T &value,
+               std::false_type /* is_signed */)
+{
+    if ((negative && magnitude != 0) || magnitude > std::numeric_limits<T>::max())
+        return false;
+    value = static_cast<T>(magnitude);
+    return true;
+}
+
+template<typename T>
+inline bool
+parseNumber (const char *str, const size_t len, T &value, const char **endptr,
+             std::true_type /* is_integral */)
+{
+    unsigned long long magnitude;
+    bool negative, overflow;
+    const char *end = parseMagnitude(str, str + len, magnitude, negative, overflow);
+    if (endptr)
+        *endptr = end;
+    if (end == str || overflow)
+        return false;
+    return fromMagnitude(magnitude, negative, value, std::is_signed<T>());
+}
+
+// strtod() on null terminated input
+template<typename T>
+inline bool
+strtodNumber (const char *str, T &value, const char **endptr)
+{
+    char *end;
+    int savedErrno = errno;
+    errno = 0;
+    double d = strtod(str, &end);
+    // Overflow is an error, underflow (denormals or zero) is not
+    bool ok = (end != str) && !(errno == ERANGE && std::isinf(d));
+    errno = savedErrno;
+    if (endptr)
+        *endptr = end;
+    if (!ok)
+        return false;
+    if (d < std::numeric_limits<T>::lowest() || d > std::numeric_limits<T>::max())
+        return false;
+    value = static_cast<T>(d);
+    return true;
+}
+
+template<typename T>
+inline bool
+parseNumber (const char *str, const size_t len, T &value, const char **endptr,
+             std::false_type /* is_integral */)
+{
+    size_t n = len;
+
+    // Skip leading whitespace, so that a local copy holds the number itself
+    const char *p = str;
+    while (n && isSpace(*p)) {
+        ++p;
+        --n;
+    }
+
+    // The input may not be terminated (e.g. OPC UA strings): parse a null terminated copy
+    char buf[maxNumberStringLength + 1];
+    if (n > maxNumberStringLength)
+        n = maxNumberStringLength;
+    memcpy(buf, p, n);
+    buf[n] = '\0';
+    const char *end;
+    bool ok = strtodNumber(buf, value, &end);
+    if (endptr)
+        *endptr = (end == buf) ? str : p + (end - buf);
+    return ok;
+}
+
+template<typename T>
+inline bool
+parseTerminated (const char *str, T &value, const char **endptr,
+                 std::true_type /* is_integral */)
+{
+    return parseNumber(str, strlen(str), value, endptr, std::true_type());
+}
+
+template<typename T>
+inline bool
+parseTerminated (const char *str, T &value, const char **endptr,
+                 std::false_type /* is_integral */)
+{
+    return strtodNumber(str, value, endptr);
+}
+
+template<typename T>
+inline bool
+isNegative (const T value, std::true_type /* is_signed */)
+{
+    return value < 0;
+}
+
+template<typename T>
+inline bool
+isNegative (const T, std::false_type /* is_signed */)
+{
+    return false;
+}
+
+} // namespace detail
+
+/**
+ * @brief Parse a number from a (not necessarily null terminated) string.
+ *
+ * @param[in] str  input characters
+ * @param[in] len  number of input characters
+ * @param[out] value  converted number (unchanged on failure)
+ * @param[out] endptr  if not null, set to the first character not consumed
+ *                     (str if no number was found)
+ *
+ * @return true if a number was found and is within the range of T
+ */
+template<typename T>
+inline bool
+parseNumber (const char *str, const size_t len, T &value, const char **endptr = nullptr)
+{
+    return detail::parseNumber(str, len, value, endptr, std::is_integral<T>());
+}
+
+/**
+ * @brief Parse a number from a null terminated string.
+ *
+ * @param[in] str  input string
+ * @param[out] value  converted number (unchanged on failure)
+ * @param[out] endptr  if not null, set to the first character not consumed
+ *                     (str if no number was found)
+ *
+ * @return true if a number was found and is within the range of T
+ */
+template<typename T>
+inline bool
+parseNumber (const char *str, T &value, const char **endptr = nullptr)
+{
+    return detail::parseTerminated(str, value, endptr, std::is_integral<T>());
+}
+
+/**
+ * @brief Format an integer number into a buffer.
+ *
+ * @param[out] buf  output buffer (result is null terminated)
+ * @param[in] size  size of the output buffer
+ * @param[in] value  number to format
+ *
+ * @return length of the formatted string, 0 if the buffer was too small
+ */
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value, size_t>::type
+formatNumber (char *buf, const size_t size, const T value)
+{
+    typedef typename std::make_unsigned<T>::type UT;
+    char digits[std::numeric_limits<UT>::digits10 + 2];
+    char *p = digits + sizeof(digits);
+    bool negative = detail::isNegative(value, std::is_signed<T>());
+    UT magnitude = negative ? static_cast<UT>(static_cast<UT>(0) - static_cast<UT>(value))
+                            : static_cast<UT>(value);
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    size_t n = static_cast<size_t>(digits + sizeof(digits) - p);
+    if (n + negative + 1 > size)
+        return 0;
+    char *out = buf;
+    if (negative)
+        *out++ = '-';
+    memcpy(out, p, n);
+    out[n] = '\0';
+    return n + negative;
+}
+
+/**
+ * @brief Format a floating point number into a buffer.
+ *
+ * @param[out] buf  output buffer (result is null terminated)
+ * @param[in] size  size of the output buffer
+ * @param[in] value  number to format
+ *
+ * @return length of the formatted string, 0 if the buffer was too small
+ */
+template<typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value, size_t>::type
+formatNumber (char *buf, const size_t size, const T value)
+{
+    int n = snprintf(buf, size, "%f", static_cast<double>(value));
+    if (n < 0 || static_cast<size_t>(n) >= size)
+        return 0;
+    return static_cast<size_t>(n);
+}
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_STRINGCONVERSION_H
@@ -16,6 +16,8 @@
 #include <iostream>
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
 
 #include <epicsTypes.h>
 #include <shareLib.h>
@@ -23,6 +25,7 @@
 namespace DevOpcua {
 
 class Session;
+class Item;
 
 /**
  * @brief The Subscription interface for a UA client created subscription.
@@ -65,6 +68,20 @@ public:
      */
     virtual void setOption(const std::string &name, const std::string &value) = 0;
 
+    /**
+     * @brief Change the monitoring parameters of items at runtime.
+     *
+     * Valid options are the monitored item link options
+     * (sampling, qsize, discard, deadband).
+     * Changes are sent to the server if the session is connected,
+     * otherwise they are used when the monitored items are created.
+     *
+     * @param items  items of this subscription to change
+     * @param options  options to apply (name->value)
+     */
+    virtual void modifyMonitoredItems(const std::vector<Item *> &items,
+                                      const std::map<std::string, std::string> &options) = 0;
+
     /**
      * @brief Print configuration and status of all subscriptions on stdout.
      *
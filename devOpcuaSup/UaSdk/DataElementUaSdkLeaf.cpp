@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
@@ -44,6 +45,8 @@ DataElementUaSdkLeaf::DataElementUaSdkLeaf (const std::string &name,
     : DataElementUaSdk(name, item)
     , incomingQueue(pconnector->plinkinfo->clientQueueSize, pconnector->plinkinfo->discardOldest)
 {
+    if (pconnector->plinkinfo->zeroCopy)
+        throw std::runtime_error("link option 'zerocopy' is not supported by the UA SDK client");
     item->dataTreeNoOfLeafs++;
 }
 
@@ -190,27 +193,6 @@ DataElementUaSdkLeaf::getIncomingReadStatus() const
     return pitem->getLastStatus().code();
 }
 
-OpcUa_StatusCode
-DataElementUaSdkLeaf::UaVariant_to(const UaVariant &variant, OpcUa_Int32 &value)
-{
-    return variant.toInt32(value);
-}
-OpcUa_StatusCode
-DataElementUaSdkLeaf::UaVariant_to(const UaVariant &variant, OpcUa_UInt32 &value)
-{
-    return variant.toUInt32(value);
-}
-OpcUa_StatusCode
-DataElementUaSdkLeaf::UaVariant_to(const UaVariant &variant, OpcUa_Int64 &value)
-{
-    return variant.toInt64(value);
-}
-OpcUa_StatusCode
-DataElementUaSdkLeaf::UaVariant_to(const UaVariant &variant, OpcUa_Double &value)
-{
-    return variant.toDouble(value);
-}
-
 void
 DataElementUaSdkLeaf::UaVariant_set(UaVariant &variant, UaBooleanArray &value)
 {
@@ -328,7 +310,7 @@ DataElementUaSdkLeaf::readScalar(epicsInt32 *value,
                                  char *statusText,
                                  const epicsUInt32 statusTextLen)
 {
-    return readScalar<epicsInt32, OpcUa_Int32>(value, prec, nextReason, statusCode, statusText, statusTextLen);
+    return readScalar<epicsInt32>(value, prec, nextReason, statusCode, statusText, statusTextLen);
 }
 
 long
@@ -339,7 +321,7 @@ DataElementUaSdkLeaf::readScalar(epicsInt64 *value,
                                  char *statusText,
                                  const epicsUInt32 statusTextLen)
 {
-    return readScalar<epicsInt64, OpcUa_Int64>(value, prec, nextReason, statusCode, statusText, statusTextLen);
+    return readScalar<epicsInt64>(value, prec, nextReason, statusCode, statusText, statusTextLen);
 }
 
 long
@@ -350,7 +332,7 @@ DataElementUaSdkLeaf::readScalar(epicsUInt32 *value,
                                  char *statusText,
                                  const epicsUInt32 statusTextLen)
 {
-    return readScalar<epicsUInt32, OpcUa_UInt32>(value, prec, nextReason, statusCode, statusText, statusTextLen);
+    return readScalar<epicsUInt32>(value, prec, nextReason, statusCode, statusText, statusTextLen);
 }
 
 long
@@ -361,7 +343,7 @@ DataElementUaSdkLeaf::readScalar(epicsFloat64 *value,
                                  char *statusText,
                                  const epicsUInt32 statusTextLen)
 {
-    return readScalar<epicsFloat64, OpcUa_Double>(value, prec, nextReason, statusCode, statusText, statusTextLen);
+    return readScalar<epicsFloat64>(value, prec, nextReason, statusCode, statusText, statusTextLen);
 }
 
 // Helper functions to convert between OpcUa_ByteString and hex encoded C string
@@ -775,10 +757,7 @@ DataElementUaSdkLeaf::readArray(epicsUInt8 *value,
                 UaVariant &variant = upd->getData();
                 if (!variant.isArray() && variant.type() == OpcUaType_ByteString) {
                     const OpcUa_ByteString &bs = static_cast<const OpcUa_Variant *>(variant)->Value.ByteString;
-                    elemsWritten = bs.Length;
-                    if (elemsWritten > num)
-                        elemsWritten = num;
-                    memcpy(value, bs.Data, elemsWritten);
+                    elemsWritten = UaSdkConversion::copyArray(value, num, bs.Data, bs.Length > 0 ? bs.Length : 0);
                 } else if (!variant.isArray()) {
                     errlogPrintf("%s : incoming data is not an array\n", prec->name);
                     (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
@@ -794,10 +773,9 @@ DataElementUaSdkLeaf::readArray(epicsUInt8 *value,
                     if (OpcUa_IsUncertain(stat)) {
                         (void) recGblSetSevr(prec, READ_ALARM, MINOR_ALARM);
                     }
-                    elemsWritten = variant.arraySize();
-                    if (elemsWritten > num)
-                        elemsWritten = num;
-                    memcpy(value, static_cast<const OpcUa_Variant *>(variant)->Value.Array.Value.Array, elemsWritten);
+                    elemsWritten = UaSdkConversion::copyArray(
+                        value, num, static_cast<const OpcUa_Variant *>(variant)->Value.Array.Value.Array,
+                        variant.arraySize());
                 }
             }
             if (statusCode)
@@ -1018,10 +996,6 @@ long
 DataElementUaSdkLeaf::writeScalar(const char *value, epicsUInt32 len, dbCommon *prec)
 {
     long ret = 1;
-    long l;
-    unsigned long ul;
-    double d;
-    char *end = nullptr;
     OpcUa_BuiltInType type = incomingData.type();
 
     if (type == OpcUaType_ExtensionObject) {
@@ -1062,6 +1036,8 @@ DataElementUaSdkLeaf::writeScalar(const char *value, epicsUInt32 len, dbCommon *
         }
     }
 
+    const size_t numlen = strnlen(value, len);
+
     switch (type) {
     case OpcUaType_String: { // Scope of Guard G
         Guard G(outgoingLock);
@@ -1124,131 +1100,25 @@ DataElementUaSdkLeaf::writeScalar(const char *value, epicsUInt32 len, dbCommon *
         }
         break;
     }
-    case OpcUaType_Boolean: { // Scope of Guard G
+    default: { // Scope of Guard G
+        OpcUa_StatusCode status;
         Guard G(outgoingLock);
-        if (strchr("YyTt1", *value))
-            outgoingData.setBoolean(true);
-        else
-            outgoingData.setBoolean(false);
-        markAsDirty();
-        ret = 0;
-        break;
-    }
-    case OpcUaType_Byte:
-        ul = strtoul(value, &end, 0);
-        if (end != value && isWithinRange<OpcUa_Byte>(ul)) {
-            Guard G(outgoingLock);
-            outgoingData.setByte(static_cast<OpcUa_Byte>(ul));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_SByte:
-        l = strtol(value, &end, 0);
-        if (end != value && isWithinRange<OpcUa_SByte>(l)) {
-            Guard G(outgoingLock);
-            outgoingData.setSByte(static_cast<OpcUa_SByte>(l));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_UInt16:
-        ul = strtoul(value, &end, 0);
-        if (end != value && isWithinRange<OpcUa_UInt16>(ul)) {
-            Guard G(outgoingLock);
-            outgoingData.setUInt16(static_cast<OpcUa_UInt16>(ul));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_Int16:
-        l = strtol(value, &end, 0);
-        if (end != value && isWithinRange<OpcUa_Int16>(l)) {
-            Guard G(outgoingLock);
-            outgoingData.setInt16(static_cast<OpcUa_Int16>(l));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_UInt32:
-        ul = strtoul(value, &end, 0);
-        if (end != value && isWithinRange<OpcUa_UInt32>(ul)) {
-            Guard G(outgoingLock);
-            outgoingData.setUInt32(static_cast<OpcUa_UInt32>(ul));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_Int32:
-        l = strtol(value, &end, 0);
-        if (enumChoices) {
-            // first test enum strings then numeric values
-            // in case a string starts with a number but means a different value
-            for (const auto &it : *enumChoices)
-                if (it.second == value) {
-                    l = static_cast<long>(it.first);
-                    ret = 0;
-                    end = nullptr;
-                    break;
-                }
-            if (ret != 0 && end != value)
-                for (const auto &it : *enumChoices)
-                    if (l == it.first) {
-                        ret = 0;
-                        break;
-                    }
-            if (ret != 0)
-                break;
-        }
-        if (end != value && isWithinRange<OpcUa_Int32>(l)) {
-            Guard G(outgoingLock);
-            outgoingData.setInt32(static_cast<OpcUa_Int32>(l));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_UInt64:
-        ul = strtoul(value, &end, 0);
-        if (end != value && isWithinRange<OpcUa_UInt64>(ul)) {
-            Guard G(outgoingLock);
-            outgoingData.setUInt64(static_cast<OpcUa_UInt64>(ul));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_Int64:
-        l = strtol(value, &end, 0);
-        if (end != value && isWithinRange<OpcUa_Int64>(l)) {
-            Guard G(outgoingLock);
-            outgoingData.setInt64(static_cast<OpcUa_Int64>(l));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_Float:
-        d = strtod(value, &end);
-        if (end != value && isWithinRange<OpcUa_Float>(d)) {
-            Guard G(outgoingLock);
-            outgoingData.setFloat(static_cast<OpcUa_Float>(d));
-            markAsDirty();
-            ret = 0;
-        }
-        break;
-    case OpcUaType_Double: {
-        d = strtod(value, &end);
-        if (end != value) {
-            Guard G(outgoingLock);
-            outgoingData.setDouble(static_cast<OpcUa_Double>(d));
+        switch (UaSdkConversion::fromString(
+            value, numlen, UaSdkConversionTraits::kindOf(type), outgoingData, enumChoices, status)) {
+        case ConversionResult::ok:
             markAsDirty();
             ret = 0;
+            break;
+        case ConversionResult::unsupported:
+            errlogPrintf("%s : unsupported conversion from string to %s for outgoing data\n",
+                         prec->name,
+                         variantTypeString(type));
+            (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
+            return -1;
+        default:
+            break;
         }
-        break;
     }
-    default:
-        errlogPrintf(
-            "%s : unsupported conversion from string to %s for outgoing data\n", prec->name, variantTypeString(type));
-        (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
-        return -1;
     }
 
     if (ret != 0) {
@@ -14,12 +14,11 @@
 #ifndef DEVOPCUA_DATAELEMENTUASDKLEAF_H
 #define DEVOPCUA_DATAELEMENTUASDKLEAF_H
 
-#include <limits>
-
 #include "DataElementUaSdk.h"
 #include "RecordConnector.h"
 #include "Update.h"
 #include "UpdateQueue.h"
+#include "LeafConversion.h"
 
 namespace DevOpcua {
 
@@ -27,202 +26,127 @@ class ItemUaSdk;
 
 typedef Update<UaVariant, OpcUa_StatusCode> UpdateUaSdk;
 
-inline const char *epicsTypeString (const epicsInt8 &) { return "epicsInt8"; }
-inline const char *epicsTypeString (const epicsUInt8 &) { return "epicsUInt8"; }
-inline const char *epicsTypeString (const epicsInt16 &) { return "epicsInt16"; }
-inline const char *epicsTypeString (const epicsUInt16 &) { return "epicsUInt16"; }
-inline const char *epicsTypeString (const epicsInt32 &) { return "epicsInt32"; }
-inline const char *epicsTypeString (const epicsUInt32 &) { return "epicsUInt32"; }
-inline const char *epicsTypeString (const epicsInt64 &) { return "epicsInt64"; }
-inline const char *epicsTypeString (const epicsUInt64 &) { return "epicsUInt64"; }
-inline const char *epicsTypeString (const epicsFloat32 &) { return "epicsFloat32"; }
-inline const char *epicsTypeString (const epicsFloat64 &) { return "epicsFloat64"; }
-inline const char *epicsTypeString (const char *) { return "epicsString"; }
-
-// Template for range check when writing
-template<typename TO, typename FROM>
-inline bool
-isWithinRange (const FROM &value)
-{
-    return !(value < std::numeric_limits<TO>::lowest() || value > std::numeric_limits<TO>::max());
-}
-
-// Specializations for unsigned to signed to avoid compiler warnings
-template<>
-inline bool
-isWithinRange<OpcUa_SByte, epicsUInt32>(const epicsUInt32 &value)
-{
-    return !(value > static_cast<OpcUa_UInt32>(std::numeric_limits<OpcUa_SByte>::max()));
-}
-
-template<>
-inline bool
-isWithinRange<OpcUa_Int16, epicsUInt32>(const epicsUInt32 &value)
-{
-    return !(value > static_cast<OpcUa_UInt32>(std::numeric_limits<OpcUa_Int16>::max()));
-}
-
-template<>
-inline bool
-isWithinRange<OpcUa_Int32, epicsUInt32>(const epicsUInt32 &value)
-{
-    return !(value > static_cast<OpcUa_UInt32>(std::numeric_limits<OpcUa_Int32>::max()));
-}
-
-template<>
-inline bool
-isWithinRange<OpcUa_SByte, epicsUInt64>(const epicsUInt64 &value)
-{
-    return !(value > static_cast<OpcUa_UInt64>(std::numeric_limits<OpcUa_SByte>::max()));
-}
-
-template<>
-inline bool
-isWithinRange<OpcUa_Int16, epicsUInt64>(const epicsUInt64 &value)
-{
-    return !(value > static_cast<OpcUa_UInt64>(std::numeric_limits<OpcUa_Int16>::max()));
-}
-
-template<>
-inline bool
-isWithinRange<OpcUa_Int32, epicsUInt64>(const epicsUInt64 &value)
-{
-    return !(value > static_cast<OpcUa_UInt64>(std::numeric_limits<OpcUa_Int32>::max()));
-}
-
-template<>
-inline bool
-isWithinRange<OpcUa_Int64, epicsUInt64>(const epicsUInt64 &value)
-{
-    return !(value > static_cast<OpcUa_UInt64>(std::numeric_limits<OpcUa_Int64>::max()));
-}
-
-// Simple-check specializations for converting signed to unsigned of same or wider type
-template<>
-inline bool
-isWithinRange<OpcUa_UInt32, epicsInt8>(const epicsInt8 &value)
-{
-    return !(value < 0);
-}
-template<>
-inline bool
-isWithinRange<OpcUa_UInt32, epicsInt16>(const epicsInt16 &value)
-{
-    return !(value < 0);
-}
-template<>
-inline bool
-isWithinRange<OpcUa_UInt32, epicsInt32>(const epicsInt32 &value)
-{
-    return !(value < 0);
-}
-template<>
-inline bool
-isWithinRange<OpcUa_UInt64, epicsInt8>(const epicsInt8 &value)
-{
-    return !(value < 0);
-}
-template<>
-inline bool
-isWithinRange<OpcUa_UInt64, epicsInt16>(const epicsInt16 &value)
-{
-    return !(value < 0);
-}
-template<>
-inline bool
-isWithinRange<OpcUa_UInt64, epicsInt32>(const epicsInt32 &value)
-{
-    return !(value < 0);
-}
-template<>
-inline bool
-isWithinRange<OpcUa_UInt64, epicsInt64>(const epicsInt64 &value)
-{
-    return !(value < 0);
-}
-
-// No-check-needed specializations for converting to same or wider type
-template<>
-inline bool
-isWithinRange<OpcUa_Int32, epicsInt32>(const epicsInt32 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_Int64, epicsInt32>(const epicsInt32 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_Float, epicsInt32>(const epicsInt32 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_Double, epicsInt32>(const epicsInt32 &)
+/**
+ * @brief Access to UA SDK variants for the shared conversion core.
+ *
+ * See DevOpcua::LeafConversion
+ */
+struct UaSdkConversionTraits
 {
-    return true;
-}
+    typedef UaVariant Variant;
+    typedef OpcUa_StatusCode Status;
+    typedef OpcUa_SByte SByte;
+    typedef OpcUa_Byte Byte;
+    typedef OpcUa_Int16 Int16;
+    typedef OpcUa_UInt16 UInt16;
+    typedef OpcUa_Int32 Int32;
+    typedef OpcUa_UInt32 UInt32;
+    typedef OpcUa_Int64 Int64;
+    typedef OpcUa_UInt64 UInt64;
+    typedef OpcUa_Float Float;
+    typedef OpcUa_Double Double;
+
+    static ScalarKind
+    kindOf (const OpcUa_BuiltInType type)
+    {
+        switch (type) {
+        case OpcUaType_Boolean:
+            return ScalarKind::boolean;
+        case OpcUaType_SByte:
+            return ScalarKind::sByte;
+        case OpcUaType_Byte:
+            return ScalarKind::byte;
+        case OpcUaType_Int16:
+            return ScalarKind::int16;
+        case OpcUaType_UInt16:
+            return ScalarKind::uInt16;
+        case OpcUaType_Int32:
+            return ScalarKind::int32;
+        case OpcUaType_UInt32:
+            return ScalarKind::uInt32;
+        case OpcUaType_Int64:
+            return ScalarKind::int64;
+        case OpcUaType_UInt64:
+            return ScalarKind::uInt64;
+        case OpcUaType_Float:
+            return ScalarKind::float32;
+        case OpcUaType_Double:
+            return ScalarKind::float64;
+        case OpcUaType_String:
+            return ScalarKind::string;
+        case OpcUaType_LocalizedText:
+            return ScalarKind::localizedText;
+        default:
+            return ScalarKind::unsupported;
+        }
+    }
+    static ScalarKind
+    kindOf (const UaVariant &v)
+    {
+        return kindOf(v.type());
+    }
 
-template<>
-inline bool
-isWithinRange<OpcUa_UInt32, epicsUInt32>(const epicsUInt32 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_Int64, epicsUInt32>(const epicsUInt32 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_UInt64, epicsUInt32>(const epicsUInt32 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_Float, epicsUInt32>(const epicsUInt32 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_Double, epicsUInt32>(const epicsUInt32 &)
-{
-    return true;
-}
+    static bool
+    getBoolean (const UaVariant &v)
+    {
+        OpcUa_Boolean val = OpcUa_False;
+        v.toBool(val);
+        return val != OpcUa_False;
+    }
+    static void get (const UaVariant &v, OpcUa_SByte &value) { v.toSByte(value); }
+    static void get (const UaVariant &v, OpcUa_Byte &value) { v.toByte(value); }
+    static void get (const UaVariant &v, OpcUa_Int16 &value) { v.toInt16(value); }
+    static void get (const UaVariant &v, OpcUa_UInt16 &value) { v.toUInt16(value); }
+    static void get (const UaVariant &v, OpcUa_Int32 &value) { v.toInt32(value); }
+    static void get (const UaVariant &v, OpcUa_UInt32 &value) { v.toUInt32(value); }
+    static void get (const UaVariant &v, OpcUa_Int64 &value) { v.toInt64(value); }
+    static void get (const UaVariant &v, OpcUa_UInt64 &value) { v.toUInt64(value); }
+    static void get (const UaVariant &v, OpcUa_Float &value) { v.toFloat(value); }
+    static void get (const UaVariant &v, OpcUa_Double &value) { v.toDouble(value); }
+    static void
+    getText (const UaVariant &v, const char *&str, size_t &len)
+    {
+        const OpcUa_Variant *variant = static_cast<const OpcUa_Variant *>(v);
+        const OpcUa_String *s = (variant->Datatype == OpcUaType_LocalizedText)
+                                    ? &variant->Value.LocalizedText->Text
+                                    : &variant->Value.String;
+        str = OpcUa_String_GetRawString(s);
+        len = str ? OpcUa_String_StrSize(s) : 0;
+    }
 
-template<>
-inline bool
-isWithinRange<OpcUa_Int64, epicsInt64>(const epicsInt64 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_Float, epicsInt64>(const epicsInt64 &)
-{
-    return true;
-}
-template<>
-inline bool
-isWithinRange<OpcUa_Double, epicsInt64>(const epicsInt64 &)
-{
-    return true;
-}
+    static OpcUa_StatusCode
+    setBoolean (UaVariant &v, const bool value)
+    {
+        v.setBoolean(value ? OpcUa_True : OpcUa_False);
+        return OpcUa_Good;
+    }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_SByte value) { v.setSByte(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_Byte value) { v.setByte(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_Int16 value) { v.setInt16(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_UInt16 value) { v.setUInt16(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_Int32 value) { v.setInt32(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_UInt32 value) { v.setUInt32(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_Int64 value) { v.setInt64(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_UInt64 value) { v.setUInt64(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_Float value) { v.setFloat(value); return OpcUa_Good; }
+    static OpcUa_StatusCode set (UaVariant &v, const OpcUa_Double value) { v.setDouble(value); return OpcUa_Good; }
+    static OpcUa_StatusCode
+    setText (UaVariant &v, const ScalarKind kind, const char *str, const size_t len, const UaVariant &incoming)
+    {
+        UaByteString text(static_cast<OpcUa_Int32>(len), reinterpret_cast<OpcUa_Byte *>(const_cast<char *>(str)));
+        if (kind == ScalarKind::localizedText) {
+            UaLocalizedText localizedText;
+            incoming.toLocalizedText(localizedText); // keep the locale
+            localizedText.setText(text);
+            v.setLocalizedText(localizedText);
+        } else {
+            v.setString(text);
+        }
+        return OpcUa_Good;
+    }
+};
 
-template<>
-inline bool
-isWithinRange<OpcUa_Double, epicsFloat64>(const epicsFloat64 &)
-{
-    return true;
-}
+typedef LeafConversion<UaSdkConversionTraits> UaSdkConversion;
 
 class DataElementUaSdkLeaf
     : public DataElement
@@ -666,11 +590,6 @@ private:
     const epicsTime &getIncomingTimeStamp() const;
     OpcUa_StatusCode getIncomingReadStatus() const;
 
-    OpcUa_StatusCode UaVariant_to(const UaVariant &variant, OpcUa_Int32 &value);
-    OpcUa_StatusCode UaVariant_to(const UaVariant &variant, OpcUa_UInt32 &value);
-    OpcUa_StatusCode UaVariant_to(const UaVariant &variant, OpcUa_Int64 &value);
-    OpcUa_StatusCode UaVariant_to(const UaVariant &variant, OpcUa_Double &value);
-
     void UaVariant_set(UaVariant &variant, UaBooleanArray &value);
     void UaVariant_set(UaVariant &variant, UaSByteArray &value);
     void UaVariant_set(UaVariant &variant, UaByteArray &value);
@@ -687,10 +606,10 @@ private:
     void UaVariant_set(UaVariant &variant, UaLocalizedTextArray &value);
     void UaVariant_set(UaVariant &variant, UaQualifiedNameArray &value);
 
-    // Read scalar value as templated function on EPICS type and OPC UA type
+    // Read scalar value as templated function on EPICS type
     // value == nullptr is allowed and leads to the value being dropped (ignored),
     // including the extended status
-    template<typename ET, typename OT>
+    template<typename ET>
     long readScalar (ET *value,
                      dbCommon *prec,
                      ProcessReason *nextReason,
@@ -730,8 +649,8 @@ private:
                     ret = 1;
                 } else {
                     // Valid OPC UA value, so try to convert
-                    OT v;
-                    if (OpcUa_IsNotGood(UaVariant_to(upd->getData(), v))) {
+                    ET v;
+                    if (UaSdkConversion::toEpics(upd->getData(), v, enumChoices) != ConversionResult::ok) {
                         errlogPrintf(
                             "%s : incoming data (%s) out-of-bounds\n", prec->name, upd->getData().toString().toUtf8());
                         (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
@@ -824,12 +743,9 @@ private:
                         if (OpcUa_IsUncertain(stat)) {
                             (void) recGblSetSevr(prec, READ_ALARM, MINOR_ALARM);
                         }
-                        elemsWritten = variant.arraySize();
-                        if (elemsWritten > num)
-                            elemsWritten = num;
-                        memcpy(value,
-                               static_cast<const OpcUa_Variant *>(variant)->Value.Array.Value.Array,
-                               sizeof(ET) * elemsWritten);
+                        elemsWritten = UaSdkConversion::copyArray(
+                            value, num, static_cast<const OpcUa_Variant *>(variant)->Value.Array.Value.Array,
+                            variant.arraySize());
                     }
                 }
                 if (statusCode)
@@ -869,108 +785,26 @@ private:
     template<typename ET> long writeScalar (const ET &value, dbCommon *prec)
     {
         long ret = 1;
+        OpcUa_StatusCode status = OpcUa_Good;
 
-        switch (incomingData.type()) {
-        case OpcUaType_Boolean: { // Scope of Guard G
+        { // Scope of Guard G
             Guard G(outgoingLock);
-            outgoingData.setBoolean(value != 0);
-            markAsDirty();
-            ret = 0;
-            break;
-        }
-        case OpcUaType_Byte:
-            if (isWithinRange<OpcUa_Byte>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setByte(static_cast<OpcUa_Byte>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_SByte:
-            if (isWithinRange<OpcUa_SByte>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setSByte(static_cast<OpcUa_SByte>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_UInt16:
-            if (isWithinRange<OpcUa_UInt16>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setUInt16(static_cast<OpcUa_UInt16>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_Int16:
-            if (isWithinRange<OpcUa_Int16>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setInt16(static_cast<OpcUa_Int16>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_UInt32:
-            if (isWithinRange<OpcUa_UInt32>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setUInt32(static_cast<OpcUa_UInt32>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_Int32: // may be an enum
-            if (isWithinRange<OpcUa_Int32>(value)
-                && (!enumChoices || enumChoices->find(static_cast<OpcUa_Int32>(value)) != enumChoices->end())) {
-                Guard G(outgoingLock);
-                outgoingData.setInt32(static_cast<OpcUa_Int32>(value));
+            switch (UaSdkConversion::fromEpics(
+                value, UaSdkConversionTraits::kindOf(incomingData), incomingData, outgoingData, enumChoices, status)) {
+            case ConversionResult::ok:
                 markAsDirty();
                 ret = 0;
+                break;
+            case ConversionResult::unsupported:
+                errlogPrintf("%s : unsupported conversion from %s to %s for outgoing data\n",
+                             prec->name,
+                             epicsTypeString(value),
+                             variantTypeString(incomingData.type()));
+                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
+                break;
+            default:
+                break;
             }
-            break;
-        case OpcUaType_UInt64:
-            if (isWithinRange<OpcUa_UInt64>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setUInt64(static_cast<OpcUa_UInt64>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_Int64:
-            if (isWithinRange<OpcUa_Int64>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setInt64(static_cast<OpcUa_Int64>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_Float:
-            if (isWithinRange<OpcUa_Float>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setFloat(static_cast<OpcUa_Float>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_Double:
-            if (isWithinRange<OpcUa_Double>(value)) {
-                Guard G(outgoingLock);
-                outgoingData.setDouble(static_cast<OpcUa_Double>(value));
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case OpcUaType_String: { // Scope of Guard G
-            Guard G(outgoingLock);
-            outgoingData.setString(static_cast<UaString>(std::to_string(value).c_str()));
-            markAsDirty();
-            break;
-        }
-        default:
-            errlogPrintf("%s : unsupported conversion from %s to %s for outgoing data\n",
-                         prec->name,
-                         epicsTypeString(value),
-                         variantTypeString(incomingData.type()));
-            (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         }
         if (ret != 0) {
             errlogPrintf("%s : value out of range\n", prec->name);
@@ -51,15 +51,16 @@ void
 DataElementUaSdkNode::addChild (std::weak_ptr<DataElementUaSdk> elem)
 {
     elements.push_back(elem);
+    if (auto pelem = elem.lock())
+        elementIndex.emplace(pelem->name, elem); // a duplicate name finds the first child
 }
 
 std::shared_ptr<DataElementUaSdk>
 DataElementUaSdkNode::findChild (const std::string &name) const
 {
-    for (const auto &it : elements)
-        if (auto pit = it.lock())
-            if (pit->name == name)
-                return pit;
+    auto it = elementIndex.find(name);
+    if (it != elementIndex.end())
+        return it->second.lock();
     return std::shared_ptr<DataElementUaSdk>();
 }
 
@@ -17,6 +17,7 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <string>
 
 #include <uavariant.h>
 
@@ -58,6 +59,7 @@ private:
     epicsTime epicsTimeFromUaVariant(const UaVariant &data) const;
 
     std::vector<std::weak_ptr<DataElementUaSdk>> elements;
+    std::unordered_map<std::string, std::weak_ptr<DataElementUaSdk>> elementIndex;
     std::unordered_map<int, std::weak_ptr<DataElementUaSdk>> elementMap;
     int timesrc;
     bool mapped;
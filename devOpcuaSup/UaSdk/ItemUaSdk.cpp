@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 
 #include <opcua_statuscodes.h>
 #include <uaclientsdk.h>
@@ -52,6 +53,16 @@ ItemUaSdk::ItemUaSdk (const linkInfo &info)
     , lastStatus(OpcUa_BadServerNotConnected)
     , lastReason(ProcessReason::connectionLoss)
 {
+    if (linkinfo.browsePath.size())
+        throw std::runtime_error("link option 'path' is not supported by the UA SDK client");
+    if (linkinfo.trigger.length())
+        throw std::runtime_error("link option 'trigger' is not supported by the UA SDK client");
+    if (linkinfo.maxAge > 0.0)
+        throw std::runtime_error("link option 'maxage' is not supported by the UA SDK client");
+    if (linkinfo.readGroup.length())
+        throw std::runtime_error("link option 'readgroup' is not supported by the UA SDK client");
+    if (linkinfo.writeGroup.length() || linkinfo.commit)
+        throw std::runtime_error("link options 'writegroup' and 'commit' are not supported by the UA SDK client");
     if (linkinfo.subscription != "" && linkinfo.monitor) {
         subscription = SubscriptionUaSdk::find(linkinfo.subscription);
         subscription->addItemUaSdk(this);
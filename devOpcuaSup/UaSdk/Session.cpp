@@ -36,6 +36,11 @@ namespace DevOpcua {
 
 epicsThreadOnceId Session::onceId = EPICS_THREAD_ONCE_INIT;
 epicsTimerQueueActive *Session::queue = nullptr;
+epicsMutex Session::reconnectLock;
+TokenBucket Session::reconnectBucket;
+unsigned int Session::reconnectSeed = 0;
+unsigned long Session::reconnectAttempts = 0;
+unsigned long Session::reconnectsDelayed = 0;
 
 RegistryKeyNamespace RegistryKeyNamespace::global;
 
@@ -44,6 +49,9 @@ void Session::initOnce(void *junk)
     (void)junk;
     UaPlatformLayer::init();
     queue = &epicsTimerQueueActive::allocate(true);
+    // different jitter sequences for IOCs started at the same time
+    epicsTimeStamp now = epicsTime::getCurrent();
+    reconnectSeed = now.nsec ^ (now.secPastEpoch * 2654435761u);
 }
 
 static bool
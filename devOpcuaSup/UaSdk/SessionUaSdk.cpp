@@ -943,6 +943,7 @@ SessionUaSdk::show (const int level) const
         std::cout << "?";
     std::cout << "(" << connectInfo.nMaxOperationsPerServiceCall << ")"
               << " autoconnect=" << (autoConnect ? "y" : "n")
+              << " reconnects=" << autoConnector.attemptsTotal()
               << " items=" << items.size()
               << " registered=" << registeredItemsNo
               << " subscriptions=" << subscriptions.size()
@@ -1169,6 +1170,7 @@ void SessionUaSdk::connectionStatusChanged (
                              name.c_str());
             }
         }
+        autoConnector.reset();
         if (serverConnectionStatus == UaClient::Disconnected) {
             updateNamespaceMap(puasession->getNamespaceTable());
             rebuildNodeIds();
@@ -1363,6 +1365,10 @@ SessionUaSdk::showAll (const int level)
               << connected << " connected) with "
               << subscriptions << " subscription(s) and "
               << items << " items" << std::endl;
+    std::cout << "OPC UA: " << reconnectAttempts << " reconnect attempt(s)";
+    if (opcua_ReconnectRate > 0.0)
+        std::cout << " (" << reconnectsDelayed << " delayed by rate limit)";
+    std::cout << std::endl;
     if (level >= 1) {
         for (auto &it : sessions) {
             it.second->show(level-1);
@@ -79,6 +79,15 @@ void SubscriptionUaSdk::setOption(const std::string &name, const std::string &va
     }
 }
 
+void
+SubscriptionUaSdk::modifyMonitoredItems (const std::vector<Item *> &items,
+                                         const std::map<std::string, std::string> &options)
+{
+    errlogPrintf("OPC UA subscription %s: modifying monitored items at runtime "
+                 "is not supported by the UaSdk client - ignored\n",
+                 name.c_str());
+}
+
 void
 SubscriptionUaSdk::show (int level) const
 {
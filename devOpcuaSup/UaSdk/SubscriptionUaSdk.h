@@ -60,6 +60,12 @@ public:
      */
     virtual void setOption(const std::string &name, const std::string &value) override;
 
+    /**
+     * @brief Change monitoring parameters. See DevOpcua::Subscription::modifyMonitoredItems
+     */
+    virtual void modifyMonitoredItems(const std::vector<Item *> &items,
+                                      const std::map<std::string, std::string> &options) override;
+
     /**
      * @brief Print configuration and status. See DevOpcua::Subscription::show
      */
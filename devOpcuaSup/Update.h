@@ -38,11 +38,13 @@ namespace DevOpcua {
  *
  * Update uses C++11 std::unique_ptr to manage the data object, i.e.
  * the data is owned by the Update until it goes out of scope.
+ * Data types that need cleanup beyond their destructor (e.g. C library
+ * structures owning memory) can specify a deleter type.
  * The status code is assumed to be small, i.e. the minimal raw type
  * that holds an OPC UA status.
  */
 
-template<typename T, typename S>
+template<typename T, typename S, typename D = std::default_delete<T>>
 class Update
 {
 public:
@@ -62,7 +64,7 @@ public:
         : overrides(0)
         , ts(time)
         , type(reason)
-        , data(std::unique_ptr<T>(new T(newdata)))
+        , data(std::unique_ptr<T, D>(new T(newdata)))
         , status(status)
     {}
 
@@ -78,7 +80,7 @@ public:
      * @param status  status code related to the update
      */
     Update(const epicsTime &time, const ProcessReason reason,
-           std::unique_ptr<T> newdata, S status)
+           std::unique_ptr<T, D> newdata, S status)
         : overrides(0)
         , ts(time)
         , type(reason)
@@ -113,7 +115,7 @@ public:
      *
      * @param other  update whose data is used to replace this
      */
-    void override(Update<T, S> &other)
+    void override(Update<T, S, D> &other)
     {
         ts = other.getTimeStamp();
         type = other.getType();
@@ -158,7 +160,7 @@ public:
      *
      * @return  unique_ptr to the update data
      */
-    std::unique_ptr<T> releaseData() { return std::move(data); }
+    std::unique_ptr<T, D> releaseData() { return std::move(data); }
 
     /**
      * @brief Getter for the update's data.
@@ -198,7 +200,7 @@ private:
     unsigned long overrides;
     epicsTime ts;
     ProcessReason type;
-    std::unique_ptr<T> data;
+    std::unique_ptr<T, D> data;
     S status;
 };
 
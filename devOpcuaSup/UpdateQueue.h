@@ -13,7 +13,7 @@
 
 #include <memory>
 #include <utility>
-#include <queue>
+#include <deque>
 
 #include <epicsMutex.h>
 
@@ -59,13 +59,13 @@ public:
         if (wasFirst) *wasFirst = false;
         if (updq.size() < maxElements) {
             if (wasFirst && updq.empty()) *wasFirst = true;
-            updq.push(update);
+            updq.push_back(update);
         } else {
             if (discardOldest) {
                 std::shared_ptr<T> drop = updq.front();
-                updq.pop();
+                updq.pop_front();
                 updq.front()->override(drop->getOverrides());
-                updq.push(update);
+                updq.push_back(update);
             } else {
                 updq.back()->override(*update);
             }
@@ -88,7 +88,7 @@ public:
     {
         Guard G(lock);
         std::shared_ptr<T> drop = updq.front();
-        updq.pop();
+        updq.pop_front();
         if (nextReason) {
             if (updq.empty()) *nextReason = ProcessReason::none;
             else *nextReason = updq.front()->getType();
@@ -125,11 +125,27 @@ public:
      */
     size_t capacity() const { return maxElements; }
 
+    /**
+     * @brief Calls a function for each element.
+     *
+     * Calls the function with a const reference to each queued update,
+     * starting at the front (oldest). The queue is locked during the traversal.
+     *
+     * @param f  function to call
+     */
+    template<typename F>
+    void forEach(F f) const
+    {
+        Guard G(lock);
+        for (const auto &update : updq)
+            f(*update);
+    }
+
 private:
     size_t maxElements;
     bool discardOldest;
-    epicsMutex lock;
-    std::queue<std::shared_ptr<T>> updq;
+    mutable epicsMutex lock;
+    std::deque<std::shared_ptr<T>> updq;
 };
 
 } // namespace DevOpcua
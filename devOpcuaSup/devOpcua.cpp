@@ -17,6 +17,7 @@
 #include <memory>
 #include <utility>
 #include <cmath>
+#include <cstring>
 
 #include <epicsVersion.h>
 #include <epicsStdlib.h>
@@ -100,6 +101,12 @@ opcua_add_record (dbCommon *prec)
         } else {
             pcon->pitem = pcon->plinkinfo->item;
         }
+        if (pcon->plinkinfo->zeroCopy) {
+            if (!strcmp(prec->rdes->name, "waveform"))
+                pcon->arrayBuffer = &reinterpret_cast<waveformRecord *>(prec)->bptr;
+            else
+                pcon->arrayBuffer = &reinterpret_cast<aaiRecord *>(prec)->bptr;
+        }
         DataElement::addElementToTree(pcon->pitem, pcon.get(), pcon->plinkinfo->elementPath);
         prec->dpvt = pcon.release();
         return 0;
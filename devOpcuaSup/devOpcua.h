@@ -74,6 +74,15 @@ reportPiniAndClear (dbCommon *prec) {
     prec->pini = 0;
 }
 
+/**
+ * @brief One element of a relative browse path (link option 'path').
+ */
+typedef struct BrowsePathElement {
+    bool aggregates = false;           /**< '.' (Aggregates) instead of '/' (HierarchicalReferences) */
+    epicsUInt16 namespaceIndex = 0;    /**< namespace index of the browse name */
+    std::string name;                  /**< browse name */
+} BrowsePathElement;
+
 /** @brief Configuration data for a single record instance.
  *
  * This structure holds all configuration data for a single instance of
@@ -94,6 +103,8 @@ typedef struct linkInfo {
     bool identifierIsNumeric = false;
     epicsUInt32 identifierNumber;
     std::string identifierString;
+    std::string browsePathString;      /**< relative browse path (as configured) */
+    std::list<BrowsePathElement> browsePath; /**< relative browse path (parsed; empty = none) */
 
     bool registerNode = false;
 
@@ -102,6 +113,12 @@ typedef struct linkInfo {
     epicsUInt32 clientQueueSize;
     bool discardOldest = true;
     double deadband = 0;
+    std::string trigger;               /**< record whose monitored item triggers reporting (empty = none) */
+    bool idle = false;                 /**< monitored item may idle while the record has no interest */
+    double maxAge = 0;                 /**< max age of values read from the server cache [ms] (0 = fresh) */
+    std::string readGroup;             /**< read group (empty = none) */
+    std::string writeGroup;            /**< write group (empty = none) */
+    bool commit = false;               /**< writes of this link flush the write group */
 
     std::string element;
     std::list<std::string> elementPath;
@@ -111,6 +128,7 @@ typedef struct linkInfo {
 
     bool isOutput;
     bool monitor = true;
+    bool zeroCopy = false;             /**< hand decoded array buffers over to the record (waveform/aai) */
 } linkInfo;
 
 /**
@@ -11,6 +11,8 @@
  */
 
 #include <iostream>
+#include <map>
+#include <vector>
 #include <set>
 #include <string>
 #include <string.h>
@@ -42,6 +44,11 @@ namespace DevOpcua {
 
 // session
 double opcua_ConnectTimeout = 5.0;               // [s]
+double opcua_ConnectDeadline = 10.0;             // [s]
+double opcua_ConnectBackoffMax = 60.0;           // [s]
+double opcua_ConnectBackoffFactor = 2.0;         // double the interval after every attempt
+double opcua_ConnectBackoffJitter = 0.2;         // +/- 20%
+double opcua_ReconnectRate = 0.0;                // no limit [1/s]
 int opcua_MaxOperationsPerServiceCall = 0;       // no limit (do not batch)
 
 // subscription
@@ -58,6 +65,11 @@ int opcua_MinimumClientQueueSize = 3;            // minimum client queue size
 
 extern "C" {
 epicsExportAddress(double, opcua_ConnectTimeout);
+epicsExportAddress(double, opcua_ConnectDeadline);
+epicsExportAddress(double, opcua_ConnectBackoffMax);
+epicsExportAddress(double, opcua_ConnectBackoffFactor);
+epicsExportAddress(double, opcua_ConnectBackoffJitter);
+epicsExportAddress(double, opcua_ReconnectRate);
 epicsExportAddress(int, opcua_MaxOperationsPerServiceCall);
 epicsExportAddress(double, opcua_DefaultPublishInterval);
 epicsExportAddress(double, opcua_DefaultSamplingInterval);
@@ -417,6 +429,73 @@ opcuaShowCallFunc(const iocshArgBuf *args)
     }
 }
 
+static const iocshArg opcuaModifyMonitoredItemsArg0 = {"pattern", iocshArgString};
+static const iocshArg opcuaModifyMonitoredItemsArg1 = {"[options]", iocshArgArgv};
+
+static const iocshArg *const opcuaModifyMonitoredItemsArg[2] = {&opcuaModifyMonitoredItemsArg0,
+                                                                &opcuaModifyMonitoredItemsArg1};
+
+const char opcuaModifyMonitoredItemsUsage[]
+    = "Changes the monitoring parameters of records at runtime.\n\n"
+      "pattern    glob pattern (supports * and ?) for record names\n"
+      "[options]  list of options in 'key=value' format\n\n"
+      "Valid options are:\n"
+      "sampling           sampling interval [ms]\n"
+      "qsize              server-side queue size\n"
+      "discard            discard policy of the server-side queue [old/new]\n"
+      "deadband           absolute deadband [0 = none]\n"
+      "trigger            record whose monitored item triggers reporting [empty = none]\n";
+
+static const iocshFuncDef opcuaModifyMonitoredItemsFuncDef = {"opcuaModifyMonitoredItems",
+                                                              2,
+                                                              opcuaModifyMonitoredItemsArg
+#ifdef IOCSHFUNCDEF_HAS_USAGE
+                                                              ,
+                                                              opcuaModifyMonitoredItemsUsage
+#endif
+};
+
+static void
+opcuaModifyMonitoredItemsCallFunc(const iocshArgBuf *args)
+{
+    try {
+        if (args[0].sval == NULL || args[0].sval[0] == '\0') {
+            errlogPrintf("missing argument #1 (pattern for record names)\n");
+        } else if (args[1].aval.ac <= 1) {
+            errlogPrintf("missing argument #2 (options)\n");
+        } else {
+            std::map<std::string, std::string> setopts;
+            for (int i = 1; i < args[1].aval.ac; i++) {
+                auto options = splitString(args[1].aval.av[i], ':');
+                for (auto &opt : options) {
+                    if (opt.empty()) continue;
+                    auto keyval = splitString(opt, '=');
+                    if (keyval.size() != 2)
+                        errlogPrintf("option '%s' must follow 'key=value' format - ignored\n",
+                                     opt.c_str());
+                    else
+                        setopts[keyval.front()] = keyval.back();
+                }
+            }
+            // Batch the items per subscription
+            std::map<Subscription *, std::vector<Item *>> items;
+            for (auto &rc : RecordConnector::glob(args[0].sval)) {
+                if (!rc->pitem->isMonitored())
+                    continue;
+                Subscription *s = Subscription::find(rc->pitem->linkinfo.subscription);
+                if (s)
+                    items[s].push_back(rc->pitem);
+            }
+            if (items.empty())
+                errlogPrintf("No monitored records matching pattern '%s'\n", args[0].sval);
+            for (auto &it : items)
+                it.first->modifyMonitoredItems(it.second, setopts);
+        }
+    } catch (std::exception &e) {
+        std::cerr << "ERROR : " << e.what() << std::endl;
+    }
+}
+
 static const iocshArg opcuaConnectArg0 = {"session", iocshArgString};
 
 static const iocshArg *const opcuaConnectArg[1] = {&opcuaConnectArg0};
@@ -1086,6 +1165,7 @@ void opcuaIocshRegister ()
     iocshRegister(&opcuaSubscriptionFuncDef, opcuaSubscriptionCallFunc);
     iocshRegister(&opcuaOptionsFuncDef, opcuaOptionsCallFunc);
     iocshRegister(&opcuaShowFuncDef, opcuaShowCallFunc);
+    iocshRegister(&opcuaModifyMonitoredItemsFuncDef, opcuaModifyMonitoredItemsCallFunc);
 
     iocshRegister(&opcuaConnectFuncDef, opcuaConnectCallFunc);
     iocshRegister(&opcuaDisconnectFuncDef, opcuaDisconnectCallFunc);
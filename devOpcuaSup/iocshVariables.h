@@ -26,6 +26,11 @@ namespace DevOpcua {
 
 // session
 extern double opcua_ConnectTimeout;            /**< connect timeout / reconnect attempt interval [s] */
+extern double opcua_ConnectDeadline;           /**< max time to wait for all sessions to connect at IOC start [s] (0 = don't wait) */
+extern double opcua_ConnectBackoffMax;         /**< max reconnect attempt interval [s] */
+extern double opcua_ConnectBackoffFactor;      /**< reconnect interval growth factor (1 = no backoff) */
+extern double opcua_ConnectBackoffJitter;      /**< reconnect interval randomization (fraction) */
+extern double opcua_ReconnectRate;             /**< max reconnect attempts per second, all sessions (0 = no limit) */
 extern int opcua_MaxOperationsPerServiceCall;  /**< batch size for operations (0 = no limit, don't batch) */
 
 // subscription
@@ -76,6 +76,173 @@ splitString(const std::string &str, const char delim)
     return tokens;
 }
 
+/* Relative browse path in the text format of OPC UA Part 4 (Annex A.2),
+ * restricted to the two predefined reference types:
+ *   '/' HierarchicalReferences, '.' Aggregates (both including subtypes)
+ * followed by a browse name with optional "<nsIndex>:" prefix.
+ * '&' escapes the next character. */
+std::list<BrowsePathElement>
+parseBrowsePath(const std::string &path)
+{
+    std::list<BrowsePathElement> elements;
+    size_t i = 0;
+
+    if (path.empty())
+        throw std::runtime_error(SB() << "empty browse path");
+    while (i < path.length()) {
+        BrowsePathElement element;
+        if (path[i] == '.')
+            element.aggregates = true;
+        else if (path[i] != '/')
+            throw std::runtime_error(SB() << "expected '/' or '.' at position " << i
+                                     << " of browse path '" << path << "'");
+        i++;
+
+        bool plain = true;  // no escaped characters (possible namespace prefix)
+        bool hasNamespace = false;
+        while (i < path.length() && path[i] != '/' && path[i] != '.') {
+            if (path[i] == '&') {
+                if (++i == path.length())
+                    throw std::runtime_error(SB() << "dangling '&' in browse path '" << path << "'");
+                plain = false;
+                element.name += path[i++];
+            } else if (path[i] == ':' && plain && !hasNamespace && element.name.length()
+                       && element.name.find_first_not_of("0123456789") == std::string::npos) {
+                if (epicsParseUInt16(element.name.c_str(), &element.namespaceIndex, 10, nullptr))
+                    throw std::runtime_error(SB() << "error converting namespace '" << element.name
+                                             << "' in browse path '" << path << "'");
+                hasNamespace = true;
+                element.name.clear();
+                i++;
+            } else {
+                element.name += path[i++];
+            }
+        }
+        if (element.name.empty())
+            throw std::runtime_error(SB() << "empty browse name in browse path '" << path << "'");
+        elements.push_back(element);
+    }
+    return elements;
+}
+
+void
+parseLinkOption (linkInfo &info, const std::string &optname, const std::string &optval)
+{
+    // Item/node related options
+    if (info.linkedToItem && optname == "ns") {
+        if (epicsParseUInt16(optval.c_str(), &info.namespaceIndex, 0, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt16");
+    } else if (info.linkedToItem && optname == "s") {
+        info.identifierString = optval;
+        info.identifierIsNumeric = false;
+    } else if (info.linkedToItem && optname == "i") {
+        if (epicsParseUInt32(optval.c_str(), &info.identifierNumber, 0, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
+        info.identifierIsNumeric = true;
+    } else if (info.linkedToItem && optname == "path") {
+        info.browsePath = parseBrowsePath(optval);
+        info.browsePathString = optval;
+    } else if (info.linkedToItem && optname == "sampling") {
+        if (epicsParseDouble(optval.c_str(), &info.samplingInterval, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << optval << "' to Double");
+    } else if (info.linkedToItem && optname == "maxage") {
+        if (epicsParseDouble(optval.c_str(), &info.maxAge, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << optval << "' to Double");
+        if (info.maxAge < 0.0)
+            throw std::runtime_error(SB() << "illegal value '" << optval << "'");
+    } else if (info.linkedToItem && optname == "readgroup") {
+        info.readGroup = optval;
+    } else if (info.linkedToItem && optname == "writegroup") {
+        info.writeGroup = optval;
+    } else if (info.linkedToItem && optname == "commit") {
+        if (optval.length() > 0) {
+            info.commit = getYesNo(optval[0]);
+        } else {
+            throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+        }
+    } else if (info.linkedToItem && optname == "deadband") {
+        if (epicsParseDouble(optval.c_str(), &info.deadband, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << optval << "' to Double");
+    } else if (info.linkedToItem && optname == "qsize") {
+        if (epicsParseUInt32(optval.c_str(), &info.queueSize, 0, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
+    } else if (info.linkedToItem && optname == "cqsize") {
+        if (epicsParseUInt32(optval.c_str(), &info.clientQueueSize, 0, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
+    } else if (info.linkedToItem && optname == "discard") {
+        if (optval == "new")
+            info.discardOldest = false;
+        else if (optval == "old")
+            info.discardOldest = true;
+        else
+            throw std::runtime_error(SB() << "illegal value '" << optval << "'");
+    } else if (info.linkedToItem && optname == "trigger") {
+        info.trigger = optval;
+    } else if (info.linkedToItem && optname == "idle") {
+        if (optval.length() > 0) {
+            info.idle = getYesNo(optval[0]);
+        } else {
+            throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+        }
+    } else if (info.linkedToItem && optname == "register") {
+        if (optval.length() > 0) {
+            info.registerNode = getYesNo(optval[0]);
+        } else {
+            throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+        }
+
+    // Item/node or Record/data element related options
+    } else if (optname == "timestamp") {
+        if (optval == linkOptionTimestampString(LinkOptionTimestamp::server))
+            info.timestamp = LinkOptionTimestamp::server;
+        else if (optval == linkOptionTimestampString(LinkOptionTimestamp::source))
+            info.timestamp = LinkOptionTimestamp::source;
+        else if (!info.isItemRecord && optval == linkOptionTimestampString(LinkOptionTimestamp::data))
+            info.timestamp = LinkOptionTimestamp::data;
+        else if (info.isItemRecord && optval[0] == '@') {
+            info.timestamp = LinkOptionTimestamp::data;
+            info.timestampElement = optval.substr(1);
+        } else
+            throw std::runtime_error(SB() << "illegal value '" << optval << "'");
+    } else if (optname == "monitor" || optname == "readback") {
+        if (optval.length() > 0) {
+            info.monitor = getYesNo(optval[0]);
+        } else {
+            throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+        }
+    } else if (optname == "zerocopy") {
+        if (optval.length() > 0) {
+            info.zeroCopy = getYesNo(optval[0]);
+        } else {
+            throw std::runtime_error(SB() << "no value for option '" << optname << "'");
+        }
+    } else if (optname == "element") {
+        info.element = optval;
+        info.elementPath = splitString(optval);
+    } else if (optname == "bini") {
+        if (optval == "read")
+            info.bini = LinkOptionBini::read;
+        else if (optval == "ignore")
+            info.bini = LinkOptionBini::ignore;
+        else if ((info.isItemRecord || info.isOutput) && optval == "write")
+            info.bini = LinkOptionBini::write;
+        else
+            throw std::runtime_error(SB() << "illegal value '" << optval << "' for option '" << optname << "'");
+    } else {
+        throw std::runtime_error(SB() << "invalid option '" << optname << "'");
+    }
+}
+
+void
+checkLinkOptions (const linkInfo &info)
+{
+    if (info.commit && info.writeGroup.empty())
+        throw std::runtime_error(SB() << "option 'commit' needs option 'writegroup'");
+    // The interest in an opcuaItem record's data is spread over its element records
+    if (info.idle && info.isItemRecord)
+        throw std::runtime_error(SB() << "option 'idle' is not supported for opcuaItem records");
+}
+
 std::unique_ptr<linkInfo>
 parseLink (dbCommon *prec, const DBEntry &ent)
 {
@@ -261,81 +428,13 @@ parseLink (dbCommon *prec, const DBEntry &ent)
             std::cerr << prec->name << " opt '" << optname << "'='" << optval << "'" << std::endl;
         }
 
-        // Item/node related options
-        if (pinfo->linkedToItem && optname == "ns") {
-            if (epicsParseUInt16(optval.c_str(), &pinfo->namespaceIndex, 0, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt16");
-        } else if (pinfo->linkedToItem && optname == "s") {
-            pinfo->identifierString = optval;
-            pinfo->identifierIsNumeric = false;
-        } else if (pinfo->linkedToItem && optname == "i") {
-            if (epicsParseUInt32(optval.c_str(), &pinfo->identifierNumber, 0, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
-            pinfo->identifierIsNumeric = true;
-        } else if (pinfo->linkedToItem && optname == "sampling") {
-            if (epicsParseDouble(optval.c_str(), &pinfo->samplingInterval, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to Double");
-        } else if (pinfo->linkedToItem && optname == "deadband") {
-            if (epicsParseDouble(optval.c_str(), &pinfo->deadband, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to Double");
-        } else if (pinfo->linkedToItem && optname == "qsize") {
-            if (epicsParseUInt32(optval.c_str(), &pinfo->queueSize, 0, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
-        } else if (pinfo->linkedToItem && optname == "cqsize") {
-            if (epicsParseUInt32(optval.c_str(), &pinfo->clientQueueSize, 0, nullptr))
-                throw std::runtime_error(SB() << "error converting '" << optval << "' to UInt32");
-        } else if (pinfo->linkedToItem && optname == "discard") {
-            if (optval == "new")
-                pinfo->discardOldest = false;
-            else if (optval == "old")
-                pinfo->discardOldest = true;
-            else
-                throw std::runtime_error(SB() << "illegal value '" << optval << "'");
-        } else if (pinfo->linkedToItem && optname == "register") {
-            if (optval.length() > 0) {
-                pinfo->registerNode = getYesNo(optval[0]);
-            } else {
-                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
-            }
-
-        // Item/node or Record/data element related options
-        } else if (optname == "timestamp") {
-            if (optval == linkOptionTimestampString(LinkOptionTimestamp::server))
-                pinfo->timestamp = LinkOptionTimestamp::server;
-            else if (optval == linkOptionTimestampString(LinkOptionTimestamp::source))
-                pinfo->timestamp = LinkOptionTimestamp::source;
-            else if (!pinfo->isItemRecord && optval == linkOptionTimestampString(LinkOptionTimestamp::data))
-                pinfo->timestamp = LinkOptionTimestamp::data;
-            else if (pinfo->isItemRecord && optval[0] == '@') {
-                pinfo->timestamp = LinkOptionTimestamp::data;
-                pinfo->timestampElement = optval.substr(1);
-            } else
-                throw std::runtime_error(SB() << "illegal value '" << optval << "'");
-        } else if (optname == "monitor" || optname == "readback") {
-            if (optval.length() > 0) {
-                pinfo->monitor = getYesNo(optval[0]);
-            } else {
-                throw std::runtime_error(SB() << "no value for option '" << optname << "'");
-            }
-        } else if (optname == "element") {
-            pinfo->element = optval;
-            pinfo->elementPath = splitString(optval);
-        } else if (optname == "bini") {
-            if (optval == "read")
-                pinfo->bini = LinkOptionBini::read;
-            else if (optval == "ignore")
-                pinfo->bini = LinkOptionBini::ignore;
-            else if ((pinfo->isItemRecord || pinfo->isOutput) && optval == "write")
-                pinfo->bini = LinkOptionBini::write;
-            else
-                throw std::runtime_error(SB() << "illegal value '" << optval << "' for option '" << optname << "'");
-        } else {
-            throw std::runtime_error(SB() << "invalid option '" << optname << "'");
-        }
+        parseLinkOption(*pinfo, optname, optval);
 
         sep = linkstr.find_first_not_of("; \t", send);
     }
 
+    checkLinkOptions(*pinfo);
+
     if (!pinfo->clientQueueSize) {
         pinfo->clientQueueSize = static_cast<epicsUInt32>(ceil(abs(opcua_ClientQueueSizeFactor) * pinfo->queueSize));
         epicsUInt32 mini = static_cast<epicsUInt32>(abs(opcua_MinimumClientQueueSize));
@@ -354,12 +453,22 @@ parseLink (dbCommon *prec, const DBEntry &ent)
                 std::cout << " id(i)=" << pinfo->identifierNumber;
             else
                 std::cout << " id(s)=" << pinfo->identifierString;
+            if (pinfo->browsePath.size())
+                std::cout << " path=" << pinfo->browsePathString;
             std::cout << " sampling=" << pinfo->samplingInterval
                       << " deadband=" << pinfo->deadband
                       << " qsize=" << pinfo->queueSize
                       << " cqsize=" << pinfo->clientQueueSize
                       << " discard=" << (pinfo->discardOldest ? "old" : "new")
                       << " registered=" << (pinfo->registerNode ? "y" : "n");
+            if (pinfo->trigger.length())
+                std::cout << " trigger=" << pinfo->trigger;
+            if (pinfo->maxAge > 0.0)
+                std::cout << " maxage=" << pinfo->maxAge;
+            if (pinfo->readGroup.length())
+                std::cout << " readgroup=" << pinfo->readGroup;
+            if (pinfo->writeGroup.length())
+                std::cout << " writegroup=" << pinfo->writeGroup << (pinfo->commit ? " commit=y" : "");
         } else {
             std::cout << " element=" << pinfo->element;
         }
@@ -369,6 +478,7 @@ parseLink (dbCommon *prec, const DBEntry &ent)
         std::cout << " output=" << (pinfo->isOutput ? "y" : "n")
                   << " monitor=" << (pinfo->monitor ? "y" : "n")
                   << " bini=" << linkOptionBiniString(pinfo->bini)
+                  << " zerocopy=" << (pinfo->zeroCopy ? "y" : "n")
                   << std::endl;
     }
 
@@ -378,6 +488,8 @@ parseLink (dbCommon *prec, const DBEntry &ent)
     if (pinfo->monitor && !pinfo->linkedToItem && !pinfo->item->linkinfo.monitor)
         throw std::runtime_error(SB() << "monitor=y requires link to monitored opcuaItemRecord (but "
                                  << pinfo->item->recConnector->getRecordName() << " is not)");
+    if (pinfo->zeroCopy && strcmp(prec->rdes->name, "waveform") && strcmp(prec->rdes->name, "aai"))
+        throw std::runtime_error(SB() << "zerocopy=y requires a waveform or aai record");
 
     return pinfo;
 }
@@ -40,6 +40,31 @@ bool getYesNo(const char c);
 std::list<std::string> splitString(const std::string &str,
                                    const char delim = defaultElementDelimiter);
 
+std::list<BrowsePathElement> parseBrowsePath(const std::string &path);
+
+/**
+ * @brief Apply a single "key=value" link option.
+ *
+ * Item/node related options are only accepted for links to items
+ * (linkedToItem set).
+ *
+ * @param info  link configuration to update
+ * @param optname  option name
+ * @param optval  option value
+ *
+ * @throws std::runtime_error for unknown options and illegal values
+ */
+void parseLinkOption(linkInfo &info, const std::string &optname, const std::string &optval);
+
+/**
+ * @brief Check the combination of link options after parsing.
+ *
+ * @param info  link configuration
+ *
+ * @throws std::runtime_error for inconsistent options
+ */
+void checkLinkOptions(const linkInfo &info);
+
 std::unique_ptr<linkInfo> parseLink(dbCommon *prec, const DBEntry &ent);
 
 } // namespace DevOpcua
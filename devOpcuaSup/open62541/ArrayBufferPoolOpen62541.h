@@ -0,0 +1,135 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#ifndef DEVOPCUA_ARRAYBUFFERPOOLOPEN62541_H
+#define DEVOPCUA_ARRAYBUFFERPOOLOPEN62541_H
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <epicsMutex.h>
+#include <epicsGuard.h>
+
+#include <open62541/types.h>
+
+namespace DevOpcua {
+
+/**
+ * @brief Array buffers for the zero-copy hand-off to waveform/aai records.
+ *
+ * The array buffer of an update is handed over to the record, replacing its bptr.
+ * The record's previous buffer goes to the (bounded) pool and is reused for the next
+ * incoming value that has to be copied.
+ * Only buffers allocated by open62541 go to the pool, as they may end up in a variant
+ * that is cleared by the library. The record's own buffer (allocated with calloc by
+ * the record support) is the first one to be replaced and is released with free.
+ */
+class ArrayBufferPoolOpen62541
+{
+public:
+    /**
+     * @brief Construct an empty pool.
+     * @param max  max number of pooled buffers
+     */
+    explicit ArrayBufferPoolOpen62541(const size_t max)
+        : maxBuffers(max)
+        , blockSize(0)
+        , recordBufferReplaced(false)
+    {}
+
+    ~ArrayBufferPoolOpen62541()
+    {
+        for (auto buffer : pool)
+            UA_free(buffer);
+    }
+
+    /**
+     * @brief Hand the array of an update over to the record.
+     *
+     * Only done if the record reads into its own buffer and the update
+     * has exactly the number of elements of the record buffer.
+     *
+     * @param bptr  the record's array buffer pointer (replaced)
+     * @param value  buffer that the record reads into
+     * @param num  number of elements of the record buffer
+     * @param variant  incoming array (emptied on success)
+     * @return true if the buffer was handed over, false if the caller has to copy
+     */
+    bool handOff(void *&bptr, void *value, const size_t num, UA_Variant &variant)
+    {
+        if (bptr != value || variant.arrayLength != num || variant.data <= UA_EMPTY_ARRAY_SENTINEL)
+            return false;
+
+        bptr = variant.data;
+        variant.data = nullptr;
+        variant.arrayLength = 0;
+
+        epicsGuard<epicsMutex> G(lock);
+        blockSize = num * variant.type->memSize;
+        if (!recordBufferReplaced) {
+            recordBufferReplaced = true;
+            free(value);
+        } else if (pool.size() < maxBuffers) {
+            pool.push_back(value);
+        } else {
+            UA_free(value);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Copy an incoming array into a pooled buffer.
+     *
+     * @param value  incoming value
+     * @param[out] copy  copy of the value (untouched if no buffer fits)
+     * @return true if a pooled buffer was used, false if the caller has to copy
+     */
+    bool copy(const UA_Variant &value, UA_Variant *copy)
+    {
+        if (UA_Variant_isScalar(&value) || !value.type->pointerFree || value.data <= UA_EMPTY_ARRAY_SENTINEL)
+            return false;
+        epicsGuard<epicsMutex> G(lock);
+        if (pool.empty() || value.arrayLength * value.type->memSize != blockSize)
+            return false;
+        UA_Variant_init(copy);
+        copy->type = value.type;
+        copy->arrayLength = value.arrayLength;
+        copy->data = pool.back();
+        pool.pop_back();
+        memcpy(copy->data, value.data, blockSize);
+        return true;
+    }
+
+    /** @brief Number of pooled buffers. */
+    size_t size() const
+    {
+        epicsGuard<epicsMutex> G(lock);
+        return pool.size();
+    }
+
+    /** @brief Memory used by the pooled buffers [bytes]. */
+    size_t memoryUsage() const
+    {
+        epicsGuard<epicsMutex> G(lock);
+        return pool.size() * blockSize;
+    }
+
+private:
+    mutable epicsMutex lock;        /**< lock for the pool */
+    std::vector<void *> pool;       /**< array buffers handed back by the record */
+    size_t maxBuffers;              /**< max number of pooled buffers */
+    size_t blockSize;               /**< size of a pooled buffer [bytes] */
+    bool recordBufferReplaced;      /**< the record's own (calloc'd) buffer has been freed */
+};
+
+} // namespace DevOpcua
+
+#endif // DEVOPCUA_ARRAYBUFFERPOOLOPEN62541_H
@@ -28,10 +28,16 @@
 #define UA_STATUS_IS_UNCERTAIN(status) (((status)&UA_STATUSCODE_UNCERTAIN)!=0)
 
 #include <string>
+#include <memory>
 
 namespace DevOpcua {
 
-typedef Update<UA_Variant, UA_StatusCode> UpdateOpen62541;
+// Variants in queued updates own their data: clear them when an update is dropped
+struct UpdateVariantDeleter {
+    void operator()(UA_Variant *p) const { UA_Variant_clear(p); delete p; }
+};
+
+typedef Update<UA_Variant, UA_StatusCode, UpdateVariantDeleter> UpdateOpen62541;
 
 inline const char *
 variantTypeString (const UA_DataType *type)
@@ -54,6 +60,49 @@ inline int typeKindOf(const UA_Variant& v)
     return typeKindOf(v.type);
 }
 
+/**
+ * @brief Approximate memory (in bytes) of the data owned by a variant.
+ *
+ * Counts the data array (or scalar) and the payload of string-like elements.
+ * Data referenced but not owned by the variant (UA_VARIANT_DATA_NODELETE) is not counted.
+ *
+ * @param v  variant
+ * @return  number of bytes
+ */
+inline size_t
+variantMemoryUsage (const UA_Variant &v)
+{
+    if (!v.type || v.storageType != UA_VARIANT_DATA || v.data <= UA_EMPTY_ARRAY_SENTINEL)
+        return 0;
+    size_t n = UA_Variant_isScalar(&v) ? 1 : v.arrayLength;
+    size_t bytes = n * v.type->memSize;
+    switch (v.type->typeKind) {
+    case UA_DATATYPEKIND_STRING:
+    case UA_DATATYPEKIND_BYTESTRING:
+    case UA_DATATYPEKIND_XMLELEMENT:
+        for (size_t i = 0; i < n; i++)
+            bytes += static_cast<const UA_String *>(v.data)[i].length;
+        break;
+    case UA_DATATYPEKIND_LOCALIZEDTEXT:
+        for (size_t i = 0; i < n; i++)
+            bytes += static_cast<const UA_LocalizedText *>(v.data)[i].locale.length
+                     + static_cast<const UA_LocalizedText *>(v.data)[i].text.length;
+        break;
+    case UA_DATATYPEKIND_EXTENSIONOBJECT:
+        for (size_t i = 0; i < n; i++) {
+            const UA_ExtensionObject &eo = static_cast<const UA_ExtensionObject *>(v.data)[i];
+            if (eo.encoding >= UA_EXTENSIONOBJECT_DECODED)
+                bytes += eo.content.decoded.type->memSize;
+            else
+                bytes += eo.content.encoded.body.length;
+        }
+        break;
+    default:
+        break;
+    }
+    return bytes;
+}
+
 /**
  * @brief The DataElementOpen62541 implementation of a single piece of data.
  *
@@ -84,6 +133,15 @@ public:
      */
     virtual void show(const int level, const unsigned int indent) const = 0;
 
+    /**
+     * @brief Get the (approximate) memory used for data by the element and its sub-elements.
+     *
+     * Counts cached and queued values, not the element objects themselves.
+     *
+     * @return  number of bytes
+     */
+    virtual size_t memoryUsage() const = 0;
+
     /**
      * @brief Push an incoming data value into the DataElement.
      *
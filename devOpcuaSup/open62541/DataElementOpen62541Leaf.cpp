@@ -33,6 +33,7 @@ DataElementOpen62541Leaf::DataElementOpen62541Leaf (const std::string &name,
                                                     RecordConnector *pconnector)
     : DataElementOpen62541(name, item)
     , incomingQueue(pconnector->plinkinfo->clientQueueSize, pconnector->plinkinfo->discardOldest)
+    , bufferPool(incomingQueue.capacity())
 {
     UA_Variant_init(&incomingData);
     UA_Variant_init(&outgoingData);
@@ -69,6 +70,7 @@ DataElementOpen62541Leaf::addElementToTree (ItemOpen62541 *item,
     // reference from connector after adding to the tree worked
     pconnector->setDataElement(leaf);
     leaf->pconnector = pconnector;
+    item->addTimestampNeed(pconnector->plinkinfo->timestamp);
 }
 
 void
@@ -77,10 +79,22 @@ DataElementOpen62541Leaf::show (const int level, const unsigned int indent) cons
     std::string ind(static_cast<epicsInt64>(indent) * 2, ' '); // static_cast to avoid warning C26451
     std::cout << ind;
     std::cout << "leaf=" << name << " record(" << pconnector->getRecordType() << ")=" << pconnector->getRecordName()
-              << " type=" << variantTypeString(incomingData)
+              << " type=" << variantTypeString(incomingType)
               << " timestamp=" << linkOptionTimestampString(pconnector->plinkinfo->timestamp)
               << " bini=" << linkOptionBiniString(pconnector->plinkinfo->bini)
-              << " monitor=" << (pconnector->plinkinfo->monitor ? "y" : "n") << "\n";
+              << " monitor=" << (pconnector->plinkinfo->monitor ? "y" : "n")
+              << " memory=" << memoryUsage() << "\n";
+}
+
+size_t
+DataElementOpen62541Leaf::memoryUsage () const
+{
+    size_t bytes = variantMemoryUsage(incomingData) + variantMemoryUsage(outgoingData);
+    incomingQueue.forEach([&bytes](const UpdateOpen62541 &u) {
+        if (u)
+            bytes += variantMemoryUsage(u.getData());
+    });
+    return bytes + bufferPool.memoryUsage();
 }
 
 #ifndef UA_ENABLE_TYPEDESCRIPTION
@@ -107,11 +121,18 @@ memberTypeOf(const UA_DataType *type, const UA_DataTypeMember *m) {
 void
 DataElementOpen62541Leaf::setIncomingData (const UA_Variant &value, ProcessReason reason, const std::string *timefrom)
 {
-    // Cache this element. We can make a shallow copy because
-    // ItemOpen62541::setIncomingData marks the original response data as "ours".
-    // Member data is owned by the [ROOT] element.
+    // The [ROOT] element owns the response data (ItemOpen62541::setIncomingData marks it as "ours"),
+    // member data is owned by the [ROOT] node and only referenced here.
+    const bool owned = (value.storageType == UA_VARIANT_DATA);
+
+    // Cache this element. Writing arrays of plain data only needs the type,
+    // so for these no reference to the data is kept.
+    const bool typeOnly = value.type && value.type->pointerFree && !UA_Variant_isScalar(&value);
+    incomingType = value.type;
+    incomingScalar = UA_Variant_isScalar(&value);
     UA_Variant_clear(&incomingData);
-    incomingData = value;
+    if (!typeOnly)
+        incomingData = value;
 
     if (pconnector->state() == ConnectionStatus::initialRead && typeKindOf(value) == UA_DATATYPEKIND_ENUM) {
         enumChoices = pitem->session->getEnumChoices(&value.type->typeId);
@@ -121,11 +142,15 @@ DataElementOpen62541Leaf::setIncomingData (const UA_Variant &value, ProcessReaso
         || (pconnector->state() == ConnectionStatus::up)) {
         Guard(pconnector->lock);
         bool wasFirst = false;
-        // Make a copy of the value for this element and put it on the queue
+        // Put the value for this element on the queue:
+        // move owned data that is not cached, copy everything else
         UA_Variant *valuecopy(new UA_Variant);
-        UA_Variant_copy(&value, valuecopy); // As a non-C++ object, UA_Variant has no copy constructor
+        if (owned && typeOnly)
+            *valuecopy = value;
+        else
+            copyIncomingValue(value, valuecopy);
         UpdateOpen62541 *u(new UpdateOpen62541(
-            getIncomingTimeStamp(), reason, std::unique_ptr<UA_Variant>(valuecopy), getIncomingReadStatus()));
+            getIncomingTimeStamp(), reason, std::unique_ptr<UA_Variant, UpdateVariantDeleter>(valuecopy), getIncomingReadStatus()));
         incomingQueue.pushUpdate(std::shared_ptr<UpdateOpen62541>(u), &wasFirst);
         if (debug() >= 5)
             std::cout << "Item " << pitem << " element " << name << " set data (" << processReasonString(reason)
@@ -133,9 +158,28 @@ DataElementOpen62541Leaf::setIncomingData (const UA_Variant &value, ProcessReaso
                       << incomingQueue.capacity() << ")" << std::endl;
         if (wasFirst)
             pconnector->requestRecordProcessing(reason);
+    } else if (owned && typeOnly) {
+        UA_Variant unused = value;
+        UA_Variant_clear(&unused);
     }
 }
 
+// Zero-copy mode (waveform/aai): see ArrayBufferPoolOpen62541
+
+bool
+DataElementOpen62541Leaf::handOffArray (void *value, const epicsUInt32 num, UA_Variant &variant)
+{
+    return pconnector->arrayBuffer && bufferPool.handOff(*pconnector->arrayBuffer, value, num, variant);
+}
+
+void
+DataElementOpen62541Leaf::copyIncomingValue (const UA_Variant &value, UA_Variant *copy)
+{
+    if (pconnector->arrayBuffer && bufferPool.copy(value, copy))
+        return;
+    UA_Variant_copy(&value, copy); // As a non-C++ object, UA_Variant has no copy constructor
+}
+
 void
 DataElementOpen62541Leaf::setIncomingEvent (ProcessReason reason)
 {
@@ -345,6 +389,9 @@ DataElementOpen62541Leaf::readScalar (char *value, const epicsUInt32 len,
                 UA_String buffer = UA_STRING_NULL;
                 UA_String *datastring = &buffer;
                 size_t n = len-1;
+                char numbuf[maxNumberStringLength + 1];
+                UA_String numstring;
+                numstring.data = reinterpret_cast<UA_Byte*>(numbuf);
 
                 UA_Variant &variant = upd->getData();
                 void* payload = variant.data;
@@ -414,12 +461,46 @@ DataElementOpen62541Leaf::readScalar (char *value, const epicsUInt32 len,
                     if (enumChoices) {
                         auto it = enumChoices->find(*static_cast<UA_UInt32*>(payload));
                         if (it != enumChoices->end()) {
-                            buffer = UA_String_fromChars(it->second.c_str());
+                            numstring.data = reinterpret_cast<UA_Byte*>(const_cast<char*>(it->second.data()));
+                            numstring.length = it->second.length();
+                            datastring = &numstring;
                             break;
                         }
                     }
-                    // no enum or index not found: fall through
+                    // no enum or index not found: print number
+                    numstring.length = formatNumber(numbuf, sizeof(numbuf), *static_cast<UA_Int32*>(payload));
+                    datastring = &numstring;
+                    break;
                 }
+                // Print numbers into a local buffer instead of allocating through UA_print
+                case UA_DATATYPEKIND_INT16:
+                    numstring.length = formatNumber(numbuf, sizeof(numbuf), *static_cast<UA_Int16*>(payload));
+                    datastring = &numstring;
+                    break;
+                case UA_DATATYPEKIND_UINT16:
+                    numstring.length = formatNumber(numbuf, sizeof(numbuf), *static_cast<UA_UInt16*>(payload));
+                    datastring = &numstring;
+                    break;
+                case UA_DATATYPEKIND_UINT32:
+                    numstring.length = formatNumber(numbuf, sizeof(numbuf), *static_cast<UA_UInt32*>(payload));
+                    datastring = &numstring;
+                    break;
+                case UA_DATATYPEKIND_INT64:
+                    numstring.length = formatNumber(numbuf, sizeof(numbuf), *static_cast<UA_Int64*>(payload));
+                    datastring = &numstring;
+                    break;
+                case UA_DATATYPEKIND_UINT64:
+                    numstring.length = formatNumber(numbuf, sizeof(numbuf), *static_cast<UA_UInt64*>(payload));
+                    datastring = &numstring;
+                    break;
+                case UA_DATATYPEKIND_FLOAT:
+                    numstring.length = formatNumber(numbuf, sizeof(numbuf), *static_cast<UA_Float*>(payload));
+                    datastring = &numstring;
+                    break;
+                case UA_DATATYPEKIND_DOUBLE:
+                    numstring.length = formatNumber(numbuf, sizeof(numbuf), *static_cast<UA_Double*>(payload));
+                    datastring = &numstring;
+                    break;
                 default:
                     if (type)
                         UA_print(payload, type, &buffer);
@@ -651,10 +732,7 @@ DataElementOpen62541Leaf::readArray<epicsUInt8> (epicsUInt8 *value, const epicsU
                 UA_Variant &variant = upd->getData();
                 if (UA_Variant_isScalar(&variant) && variant.type == &UA_TYPES[UA_TYPES_BYTESTRING]) {
                     const UA_ByteString& bs = *static_cast<UA_ByteString*>(variant.data);
-                    elemsWritten = static_cast<epicsUInt32>(bs.length);
-                    if (elemsWritten > num)
-                        elemsWritten = num;
-                    memcpy(value, bs.data, elemsWritten);
+                    elemsWritten = Open62541Conversion::copyArray(value, num, bs.data, bs.length);
                 } else if (UA_Variant_isScalar(&variant)) {
                     errlogPrintf("%s : incoming data is not an array\n", prec->name);
                     (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
@@ -668,10 +746,10 @@ DataElementOpen62541Leaf::readArray<epicsUInt8> (epicsUInt8 *value, const epicsU
                     if (UA_STATUS_IS_UNCERTAIN(stat)) {
                         (void) recGblSetSevr(prec, READ_ALARM, MINOR_ALARM);
                     }
-                    elemsWritten = static_cast<epicsUInt32>(variant.arrayLength);
-                    if (elemsWritten > num)
+                    if (handOffArray(value, num, variant))
                         elemsWritten = num;
-                    memcpy(value, variant.data, elemsWritten);
+                    else
+                        elemsWritten = Open62541Conversion::copyArray(value, num, variant.data, variant.arrayLength);
                     prec->udf = false;
                 }
                 UA_Variant_clear(&variant);
@@ -868,15 +946,11 @@ DataElementOpen62541Leaf::writeScalar (const char *value, epicsUInt32 len, dbCom
 {
     long ret = 1;
     UA_StatusCode status = UA_STATUSCODE_BADUNEXPECTEDERROR;
-    long l;
-    unsigned long ul;
-    double d;
-    char* end = nullptr;
 
     { // Scope of Guard G
         Guard G(outgoingLock);
         UA_Variant_clear(&outgoingData);  // unlikely but we may still have unsent old data to discard
-        const UA_DataType* type = incomingData.type;
+        const UA_DataType* type = incomingType;
 
         int switchfield = -1;
         if (typeKindOf(type) == UA_DATATYPEKIND_UNION) {
@@ -893,6 +967,7 @@ DataElementOpen62541Leaf::writeScalar (const char *value, epicsUInt32 len, dbCom
                 }
             }
         }
+        const size_t numlen = strnlen(value, len);
 
         switch (typeKindOf(type)) {
         case UA_DATATYPEKIND_STRING:
@@ -954,128 +1029,21 @@ DataElementOpen62541Leaf::writeScalar (const char *value, epicsUInt32 len, dbCom
             }
             break;
         }
-        case UA_DATATYPEKIND_BOOLEAN:
-        {
-            UA_Boolean val = strchr("YyTt1", *value) != NULL;
-            status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-            markAsDirty();
-            ret = 0;
-            break;
-        }
-        case UA_DATATYPEKIND_BYTE:
-            ul = strtoul(value, &end, 0);
-            if (end != value && isWithinRange<UA_Byte>(ul)) {
-                UA_Byte val = static_cast<UA_Byte>(ul);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case UA_DATATYPEKIND_SBYTE:
-            l = strtol(value, &end, 0);
-            if (end != value && isWithinRange<UA_SByte>(l)) {
-                UA_SByte val = static_cast<UA_Byte>(l);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case UA_DATATYPEKIND_UINT16:
-            ul = strtoul(value, &end, 0);
-            if (end != value && isWithinRange<UA_UInt16>(ul)) {
-                UA_UInt16 val = static_cast<UA_UInt16>(ul);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case UA_DATATYPEKIND_INT16:
-            l = strtol(value, &end, 0);
-            if (end != value && isWithinRange<UA_Int16>(l)) {
-                UA_Int16 val = static_cast<UA_Int16>(l);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case UA_DATATYPEKIND_UINT32:
-            ul = strtoul(value, &end, 0);
-            if (end != value && isWithinRange<UA_UInt32>(ul)) {
-                UA_UInt32 val = static_cast<UA_UInt32>(ul);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case UA_DATATYPEKIND_ENUM:
-        case UA_DATATYPEKIND_INT32:
-            l = strtol(value, &end, 0);
-            if (enumChoices) {
-                // first test enum strings then numeric values
-                // in case a string starts with a number but means a different value
-                for (const auto &it: *enumChoices)
-                    if (it.second == value) {
-                        l = static_cast<long>(it.first);
-                        ret = 0;
-                        end = nullptr;
-                        break;
-                    }
-                if (ret != 0 && end != value)
-                    for (const auto &it: *enumChoices)
-                        if (l == it.first) {
-                            ret = 0;
-                            break;
-                        }
-                if (ret != 0)
-                    break;
-            }
-            if (end != value && isWithinRange<UA_Int32>(l)) {
-                UA_Int32 val = static_cast<UA_Int32>(l);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_INT32]);
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case UA_DATATYPEKIND_UINT64:
-            ul = strtoul(value, &end, 0);
-            if (end != value && isWithinRange<UA_UInt64>(ul)) {
-                UA_UInt64 val = static_cast<UA_UInt64>(ul);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case UA_DATATYPEKIND_INT64:
-            l = strtol(value, &end, 0);
-            if (end != value && isWithinRange<UA_Int64>(l)) {
-                UA_Int64 val = static_cast<UA_Int64>(l);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-                markAsDirty();
-                ret = 0;
-            }
-            break;
-        case UA_DATATYPEKIND_FLOAT:
-            d = strtod(value, &end);
-            if (end != value && isWithinRange<UA_Float>(d)) {
-                UA_Float val = static_cast<UA_Float>(d);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
+        default:
+            switch (Open62541Conversion::fromString(value, numlen, Open62541ConversionTraits::kindOf(type),
+                                                    outgoingData, enumChoices, status)) {
+            case ConversionResult::ok:
                 markAsDirty();
                 ret = 0;
+                break;
+            case ConversionResult::unsupported:
+                errlogPrintf("%s : unsupported conversion from string to %s for outgoing data\n",
+                             prec->name, variantTypeString(incomingType));
+                (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
+                break;
+            default:
+                break;
             }
-            break;
-        case UA_DATATYPEKIND_DOUBLE:
-        {
-            d = strtod(value, &end);
-            if (end != value) {
-                UA_Double val = static_cast<UA_Double>(d);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, type);
-            }
-            break;
-        }
-        default:
-            errlogPrintf("%s : unsupported conversion from string to %s for outgoing data\n",
-                         prec->name, variantTypeString(incomingData));
-            (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         }
         if (switchfield >= 0) {
             // manually wrap value from outgoingData into union
@@ -1141,12 +1109,12 @@ DataElementOpen62541Leaf::writeArray (const char *value, epicsUInt32 len,
 {
     long ret = 0;
 
-    if (UA_Variant_isScalar(&incomingData)) {
+    if (incomingScalar) {
         errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
     } else {
-        const UA_DataType* type = incomingData.type;
+        const UA_DataType* type = incomingType;
         void* data = UA_Array_new(num, type);
         if (!data) {
             errlogPrintf("%s : out of memory\n", prec->name);
@@ -1203,7 +1171,7 @@ DataElementOpen62541Leaf::writeArray (const char *value, epicsUInt32 len,
             default:
                 errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
                              prec->name,
-                             variantTypeString(incomingData),
+                             variantTypeString(incomingType),
                              variantTypeString(targetType),
                              epicsTypeString(value));
                 (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
@@ -1235,25 +1203,25 @@ DataElementOpen62541Leaf::writeArray<epicsUInt8>(const epicsUInt8 *value,
 {
     long ret = 0;
 
-    if (UA_Variant_isScalar(&incomingData) && incomingData.type == &UA_TYPES[UA_TYPES_BYTESTRING]) {
+    if (incomingScalar && incomingType == &UA_TYPES[UA_TYPES_BYTESTRING]) {
         UA_ByteString bs;
         bs.length = num;
         bs.data = static_cast<UA_Byte*>(const_cast<epicsUInt8 *>(value));
         { // Scope of Guard G
             Guard G(outgoingLock);
-            UA_Variant_setScalarCopy(&outgoingData, &bs, incomingData.type);
+            UA_Variant_setScalarCopy(&outgoingData, &bs, incomingType);
             markAsDirty();
         }
 
         dbgWriteScalar();
-    } else if (UA_Variant_isScalar(&incomingData)) {
+    } else if (incomingScalar) {
         errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
         ret = 1;
-    } else if (typeKindOf(incomingData) != UA_DATATYPEKIND_BYTE && typeKindOf(incomingData) != UA_DATATYPEKIND_BOOLEAN) {
+    } else if (typeKindOf(incomingType) != UA_DATATYPEKIND_BYTE && typeKindOf(incomingType) != UA_DATATYPEKIND_BOOLEAN) {
         errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
                      prec->name,
-                     variantTypeString(incomingData),
+                     variantTypeString(incomingType),
                      variantTypeString(targetType),
                      epicsTypeString(*value));
         (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
@@ -1262,7 +1230,7 @@ DataElementOpen62541Leaf::writeArray<epicsUInt8>(const epicsUInt8 *value,
         UA_StatusCode status;
         { // Scope of Guard G
             Guard G(outgoingLock);
-            status = UA_Variant_setArrayCopy(&outgoingData, value, num, incomingData.type);
+            status = UA_Variant_setArrayCopy(&outgoingData, value, num, incomingType);
             markAsDirty();
         }
         if (UA_STATUS_IS_BAD(status)) {
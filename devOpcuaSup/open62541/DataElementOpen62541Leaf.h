@@ -17,6 +17,8 @@
 #include "RecordConnector.h"
 #include "Update.h"
 #include "UpdateQueue.h"
+#include "LeafConversion.h"
+#include "ArrayBufferPoolOpen62541.h"
 
 #include <errlog.h>
 #include <recGbl.h>
@@ -24,166 +26,99 @@
 #include <epicsTypes.h>
 
 #include <string>
-#include <limits>
+#include <vector>
 #include <cstdlib>
 
 namespace DevOpcua {
 
-typedef Update<UA_Variant, UA_StatusCode> UpdateOpen62541;
-
-inline const char *epicsTypeString (const epicsInt8 &) { return "epicsInt8"; }
-inline const char *epicsTypeString (const epicsUInt8 &) { return "epicsUInt8"; }
-inline const char *epicsTypeString (const epicsInt16 &) { return "epicsInt16"; }
-inline const char *epicsTypeString (const epicsUInt16 &) { return "epicsUInt16"; }
-inline const char *epicsTypeString (const epicsInt32 &) { return "epicsInt32"; }
-inline const char *epicsTypeString (const epicsUInt32 &) { return "epicsUInt32"; }
-inline const char *epicsTypeString (const epicsInt64 &) { return "epicsInt64"; }
-inline const char *epicsTypeString (const epicsUInt64 &) { return "epicsUInt64"; }
-inline const char *epicsTypeString (const epicsFloat32 &) { return "epicsFloat32"; }
-inline const char *epicsTypeString (const epicsFloat64 &) { return "epicsFloat64"; }
-inline const char *epicsTypeString (const char*) { return "epicsString"; }
-
-// Template for range check when writing
-template<typename TO, typename FROM>
-inline bool isWithinRange (const FROM &value) {
-    return !(value < std::numeric_limits<TO>::lowest() || value > std::numeric_limits<TO>::max());
-}
-
-// Specializations for unsigned to signed to avoid compiler warnings
-template<>
-inline bool isWithinRange<signed char, unsigned int> (const unsigned int &value) {
-    return !(value > static_cast<unsigned int>(std::numeric_limits<signed char>::max()));
-}
-
-template<>
-inline bool isWithinRange<short, unsigned int> (const unsigned int &value) {
-    return !(value > static_cast<unsigned int>(std::numeric_limits<short>::max()));
-}
-
-template<>
-inline bool isWithinRange<int, unsigned int> (const unsigned int &value) {
-    return !(value > static_cast<unsigned int>(std::numeric_limits<int>::max()));
-}
-
-template<>
-inline bool isWithinRange<int, unsigned long> (const unsigned long &value) {
-    return !(value > static_cast<unsigned long>(std::numeric_limits<int>::max()));
-}
-
-template<>
-inline bool isWithinRange<long, unsigned long> (const unsigned long &value) {
-    return !(value > static_cast<unsigned long>(std::numeric_limits<long>::max()));
-}
-
-template<>
-inline bool isWithinRange<long long, unsigned long> (const unsigned long &value) {
-    return !(value > std::numeric_limits<long long>::max());
-}
-
-template<>
-inline bool isWithinRange<signed char, unsigned long long> (const unsigned long long &value) {
-    return !(value > static_cast<unsigned long long>(std::numeric_limits<signed char>::max()));
-}
-
-template<>
-inline bool isWithinRange<short, unsigned long long> (const unsigned long long &value) {
-    return !(value > static_cast<unsigned long long>(std::numeric_limits<short>::max()));
-}
-
-template<>
-inline bool isWithinRange<int, unsigned long long> (const unsigned long long &value) {
-    return !(value > static_cast<unsigned long long>(std::numeric_limits<int>::max()));
-}
-
-template<>
-inline bool isWithinRange<long long, unsigned long long> (const unsigned long long &value) {
-    return !(value > static_cast<unsigned long long>(std::numeric_limits<long long>::max()));
-}
-
-// Simple-check specializations for converting signed to unsigned of same or wider type
-template<> inline bool isWithinRange<unsigned int, char> (const char &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned int, signed char> (const signed char &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned int, short> (const short &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned int, int> (const int &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long, char> (const char &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long, short> (const short &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long, int> (const int &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long, long> (const long &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long long, char> (const char &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long long, signed char> (const signed char &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long long, short> (const short &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long long, int> (const int &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long long, long> (const long &value) { return !(value < 0); }
-template<> inline bool isWithinRange<unsigned long long, long long> (const long long &value) { return !(value < 0); }
-
-// No-check-needed specializations for converting to same or wider type
-template<> inline bool isWithinRange<int, int> (const int &) { return true; }
-template<> inline bool isWithinRange<long, int> (const int &) { return true; }
-template<> inline bool isWithinRange<long long, int> (const int &) { return true; }
-template<> inline bool isWithinRange<float, int> (const int &) { return true; }
-template<> inline bool isWithinRange<double, int> (const int &) { return true; }
-
-template<> inline bool isWithinRange<unsigned int, unsigned int> (const unsigned int &) { return true; }
-template<> inline bool isWithinRange<unsigned long, unsigned int> (const unsigned int &) { return true; }
-template<> inline bool isWithinRange<long long, unsigned int> (const unsigned int &) { return true; }
-template<> inline bool isWithinRange<unsigned long long, unsigned int> (const unsigned int &) { return true; }
-template<> inline bool isWithinRange<float, unsigned int> (const unsigned int &) { return true; }
-template<> inline bool isWithinRange<double, unsigned int> (const unsigned int &) { return true; }
-
-template<> inline bool isWithinRange<long, long> (const long &) { return true; }
-template<> inline bool isWithinRange<long long, long> (const long &) { return true; }
-
-template<> inline bool isWithinRange<long long, long long> (const long long &) { return true; }
-template<> inline bool isWithinRange<float, long long> (const long long &) { return true; }
-template<> inline bool isWithinRange<double, long long> (const long long &) { return true; }
-
-template<> inline bool isWithinRange<double, double> (const double &) { return true; }
-
-// long long may or may not be the same size as long
-template<>
-inline bool isWithinRange<unsigned long, long long> (const long long &value) {
-    return sizeof(long long) > sizeof(long) ? !(value < 0 || value > static_cast<long long>(std::numeric_limits<unsigned long>::max())) : !(value < 0);
-}
-
-// Helper function to convert strings to numeric types
-
-inline bool string_to(const std::string& s, epicsInt32& value) {
-    try {
-        value = std::stol(s, 0, 0);
-        return true;
-    } catch (...) {
-        return false;
+/**
+ * @brief Access to open62541 variants for the shared conversion core.
+ *
+ * See DevOpcua::LeafConversion
+ */
+struct Open62541ConversionTraits
+{
+    typedef UA_Variant Variant;
+    typedef UA_StatusCode Status;
+    typedef UA_SByte SByte;
+    typedef UA_Byte Byte;
+    typedef UA_Int16 Int16;
+    typedef UA_UInt16 UInt16;
+    typedef UA_Int32 Int32;
+    typedef UA_UInt32 UInt32;
+    typedef UA_Int64 Int64;
+    typedef UA_UInt64 UInt64;
+    typedef UA_Float Float;
+    typedef UA_Double Double;
+
+    static ScalarKind kindOf (const UA_DataType *type)
+    {
+        switch (typeKindOf(type)) {
+        case UA_DATATYPEKIND_BOOLEAN:       return ScalarKind::boolean;
+        case UA_DATATYPEKIND_SBYTE:         return ScalarKind::sByte;
+        case UA_DATATYPEKIND_BYTE:          return ScalarKind::byte;
+        case UA_DATATYPEKIND_INT16:         return ScalarKind::int16;
+        case UA_DATATYPEKIND_UINT16:        return ScalarKind::uInt16;
+        case UA_DATATYPEKIND_INT32:         return ScalarKind::int32;
+        case UA_DATATYPEKIND_UINT32:        return ScalarKind::uInt32;
+        case UA_DATATYPEKIND_INT64:         return ScalarKind::int64;
+        case UA_DATATYPEKIND_UINT64:        return ScalarKind::uInt64;
+        case UA_DATATYPEKIND_FLOAT:         return ScalarKind::float32;
+        case UA_DATATYPEKIND_DOUBLE:        return ScalarKind::float64;
+        case UA_DATATYPEKIND_ENUM:          return ScalarKind::enumeration;
+        case UA_DATATYPEKIND_STRING:        return ScalarKind::string;
+        case UA_DATATYPEKIND_LOCALIZEDTEXT: return ScalarKind::localizedText;
+        default:                            return ScalarKind::unsupported;
+        }
     }
-}
-
-inline bool string_to(const std::string& s, epicsInt64& value) {
-    try {
-        value = std::stoll(s, 0, 0);
-        return true;
-    } catch (...) {
-        return false;
+    static ScalarKind kindOf (const UA_Variant &v) { return kindOf(v.type); }
+
+    static bool getBoolean (const UA_Variant &v) { return *static_cast<const UA_Boolean*>(v.data) != 0; }
+    template<typename T>
+    static void get (const UA_Variant &v, T &value) { value = *static_cast<const T*>(v.data); }
+    static void getText (const UA_Variant &v, const char *&str, size_t &len)
+    {
+        const UA_String *s = (typeKindOf(v) == UA_DATATYPEKIND_LOCALIZEDTEXT)
+                ? &static_cast<const UA_LocalizedText*>(v.data)->text
+                : static_cast<const UA_String*>(v.data);
+        str = reinterpret_cast<const char*>(s->data);
+        len = s->length;
     }
-}
-
-inline bool string_to(const std::string& s, epicsUInt32& value) {
-    try {
-        long long v = std::stoll(s, 0, 0);
-        if (!isWithinRange<epicsUInt32>(v)) return false;
-        value = static_cast<epicsUInt32>(v);
-        return true;
-    } catch (...) {
-        return false;
+
+    static UA_StatusCode setBoolean (UA_Variant &v, const bool value)
+    {
+        UA_Boolean val = value;
+        return UA_Variant_setScalarCopy(&v, &val, &UA_TYPES[UA_TYPES_BOOLEAN]);
     }
-}
-
-inline bool string_to(const std::string& s, epicsFloat64& value) {
-    try {
-        value = std::stod(s, 0);
-        return true;
-    } catch (...) {
-        return false;
+    static UA_StatusCode set (UA_Variant &v, const UA_SByte value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_SBYTE]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_Byte value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_BYTE]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_Int16 value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_INT16]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_UInt16 value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_UINT16]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_Int32 value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_INT32]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_UInt32 value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_UINT32]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_Int64 value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_INT64]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_UInt64 value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_UINT64]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_Float value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_FLOAT]); }
+    static UA_StatusCode set (UA_Variant &v, const UA_Double value) { return UA_Variant_setScalarCopy(&v, &value, &UA_TYPES[UA_TYPES_DOUBLE]); }
+    static UA_StatusCode setText (UA_Variant &v, const ScalarKind kind, const char *str, const size_t len,
+                                  const UA_Variant &incoming)
+    {
+        UA_String text;
+        text.length = len;
+        text.data = const_cast<UA_Byte*>(reinterpret_cast<const UA_Byte*>(str));
+        if (kind == ScalarKind::localizedText) {
+            UA_LocalizedText val;
+            val.locale = UA_STRING_NULL; // no incoming value (yet): no locale
+            if (incoming.data > UA_EMPTY_ARRAY_SENTINEL && typeKindOf(incoming) == UA_DATATYPEKIND_LOCALIZEDTEXT)
+                val.locale = static_cast<const UA_LocalizedText*>(incoming.data)->locale;
+            val.text = text;
+            return UA_Variant_setScalarCopy(&v, &val, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
+        }
+        return UA_Variant_setScalarCopy(&v, &text, &UA_TYPES[UA_TYPES_STRING]);
     }
-}
+};
+
+typedef LeafConversion<Open62541ConversionTraits> Open62541Conversion;
 
 /**
  * @brief The DataElementOpen62541 implementation of a single piece of data.
@@ -228,7 +163,7 @@ public:
     addElementToTree(ItemOpen62541 *item, RecordConnector *pconnector, const std::list<std::string> &elementPath);
 
     virtual void show(const int level, const unsigned int indent) const override;
-
+    virtual size_t memoryUsage() const override;
 
     virtual void
     setIncomingData(const UA_Variant &value, ProcessReason reason, const std::string *timefrom = nullptr) override;
@@ -669,6 +604,8 @@ private:
                       const std::string &targetTypeName) const;
     void checkWriteArray(const UA_DataType *expectedType, const std::string &targetTypeName) const;
     void dbgWriteArray(const epicsUInt32 targetSize, const std::string &targetTypeName) const;
+    bool handOffArray(void *value, const epicsUInt32 num, UA_Variant &variant);
+    void copyIncomingValue(const UA_Variant &value, UA_Variant *copy);
     bool updateDataInStruct(void* container, std::shared_ptr<DataElementOpen62541Node> pelem);
     void createMap(const UA_DataType *type, const std::string* timefrom = nullptr);
 
@@ -735,96 +672,17 @@ private:
                 } else {
                     // Valid OPC UA value, so try to convert
                     UA_Variant &data = upd->getData();
-                    switch(typeKindOf(data)) {
-                        case UA_DATATYPEKIND_BOOLEAN:
-                            *value = (*static_cast<UA_Boolean*>(data.data) != 0);
-                            ret = 0;
-                            break;
-                        case UA_DATATYPEKIND_BYTE:
-                            if (isWithinRange<ET, UA_Byte>(*static_cast<UA_Byte*>(data.data))) {
-                                *value = *static_cast<UA_Byte*>(data.data);
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_SBYTE:
-                            if (isWithinRange<ET, UA_SByte>(*static_cast<UA_SByte*>(data.data))) {
-                                *value = *static_cast<UA_SByte*>(data.data);
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_INT16:
-                            if (isWithinRange<ET, UA_Int16>(*static_cast<UA_Int16*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_Int16*>(data.data));
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_UINT16:
-                            if (isWithinRange<ET, UA_UInt16>(*static_cast<UA_UInt16*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_UInt16*>(data.data));
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_INT32:
-                            if (isWithinRange<ET, UA_Int32>(*static_cast<UA_Int32*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_Int32*>(data.data));
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_UINT32:
-                            if (isWithinRange<ET, UA_UInt32>(*static_cast<UA_UInt32*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_UInt32*>(data.data));
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_INT64:
-                            if (isWithinRange<ET, UA_Int64>(*static_cast<UA_Int64*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_Int64*>(data.data));
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_UINT64:
-                            if (isWithinRange<ET, UA_UInt64>(*static_cast<UA_UInt64*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_UInt64*>(data.data));
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_FLOAT:
-                            if (isWithinRange<ET, UA_Float>(*static_cast<UA_Float*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_Float*>(data.data));
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_DOUBLE:
-                            if (isWithinRange<ET, UA_Double>(*static_cast<UA_Double*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_Double*>(data.data));
-                                ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_ENUM:
-                            if (isWithinRange<ET, UA_Int32>(*static_cast<UA_Int32*>(data.data))) {
-                                *value = static_cast<ET>(*static_cast<UA_Int32*>(data.data));
-                                if (!enumChoices || enumChoices->find(static_cast<UA_UInt32>(*value)) != enumChoices->end())
-                                    ret = 0;
-                            }
-                            break;
-                        case UA_DATATYPEKIND_STRING:
-                        {
-                            UA_String* s = static_cast<UA_String*>(data.data);
-                            if (string_to(std::string(reinterpret_cast<const char*>(s->data), s->length), *value))
-                                ret = 0;
-                            break;
-                        }
-                        case UA_DATATYPEKIND_LOCALIZEDTEXT:
-                        {
-                            UA_LocalizedText* lt = static_cast<UA_LocalizedText*>(data.data);
-                            if (string_to(std::string(reinterpret_cast<const char*>(lt->text.data), lt->text.length), *value))
-                                ret = 0;
-                            break;
-                        }
-                        default:
-                            errlogPrintf("%s : unsupported type kind %s for incoming data\n",
-                                         prec->name, typeKindName(typeKindOf(data)));
-                            (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+                    switch (Open62541Conversion::toEpics(data, *value, enumChoices)) {
+                    case ConversionResult::ok:
+                        ret = 0;
+                        break;
+                    case ConversionResult::unsupported:
+                        errlogPrintf("%s : unsupported type kind %s for incoming data\n",
+                                     prec->name, typeKindName(typeKindOf(data)));
+                        (void) recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+                        break;
+                    default:
+                        break;
                     }
                     if (ret == 1) {
                         UA_String datastring = UA_STRING_NULL;
@@ -921,8 +779,10 @@ private:
                         if (UA_STATUS_IS_UNCERTAIN(stat)) {
                             (void) recGblSetSevr(prec, READ_ALARM, MINOR_ALARM);
                         }
-                        elemsWritten = static_cast<epicsUInt32>(num) < variant.arrayLength ? num : static_cast<epicsUInt32>(variant.arrayLength);
-                        memcpy(value, variant.data, sizeof(ET) * elemsWritten);
+                        if (handOffArray(value, num, variant))
+                            elemsWritten = num;
+                        else
+                            elemsWritten = Open62541Conversion::copyArray(value, num, variant.data, variant.arrayLength);
                     }
                     UA_Variant_clear(&variant);
                 }
@@ -969,125 +829,19 @@ private:
         { // Scope of Guard G
             Guard G(outgoingLock);
             UA_Variant_clear(&outgoingData); // unlikely but we may still have unsent old data to discard
-            switch (typeKindOf(incomingData)) {
-            case UA_DATATYPEKIND_BOOLEAN:
-            {
-                UA_Boolean val = (value != 0);
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_BOOLEAN]);
+            switch (Open62541Conversion::fromEpics(value, Open62541ConversionTraits::kindOf(incomingType),
+                                                   incomingData, outgoingData, enumChoices, status)) {
+            case ConversionResult::ok:
                 markAsDirty();
                 ret = 0;
                 break;
-            }
-            case UA_DATATYPEKIND_BYTE:
-                if (isWithinRange<UA_Byte>(value)) {
-                    UA_Byte val = static_cast<UA_Byte>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_BYTE]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_SBYTE:
-                if (isWithinRange<UA_SByte>(value)) {
-                    UA_SByte val = static_cast<UA_Byte>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_SBYTE]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_UINT16:
-                if (isWithinRange<UA_UInt16>(value)) {
-                    UA_UInt16 val = static_cast<UA_UInt16>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_UINT16]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_INT16:
-                if (isWithinRange<UA_Int16>(value)) {
-                    UA_Int16 val = static_cast<UA_Int16>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_INT16]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_UINT32:
-                if (isWithinRange<UA_UInt32>(value)) {
-                    UA_UInt32 val = static_cast<UA_UInt32>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_UINT32]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_ENUM:
-            case UA_DATATYPEKIND_INT32:
-                if (isWithinRange<UA_Int32>(value) &&
-                    (!enumChoices ||
-                        enumChoices->find(static_cast<UA_UInt32>(value)) != enumChoices->end())) {
-                    UA_Int32 val = static_cast<UA_Int32>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_INT32]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_UINT64:
-                if (isWithinRange<UA_UInt64>(value)) {
-                    UA_UInt64 val = static_cast<UA_UInt64>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_UINT64]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_INT64:
-                if (isWithinRange<UA_Int64>(value)) {
-                    UA_Int64 val = static_cast<UA_Int64>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_INT64]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_FLOAT:
-                if (isWithinRange<UA_Float>(value)) {
-                    UA_Float val = static_cast<UA_Float>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_FLOAT]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_DOUBLE:
-                if (isWithinRange<UA_Double>(value)) {
-                    UA_Double val = static_cast<UA_Double>(value);
-                    status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_DOUBLE]);
-                    markAsDirty();
-                    ret = 0;
-                }
-                break;
-            case UA_DATATYPEKIND_STRING:
-            {
-                std::string strval = std::to_string(value);
-                UA_String val;
-                val.length = strval.length();
-                val.data = const_cast<UA_Byte*>(reinterpret_cast<const UA_Byte*>(strval.c_str()));
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_STRING]);
-                markAsDirty();
-                ret = 0;
-                break;
-            }
-            case UA_DATATYPEKIND_LOCALIZEDTEXT:
-            {
-                std::string strval = std::to_string(value);
-                UA_LocalizedText val;
-                val.locale = reinterpret_cast<const UA_LocalizedText*>(incomingData.data)->locale;
-                val.text.length = strval.length();
-                val.text.data = const_cast<UA_Byte*>(reinterpret_cast<const UA_Byte*>(strval.c_str()));
-                status = UA_Variant_setScalarCopy(&outgoingData, &val, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
-                markAsDirty();
-                ret = 0;
-                break;
-            }
-            default:
+            case ConversionResult::unsupported:
                 errlogPrintf("%s : unsupported conversion from %s to %s for outgoing data\n",
-                             prec->name, epicsTypeString(value), variantTypeString(incomingData));
+                             prec->name, epicsTypeString(value), variantTypeString(incomingType));
                 (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
+                break;
+            default:
+                break;
             }
         }
         if (ret != 0) {
@@ -1125,14 +879,14 @@ private:
     {
         long ret = 0;
 
-        if (UA_Variant_isScalar(&incomingData)) {
+        if (incomingScalar) {
             errlogPrintf("%s : OPC UA data type is not an array\n", prec->name);
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
             ret = 1;
-        } else if (incomingData.type != targetType) {
+        } else if (incomingType != targetType) {
             errlogPrintf("%s : OPC UA data type (%s) does not match expected type (%s) for EPICS array (%s)\n",
                          prec->name,
-                         variantTypeString(incomingData),
+                         variantTypeString(incomingType),
                          variantTypeString(targetType),
                          epicsTypeString(*value));
             (void) recGblSetSevr(prec, WRITE_ALARM, INVALID_ALARM);
@@ -1157,7 +911,10 @@ private:
         return ret;
     }
 
+    const UA_DataType *incomingType = nullptr;   /**< data type of the latest incoming value */
+    bool incomingScalar = false;                 /**< latest incoming value is a scalar */
     UpdateQueue<UpdateOpen62541> incomingQueue;  /**< queue of incoming values */
+    ArrayBufferPoolOpen62541 bufferPool;         /**< array buffers handed back by the record (zero-copy mode) */
 };
 
 } // namespace DevOpcua
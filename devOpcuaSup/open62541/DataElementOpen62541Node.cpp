@@ -210,6 +210,17 @@ DataElementOpen62541Node::show (const int level, const unsigned int indent) cons
     }
 }
 
+size_t
+DataElementOpen62541Node::memoryUsage () const
+{
+    size_t bytes = variantMemoryUsage(incomingData) + variantMemoryUsage(outgoingData);
+    for (const auto &it : elements) {
+        if (auto pelem = it.lock())
+            bytes += pelem->memoryUsage();
+    }
+    return bytes;
+}
+
 // Getting the timestamp and status information from the Item assumes that only one thread
 // is pushing data into the Item's DataElement structure at any time.
 void
@@ -29,17 +29,19 @@ public:
     virtual void addChild(std::weak_ptr<DataElementOpen62541> elem) override
     {
         elements.push_back(elem);
+        if (auto pelem = elem.lock())
+            elementIndex.emplace(pelem->name, elem); // a duplicate name finds the first child
     }
     virtual std::shared_ptr<DataElementOpen62541> findChild(const std::string &name) const override
     {
-        for (const auto &it : elements)
-            if (auto pit = it.lock())
-                if (pit->name == name)
-                    return pit;
+        auto it = elementIndex.find(name);
+        if (it != elementIndex.end())
+            return it->second.lock();
         return std::shared_ptr<DataElementOpen62541>();
     }
 
     virtual void show(const int level, const unsigned int indent) const override;
+    virtual size_t memoryUsage() const override;
 
     virtual void setIncomingData(const UA_Variant &value,
                          ProcessReason reason,
@@ -58,6 +60,7 @@ private:
     void createMap(const UA_DataType *type, const std::string* timefrom = nullptr);
 
     std::vector<std::weak_ptr<DataElementOpen62541>> elements;  /**< children (if node) */
+    std::unordered_map<std::string, std::weak_ptr<DataElementOpen62541>> elementIndex; /**< children by name */
     std::unordered_map<int, std::weak_ptr<DataElementOpen62541>> elementMap;
     ptrdiff_t timesrc;
     bool mapped;                             /**< child name to index mapping done */
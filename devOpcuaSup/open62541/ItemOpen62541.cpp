@@ -16,6 +16,7 @@
 #include "SubscriptionOpen62541.h"
 #include "SessionOpen62541.h"
 #include "DataElementOpen62541.h"
+#include "CacheFile.h"
 
 #include <errlog.h>
 #include <epicsTypes.h>
@@ -24,6 +25,7 @@
 #include <open62541/client.h>
 
 #include <string>
+#include <cstring>
 #include <iostream>
 
 namespace DevOpcua {
@@ -40,6 +42,9 @@ ItemOpen62541::ItemOpen62541(const linkInfo &info)
     , subscription(nullptr)
     , session(nullptr)
     , registered(false)
+    , registrationSaving(0)
+    , sourceTimeNeeded(false)
+    , serverTimeNeeded(false)
     , revisedSamplingInterval(0.0)
     , revisedQueueSize(0)
     , dataTreeDirty(false)
@@ -47,8 +52,17 @@ ItemOpen62541::ItemOpen62541(const linkInfo &info)
     , dataTreeNoOfLeafs(0)
     , lastStatus(UA_STATUSCODE_BADSERVERNOTCONNECTED)
     , lastReason(ProcessReason::connectionLoss)
+    , warmStarted(false)
 {
     UA_NodeId_init(&nodeId);
+    UA_DataValue_init(&lastValue);
+    monitoring.samplingInterval = linkinfo.samplingInterval;
+    monitoring.queueSize = linkinfo.queueSize;
+    monitoring.discardOldest = linkinfo.discardOldest;
+    monitoring.deadband = linkinfo.deadband;
+    monitoring.trigger = linkinfo.trigger;
+    // The timestamp option of the item's own link (opcuaItem record) counts as well
+    addTimestampNeed(linkinfo.timestamp);
     if (linkinfo.subscription != "" && linkinfo.monitor) {
         subscription = SubscriptionOpen62541::find(linkinfo.subscription);
         subscription->addItemOpen62541(this);
@@ -64,6 +78,7 @@ ItemOpen62541::~ItemOpen62541 ()
     subscription->removeItemOpen62541(this);
     session->removeItemOpen62541(this);
     UA_NodeId_clear(&nodeId);
+    UA_DataValue_clear(&lastValue);
 }
 
 void
@@ -71,12 +86,25 @@ ItemOpen62541::rebuildNodeId ()
 {
     UA_UInt16 ns = session->mapNamespaceIndex(linkinfo.namespaceIndex);
     UA_NodeId_clear(&nodeId);
-    if (linkinfo.identifierIsNumeric) {
+    if (linkinfo.browsePath.size()) {
+        session->getBrowsePathTarget(linkinfo, nodeId); // stays null if not resolved
+    } else if (linkinfo.identifierIsNumeric) {
         nodeId = UA_NODEID_NUMERIC(ns, linkinfo.identifierNumber);
     } else {
         nodeId = UA_NODEID_STRING_ALLOC(ns, linkinfo.identifierString.c_str());
     }
     registered = false;
+    registrationSaving = 0;
+}
+
+void
+ItemOpen62541::setRegisteredNodeId (const UA_NodeId &id)
+{
+    registrationSaving = static_cast<long>(UA_calcSizeBinary(&nodeId, &UA_TYPES[UA_TYPES_NODEID]))
+                       - static_cast<long>(UA_calcSizeBinary(&id, &UA_TYPES[UA_TYPES_NODEID]));
+    UA_NodeId_clear(&nodeId);
+    UA_NodeId_copy(&id, &nodeId);
+    registered = true;
 }
 
 void
@@ -100,19 +128,25 @@ ItemOpen62541::show (int level) const
         std::cout << ";i=" << linkinfo.identifierNumber;
     else
         std::cout << ";s=" << linkinfo.identifierString;
+    if (linkinfo.browsePath.size())
+        std::cout << " path=" << linkinfo.browsePathString
+                  << "(" << nodeId << ")";
     std::cout << " record=" << recConnector->getRecordName()
               << " state=" << connectionStatusString(recConnector->state())
               << " status=" << UA_StatusCode_name(lastStatus)
               << " dataDirty=" << (dataTreeDirty ? "y" : "n")
               << " context=" << linkinfo.subscription << "@" << session->getName()
-              << " sampling=" << revisedSamplingInterval << "(" << linkinfo.samplingInterval << ")"
-              << " deadband=" << linkinfo.deadband
-              << " qsize=" << revisedQueueSize << "(" << linkinfo.queueSize << ")"
+              << " sampling=" << revisedSamplingInterval << "(" << monitoring.samplingInterval << ")"
+              << " deadband=" << monitoring.deadband
+              << " qsize=" << revisedQueueSize << "(" << monitoring.queueSize << ")"
               << " cqsize=" << linkinfo.clientQueueSize
-              << " discard=" << (linkinfo.discardOldest ? "old" : "new")
+              << " discard=" << (monitoring.discardOldest ? "old" : "new")
+              << " trigger=" << (monitoring.trigger.length() ? monitoring.trigger : "-")
               << " timestamp=" << linkOptionTimestampString(linkinfo.timestamp);
     if (linkinfo.timestamp == LinkOptionTimestamp::data)
         std::cout << "@" << linkinfo.timestampElement;
+    if (linkinfo.maxAge > 0.0)
+        std::cout << " maxage=" << linkinfo.maxAge;
     std::cout << " bini=" << linkOptionBiniString(linkinfo.bini)
               << " output=" << (linkinfo.isOutput ? "y" : "n")
               << " monitor=" << (linkinfo.monitor ? "y" : "n")
@@ -124,6 +158,8 @@ ItemOpen62541::show (int level) const
     std::cout << "(" << (linkinfo.registerNode ? "y" : "n") << ")";
     if (!(dataTreeNoOfNodes == 0 && dataTreeNoOfLeafs == 1))
         std::cout << " dataNodes=" << dataTreeNoOfNodes << " dataLeafs=" << dataTreeNoOfLeafs;
+    if (auto re = dataTree.root().lock())
+        std::cout << " memory=" << re->memoryUsage();
     std::cout << std::endl;
 
     if (level >= 1) {
@@ -159,13 +195,202 @@ ItemOpen62541::uaToEpicsTime (const UA_DateTime &dt, const UA_UInt16 pico10)
     return epicsTime(ts);
 }
 
+// Values that can be kept in the warm-start file:
+// built-in types without pointers, strings and byte strings
+bool
+ItemOpen62541::isWarmStartType (const UA_DataType *type)
+{
+    return type >= &UA_TYPES[0] && type < &UA_TYPES[UA_TYPES_COUNT]
+            && (type->pointerFree
+                || type == &UA_TYPES[UA_TYPES_STRING]
+                || type == &UA_TYPES[UA_TYPES_BYTESTRING]);
+}
+
+const size_t ItemOpen62541::warmStartMaxBytes = 65536;
+
+size_t
+ItemOpen62541::warmStartBytes (const UA_Variant &value, const UA_DataType *type)
+{
+    const size_t len = UA_Variant_isScalar(&value) ? 1 : value.arrayLength;
+    size_t bytes = len * type->memSize;
+    if (!type->pointerFree && value.data > UA_EMPTY_ARRAY_SENTINEL) {
+        const UA_String *str = static_cast<const UA_String *>(value.data);
+        for (size_t i = 0; i < len; i++)
+            bytes += str[i].length;
+    }
+    return bytes;
+}
+
+// Warm-start entry: <type index> <scalar> <length> <status>
+// <source time> <source ps> <server time> <server ps> <data tokens>
+// (pointer free data as one token, strings as one token per element)
+void
+ItemOpen62541::writeWarmStartValue (std::ostream &os, const UA_DataValue &value)
+{
+    const UA_DataType *type = value.value.type;
+    const bool scalar = UA_Variant_isScalar(&value.value);
+    const size_t len = scalar ? 1 : value.value.arrayLength;
+    os << ' ' << (type - UA_TYPES)
+       << ' ' << (scalar ? 1 : 0)
+       << ' ' << len
+       << ' ' << value.status
+       << ' ' << (value.hasSourceTimestamp ? value.sourceTimestamp : 0)
+       << ' ' << (value.hasSourcePicoseconds ? value.sourcePicoseconds : 0)
+       << ' ' << (value.hasServerTimestamp ? value.serverTimestamp : 0)
+       << ' ' << (value.hasServerPicoseconds ? value.serverPicoseconds : 0);
+    if (type->pointerFree) {
+        writeToken(os, std::string(static_cast<const char *>(value.value.data), type->memSize * len));
+    } else {
+        const UA_String *str = static_cast<const UA_String *>(value.value.data);
+        for (size_t i = 0; i < len; i++)
+            writeToken(os, std::string(reinterpret_cast<const char *>(str[i].data), str[i].length));
+    }
+}
+
+bool
+ItemOpen62541::readWarmStartValue (std::istream &is, UA_DataValue &value)
+{
+    size_t typeIndex, len;
+    unsigned int scalar, sourcePico, serverPico;
+    UA_DataValue v;
+    UA_DataValue_init(&v);
+    if (!(is >> typeIndex >> scalar >> len >> v.status
+          >> v.sourceTimestamp >> sourcePico >> v.serverTimestamp >> serverPico)
+        || typeIndex >= UA_TYPES_COUNT || !isWarmStartType(&UA_TYPES[typeIndex])
+        || (scalar && len != 1))
+        return false;
+    const UA_DataType *type = &UA_TYPES[typeIndex];
+
+    bool ok = true;
+    void *data = UA_Array_new(len, type);
+    if (len && !data)
+        return false;
+    if (type->pointerFree) {
+        std::string bytes;
+        ok = readToken(is, bytes) && bytes.size() == type->memSize * len;
+        if (ok)
+            memcpy(data, bytes.data(), bytes.size());
+    } else {
+        UA_String *str = static_cast<UA_String *>(data);
+        std::string token;
+        for (size_t i = 0; ok && i < len; i++) {
+            ok = readToken(is, token);
+            if (ok && token.size())
+                ok = UA_ByteString_allocBuffer(&str[i], token.size()) == UA_STATUSCODE_GOOD;
+            if (ok)
+                memcpy(str[i].data, token.data(), token.size());
+        }
+    }
+    if (!ok) {
+        UA_Array_delete(data, len, type);
+        return false;
+    }
+    if (scalar)
+        UA_Variant_setScalar(&v.value, data, type);
+    else
+        UA_Variant_setArray(&v.value, data, len, type);
+    v.hasValue = true;
+    v.hasStatus = true;
+    v.hasSourceTimestamp = v.sourceTimestamp != 0;
+    v.sourcePicoseconds = static_cast<UA_UInt16>(sourcePico);
+    v.hasSourcePicoseconds = sourcePico != 0;
+    v.hasServerTimestamp = v.serverTimestamp != 0;
+    v.serverPicoseconds = static_cast<UA_UInt16>(serverPico);
+    v.hasServerPicoseconds = serverPico != 0;
+    value = v;
+    return true;
+}
+
+void
+ItemOpen62541::keepLastValue (const UA_DataValue &value)
+{
+    const UA_DataType *type = value.value.type;
+    if (typeKindOf(type) == UA_DATATYPEKIND_ENUM)
+        type = &UA_TYPES[UA_TYPES_INT32]; // enums are kept as their integer value
+    if (UA_STATUS_IS_BAD(value.status) || !isWarmStartType(type)) {
+        // A referenced value is about to be replaced in the root element: keep a copy
+        Guard G(lastValueLock);
+        if (lastValue.hasValue && lastValue.value.storageType == UA_VARIANT_DATA_NODELETE) {
+            UA_DataValue kept;
+            UA_DataValue_copy(&lastValue, &kept);
+            lastValue = kept;
+        }
+        return;
+    }
+    const bool scalar = UA_Variant_isScalar(&value.value);
+    const size_t bytes = warmStartBytes(value.value, type);
+
+    Guard G(lastValueLock);
+    if (warmStarted && lastValue.value.type != type)
+        errlogPrintf("OPC UA session %s: record %s data type changed from %s to %s since warm start\n",
+                     session->getName().c_str(), recConnector->getRecordName(),
+                     lastValue.value.type->typeName, type->typeName);
+    warmStarted = false;
+    if (bytes > warmStartMaxBytes) {
+        UA_DataValue_clear(&lastValue); // don't write an outdated value
+        return;
+    }
+    if (lastValue.hasValue && type->pointerFree && lastValue.value.type == type
+            && UA_Variant_isScalar(&lastValue.value) == scalar
+            && (scalar || lastValue.value.arrayLength == value.value.arrayLength)
+            && lastValue.value.data > UA_EMPTY_ARRAY_SENTINEL) {
+        // Same layout as the kept value: overwrite in place, no allocation
+        UA_Variant kept = lastValue.value;
+        memcpy(kept.data, value.value.data, bytes);
+        lastValue = value; // status and time stamps (the variant is the only member owning data)
+        lastValue.value = kept;
+        return;
+    }
+    UA_DataValue_clear(&lastValue);
+    if (!type->pointerFree && !dataTree.root().expired()) {
+        // Strings are not copied on every update: reference the data owned by the root
+        // element (it is replaced under the client lock), it's copied when saving
+        lastValue = value;
+        lastValue.value.storageType = UA_VARIANT_DATA_NODELETE;
+    } else {
+        UA_DataValue_copy(&value, &lastValue);
+    }
+    lastValue.value.type = type;
+}
+
+bool
+ItemOpen62541::copyLastValue (UA_DataValue &value) const
+{
+    Guard G(lastValueLock);
+    if (!lastValue.hasValue)
+        return false;
+    return UA_DataValue_copy(&lastValue, &value) == UA_STATUSCODE_GOOD;
+}
+
+void
+ItemOpen62541::setWarmStartData (UA_DataValue &value)
+{
+    UA_DataValue stored;
+    UA_DataValue_copy(&value, &stored);
+
+    // Deliver to the records like a monitored update, marked as stale
+    value.status = UA_STATUSCODE_UNCERTAINLASTUSABLEVALUE;
+    value.hasStatus = true;
+    setState(ConnectionStatus::up);
+    setIncomingData(value, ProcessReason::incomingData);
+    setState(ConnectionStatus::down);
+
+    Guard G(lastValueLock);
+    UA_DataValue_clear(&lastValue);
+    lastValue = stored;
+    warmStarted = true;
+}
+
 void
 ItemOpen62541::setIncomingData(UA_DataValue &value, ProcessReason reason)
 {
     tsClient = epicsTime::getCurrent();
+    if (session->warmStartEnabled())
+        keepLastValue(value);
     if (!UA_STATUS_IS_BAD(value.status)) {
-        tsSource = uaToEpicsTime(value.sourceTimestamp, value.sourcePicoseconds);
-        tsServer = uaToEpicsTime(value.serverTimestamp, value.serverPicoseconds);
+        // Only convert the timestamps that the records use (the others are not requested)
+        tsSource = sourceTimeNeeded ? uaToEpicsTime(value.sourceTimestamp, value.sourcePicoseconds) : tsClient;
+        tsServer = serverTimeNeeded ? uaToEpicsTime(value.serverTimestamp, value.serverPicoseconds) : tsClient;
     } else {
         tsSource = tsClient;
         tsServer = tsClient;
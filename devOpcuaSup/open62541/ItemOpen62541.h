@@ -19,12 +19,38 @@
 
 #include <open62541/client.h>
 
+#include <istream>
+#include <ostream>
+
 namespace DevOpcua {
 
 class SubscriptionOpen62541;
 class DataElementOpen62541;
 class DataElementOpen62541Node;
 
+/**
+ * @brief Requested parameters of a monitored item.
+ *
+ * Initialized from the link, may be changed at runtime.
+ */
+struct MonitoringParameters
+{
+    double samplingInterval;      /**< requested sampling interval [ms] */
+    UA_UInt32 queueSize;          /**< requested server-side queue size */
+    bool discardOldest;           /**< discard policy of the server-side queue */
+    double deadband;              /**< absolute deadband (0 = none) */
+    std::string trigger;          /**< record of the triggering item (empty = none) */
+
+    bool operator==(const MonitoringParameters &other) const
+    {
+        return samplingInterval == other.samplingInterval
+                && queueSize == other.queueSize
+                && discardOldest == other.discardOldest
+                && deadband == other.deadband
+                && trigger == other.trigger;
+    }
+};
+
 /**
  * @brief The ItemOpen62541 inplementation of an OPC UA item.
  *
@@ -97,10 +123,60 @@ public:
     bool isRegistered() const { return registered; }
 
     /**
-     * @brief Setter for the node id of this item.
-     * @return node id
+     * @brief Setter for the registered node id of this item.
+     *
+     * Also calculates the number of bytes that the registered node id
+     * saves in every request that references this item.
+     *
+     * @param id  node id returned by the RegisterNodes service
+     */
+    void setRegisteredNodeId(const UA_NodeId &id);
+
+    /**
+     * @brief Getter for the number of bytes saved per reference by registration.
+     * @return encoded size of the original minus the registered node id
      */
-    void setRegisteredNodeId(const UA_NodeId &id) { UA_NodeId_copy(&id, &nodeId); registered = true; }
+    long getRegistrationSaving() const { return registrationSaving; }
+
+    /**
+     * @brief Register the timestamp that a record linked to this item uses.
+     *
+     * Data timestamps fall back to the source timestamp.
+     *
+     * @param timestamp  timestamp link option of the record
+     */
+    void addTimestampNeed(const LinkOptionTimestamp timestamp)
+    {
+        if (timestamp == LinkOptionTimestamp::server)
+            serverTimeNeeded = true;
+        else
+            sourceTimeNeeded = true;
+    }
+
+    /**
+     * @brief Check if the item's records use the source timestamp.
+     * @return true if the source timestamp is needed
+     */
+    bool needsSourceTime() const { return sourceTimeNeeded; }
+
+    /**
+     * @brief Check if the item's records use the server timestamp.
+     * @return true if the server timestamp is needed
+     */
+    bool needsServerTime() const { return serverTimeNeeded; }
+
+    /**
+     * @brief Get the TimestampsToReturn setting for a set of needed timestamps.
+     *
+     * @param source  source timestamp needed
+     * @param server  server timestamp needed
+     * @return timestamps to request
+     */
+    static UA_TimestampsToReturn timestampsToReturn(const bool source, const bool server)
+    {
+        return source ? (server ? UA_TIMESTAMPSTORETURN_BOTH : UA_TIMESTAMPSTORETURN_SOURCE)
+                      : (server ? UA_TIMESTAMPSTORETURN_SERVER : UA_TIMESTAMPSTORETURN_NEITHER);
+    }
 
     /**
      * @brief Getter that returns the node id of this item.
@@ -108,6 +184,12 @@ public:
      */
     const UA_NodeId &getNodeId() const { return nodeId; }
 
+    /**
+     * @brief Check if the item's browse path has no target (yet).
+     * @return true if the item is addressed by a browse path that is not resolved
+     */
+    bool isUnresolved() const { return linkinfo.browsePath.size() && UA_NodeId_isNull(&nodeId); }
+
     /**
      * @brief Setter for the status of a read operation.
      * @param status  status code received by the client library
@@ -162,6 +244,65 @@ public:
      */
     void setIncomingData(UA_DataValue &value, ProcessReason reason);
 
+    /**
+     * @brief Copy out the last value kept for the warm-start file.
+     *
+     * String values reference the root element's data: the caller must
+     * hold the session's client lock.
+     *
+     * @param[out] value  target of copy
+     * @return true if a value was copied
+     */
+    bool copyLastValue(UA_DataValue &value) const;
+
+    /**
+     * @brief Push a value from the warm-start file down the root element.
+     *
+     * Called once at IOC start, before the session connects.
+     * The records get the value with status UncertainLastUsableValue.
+     *
+     * @param value  value read from the warm-start file
+     */
+    void setWarmStartData(UA_DataValue &value);
+
+    /**
+     * @brief Check if values of a data type can be kept in the warm-start file.
+     * @param type  data type
+     * @return true if supported
+     */
+    static bool isWarmStartType(const UA_DataType *type);
+
+    /**
+     * @brief Size of a value in the warm-start file, including the string payloads.
+     * @param value  value
+     * @param type  data type of the value (enums as Int32)
+     * @return number of bytes
+     */
+    static size_t warmStartBytes(const UA_Variant &value, const UA_DataType *type);
+
+    /**
+     * @brief Max size of a value kept for the warm-start file [bytes].
+     *
+     * Larger values are not kept (copying them costs more than reading
+     * them again after a restart).
+     */
+    static const size_t warmStartMaxBytes;
+
+    /**
+     * @brief Write the data type, status, time stamps and value of a warm-start entry.
+     * @param os  output stream
+     * @param value  value (of a supported data type, enums as Int32)
+     */
+    static void writeWarmStartValue(std::ostream &os, const UA_DataValue &value);
+
+    /**
+     * @brief Read a warm-start entry written by writeWarmStartValue.
+     * @param is  input stream
+     * @param[out] value  value read (owned by the caller, untouched on error)
+     * @return true if a complete value of a supported data type was read
+     */
+    static bool readWarmStartValue(std::istream &is, UA_DataValue &value);
+
     /**
      * @brief Push an incoming event down the root element.
      *
@@ -177,6 +318,21 @@ public:
      */
     void markAsDirty();
 
+    /**
+     * @brief Getter for the requested monitoring parameters.
+     * @return monitoring parameters
+     */
+    const MonitoringParameters &getMonitoring() const { return monitoring; }
+
+    /**
+     * @brief Setter for the requested monitoring parameters.
+     *
+     * Takes effect when the monitored item is created or modified.
+     *
+     * @param params  monitoring parameters
+     */
+    void setMonitoring(const MonitoringParameters &params) { monitoring = params; }
+
    /**
      * @brief Setter for the revised sampling interval.
      * @param status  status code received by the client library
@@ -210,6 +366,10 @@ private:
     SessionOpen62541 *session;             /**< raw pointer to session */
     UA_NodeId nodeId;                      /**< node id of this item */
     bool registered;                       /**< flag for registration status */
+    long registrationSaving;               /**< bytes saved per reference by registration */
+    bool sourceTimeNeeded;                 /**< a record uses the source (or data) timestamp */
+    bool serverTimeNeeded;                 /**< a record uses the server timestamp */
+    MonitoringParameters monitoring;       /**< requested monitoring parameters */
     UA_Double revisedSamplingInterval;     /**< server-revised sampling interval */
     UA_UInt32 revisedQueueSize;            /**< server-revised queue size */
     ElementTree<DataElementOpen62541Node, DataElementOpen62541, ItemOpen62541> dataTree; /**< data element tree */
@@ -223,6 +383,11 @@ private:
     epicsTime tsServer;                    /**< server time stamp */
     epicsTime tsSource;                    /**< source time stamp */
     epicsTime tsData;                      /**< data time stamp */
+    UA_DataValue lastValue;                /**< last value (kept for the warm-start file) */
+    mutable epicsMutex lastValueLock;      /**< lock for lastValue */
+    bool warmStarted;                      /**< lastValue was read from the warm-start file */
+
+    void keepLastValue(const UA_DataValue &value);
 };
 
 inline std::ostream& operator << (std::ostream& os, const ItemOpen62541& item)
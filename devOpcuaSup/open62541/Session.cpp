@@ -30,12 +30,20 @@ namespace DevOpcua {
 
 epicsThreadOnceId Session::onceId = EPICS_THREAD_ONCE_INIT;
 epicsTimerQueueActive *Session::queue = nullptr;
+epicsMutex Session::reconnectLock;
+TokenBucket Session::reconnectBucket;
+unsigned int Session::reconnectSeed = 0;
+unsigned long Session::reconnectAttempts = 0;
+unsigned long Session::reconnectsDelayed = 0;
 
 RegistryKeyNamespace RegistryKeyNamespace::global;
 
 void Session::initOnce(void *)
 {
     queue = &epicsTimerQueueActive::allocate(true);
+    // different jitter sequences for IOCs started at the same time
+    epicsTimeStamp now = epicsTime::getCurrent();
+    reconnectSeed = now.nsec ^ (now.secPastEpoch * 2654435761u);
 }
 
 static bool
@@ -163,13 +171,20 @@ const char Session::optionUsage[]
       "Valid session options are:\n"
       "debug              debug level [default 0 = no debug]\n"
       "autoconnect        automatically connect sessions [default y]\n"
+      "register-nodes     items to register (link = register=y links, auto) [default link]\n"
+      "warm-start         file to keep the last values of all items in [default off]\n"
+      "warm-start-period  period for writing the warm-start file [s; 0 = at exit only]\n"
+      "lazy-types         resolve only the custom data types used by items [default n]\n"
+      "type-cache         directory to cache custom type definitions in [default off]\n"
       "nodes-max          max. nodes per service call [0 = no limit]\n"
       "read-nodes-max     max. nodes per read service call [0 = no limit]\n"
+      "read-prepared      max. read requests prepared for recurring batches [0 = off]\n"
       "read-timeout-min   min. timeout (holdoff) after read service call [ms]\n"
       "read-timeout-max   timeout (holdoff) after read service call w/ max elements [ms]\n"
       "write-nodes-max    max. nodes per write service call [0 = no limit]\n"
       "write-timeout-min  min. timeout (holdoff) after write service call [ms]\n"
       "write-timeout-max  timeout (holdoff) after write service call w/ max elements [ms]\n"
+      "writegroup-timeout max. time staged writes wait for a commit [s; 0 = forever]\n"
       "sec-mode           requested security mode\n"
       "sec-policy         requested security policy\n"
       "ident-file         file to read identity credentials from\n\n"
@@ -16,6 +16,8 @@
 #include "SubscriptionOpen62541.h"
 #include "DataElementOpen62541.h"
 #include "linkParser.h"
+#include "RecordConnector.h"
+#include "CacheFile.h"
 
 #ifdef HAS_XMLPARSER
 #include <libxml/parser.h>
@@ -24,6 +26,9 @@
 #else
 #define readCustomTypeDictionaries()
 #define clearCustomTypeDictionaries()
+#define resolveItemTypes()
+#define installCustomTypes()
+#define uninstallCustomTypes()
 #endif
 
 #include <epicsExit.h>
@@ -44,10 +49,12 @@
 #include <iomanip>
 #include <string>
 #include <map>
+#include <fstream>
+#include <sstream>
 #include <algorithm>
-#include <functional>
 #include <utility>
 #include <cstdio>
+#include <cstring>
 
 /* loadFile helper from open62541 examples */
 
@@ -242,6 +249,36 @@ to_string (const UA_String& ua_string)
     return std::string(reinterpret_cast<const char*>(ua_string.data), ua_string.length);
 }
 
+// FNV-1a hash (fingerprints of server state)
+static UA_UInt64
+fnv1a (UA_UInt64 hash, const void *data, size_t len)
+{
+    const UA_Byte *p = static_cast<const UA_Byte *>(data);
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static UA_UInt64
+fnv1a (UA_UInt64 hash, const UA_String &str)
+{
+    hash = fnv1a(hash, str.data, str.length);
+    return fnv1a(hash, "", 1); // separator
+}
+
+// Library version and data type layout that the cache files depend on
+static std::string
+cacheLibraryTag ()
+{
+    return SB() << UA_OPEN62541_VER_MAJOR << '.' << UA_OPEN62541_VER_MINOR << '.' << UA_OPEN62541_VER_PATCH
+#ifdef UA_DATATYPES_USE_POINTER
+                << "-p"
+#endif
+                << '-' << UA_TYPES_COUNT;
+}
+
 const char* typeKindName(int typeKind)
 {
     static const char* typeKindNames[] = {
@@ -288,16 +325,21 @@ static epicsThreadOnceId session_open62541_ihooks_once = EPICS_THREAD_ONCE_INIT;
 static epicsThreadOnceId session_open62541_atexit_once = EPICS_THREAD_ONCE_INIT;
 
 Registry<SessionOpen62541> SessionOpen62541::sessions;
+epicsMutex SessionOpen62541::startupLock;
+epicsEvent SessionOpen62541::startupDone;
+unsigned int SessionOpen62541::startupPending = 0;
 
 // Cargo structure and batcher for write requests
 struct WriteRequest {
     ItemOpen62541 *item;
     UA_WriteValue wvalue;
+    std::vector<std::shared_ptr<WriteRequest>> group; // staged writes of a write group (sent before this one)
 };
 
 // Cargo structure and batcher for read requests
 struct ReadRequest {
     ItemOpen62541 *item;
+    std::vector<ItemOpen62541 *> group; // members of a read group (read in a request of their own)
 };
 
 static
@@ -329,6 +371,13 @@ SessionOpen62541::SessionOpen62541 (const std::string &name,
     : Session(name)
     , serverURL(serverUrl)
     , registeredItemsNo(0)
+    , registerAuto(false)
+    , registrationGeneration(0)
+    , readBytesSaved(0)
+    , readRequestsNo(0)
+    , readNodesShared(0)
+    , writeBytesSaved(0)
+    , writeRequestsNo(0)
     , reqSecurityMode(RequestedSecurityMode::Best)
     , reqSecurityPolicyUri("http://opcfoundation.org/UA/SecurityPolicy#None")
     , transactionId(0)
@@ -340,11 +389,33 @@ SessionOpen62541::SessionOpen62541 (const std::string &name,
     , readNodesMax(0)
     , readTimeoutMin(0)
     , readTimeoutMax(0)
+    , learnedReadNodesMax(0)
+    , learnedWriteNodesMax(0)
+    , preparedReadsMax(0)
+    , preparedReadsUsed(0)
     , client(nullptr)
     , channelState(UA_SECURECHANNELSTATE_CLOSED)
     , sessionState(UA_SESSIONSTATE_CLOSED)
     , connectStatus(UA_STATUSCODE_BADINVALIDSTATE)
+    , MaxNodesPerRead(0)
+    , MaxNodesPerWrite(0)
+    , MaxNodesPerBrowse(0)
+    , MaxNodesPerRegisterNodes(0)
+    , MaxNodesPerTranslate(0)
+    , MaxMonitoredItemsPerSubscription(0)
     , workerThread(nullptr)
+    , connectingAsync(false)
+    , connectingAtStartup(false)
+    , connectTime(-1.0)
+    , warmStartPeriod(60.0)
+    , writeGroupTimeout(30.0)
+    , lazyTypes(false)
+    , serverNamespaceHash(0)
+    , serverStartTime(0)
+    , serverTypeHash(0)
+    , registrationValid(false)
+    , typesLoaded(false)
+    , typesInstalled(false)
 {
     sessions.insert({name, this});
     epicsThreadOnce(&session_open62541_ihooks_once, &session_open62541_ihooks_register, nullptr);
@@ -403,6 +474,27 @@ SessionOpen62541::setOption (const std::string &name, const std::string &value)
         }
     } else if (name == "sec-id") {
         securityIdentityFile = value;
+    } else if (name == "warm-start") {
+        warmStartFile = value;
+    } else if (name == "warm-start-period") {
+        warmStartPeriod = std::strtod(value.c_str(), nullptr);
+    } else if (name == "writegroup-timeout") {
+        writeGroupTimeout = std::strtod(value.c_str(), nullptr);
+    } else if (name == "lazy-types") {
+#ifdef HAS_XMLPARSER
+        if (value.length() > 0)
+            lazyTypes = getYesNo(value[0]);
+#else
+        errlogPrintf("option 'lazy-types' ignored (no custom type support)\n");
+#endif
+    } else if (name == "type-cache") {
+#ifdef HAS_XMLPARSER
+        typeCacheDir = value;
+        while (typeCacheDir.size() > 1 && typeCacheDir.back() == '/')
+            typeCacheDir.pop_back();
+#else
+        errlogPrintf("option 'type-cache' ignored (no XML parser support for custom types)\n");
+#endif
     } else if (name == "debug") {
         unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
         debug = ul;
@@ -432,6 +524,12 @@ SessionOpen62541::setOption (const std::string &name, const std::string &value)
         unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
         readNodesMax = ul;
         updateReadBatcher = true;
+    } else if (name == "read-prepared") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        Guard G(clientlock);
+        preparedReadsMax = ul;
+        preparedReads.clear();
+        preparedReads.setCapacity(ul);
     } else if (name == "read-timeout-min") {
         unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
         readTimeoutMin = ul;
@@ -452,6 +550,14 @@ SessionOpen62541::setOption (const std::string &name, const std::string &value)
         unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
         writeTimeoutMax = ul;
         updateWriteBatcher = true;
+    } else if (name == "register-nodes") {
+        if (value == "auto") {
+            registerAuto = true;
+        } else if (value == "link") {
+            registerAuto = false;
+        } else {
+            errlogPrintf("invalid register-nodes policy (valid: link auto)\n");
+        }
     } else if (name == "autoconnect") {
         if (value.length() > 0)
             autoConnect = getYesNo(value[0]);
@@ -459,20 +565,8 @@ SessionOpen62541::setOption (const std::string &name, const std::string &value)
         errlogPrintf("unknown option '%s' - ignored\n", name.c_str());
     }
 
-    unsigned int max = 0;
-    if (MaxNodesPerRead > 0 && readNodesMax > 0) {
-        max = std::min<unsigned int>(MaxNodesPerRead, readNodesMax);
-    } else {
-        max = MaxNodesPerRead + readNodesMax;
-    }
-    if (updateReadBatcher) reader.setParams(max, readTimeoutMin, readTimeoutMax);
-
-    if (MaxNodesPerWrite > 0 && writeNodesMax > 0) {
-        max = std::min<unsigned int>(MaxNodesPerWrite, writeNodesMax);
-    } else {
-        max = MaxNodesPerWrite + writeNodesMax;
-    }
-    if (updateWriteBatcher) writer.setParams(max, writeTimeoutMin, writeTimeoutMax);
+    if (updateReadBatcher) reader.setParams(readBatchMax(), readTimeoutMin, readTimeoutMax);
+    if (updateWriteBatcher) writer.setParams(writeBatchMax(), writeTimeoutMin, writeTimeoutMax);
 }
 
 long
@@ -574,14 +668,22 @@ SessionOpen62541::connect (bool manual)
     UA_String_copy(&securityInfo.securityPolicyUri, &config->securityPolicyUri);
     UA_copy(&securityInfo.userIdentityToken, &config->userIdentityToken, &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]);
 
-    connectStatus = UA_Client_connect(client, serverURL.c_str());
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 101
+    // Automatic (re)connects don't block: the worker thread completes the connection
+    connectingAsync = !manual;
+    if (connectingAsync)
+        connectStatus = UA_Client_connectAsync(client, serverURL.c_str());
+    else
+#endif
+        connectStatus = UA_Client_connect(client, serverURL.c_str());
 
     if (!UA_STATUS_IS_BAD(connectStatus)) {
         if (debug)
             std::cerr << "Session " << name
-                      << ": connect service succeeded"
+                      << ": connect service " << (connectingAsync ? "started" : "succeeded")
                       << std::endl;
     } else {
+        connectingAsync = false;
         if (manual || debug)
             errlogPrintf("OPC UA session %s: connect service failed with status %s\n",
                          name.c_str(),
@@ -614,9 +716,14 @@ SessionOpen62541::disconnect ()
     {
         Guard G(clientlock);
         if(!client) return 0;
-        clearCustomTypeDictionaries();
+        // Deleting the client completes outstanding requests: make registerNodes callbacks ignore them
+        registrationValid = false;
+        registrationGeneration++;
+        uninstallCustomTypes(); // keep the types for a reconnect to the same server
         UA_Client_delete(client); // This also deletes all open62541 subscriptions
         client = nullptr;
+        for (auto &it : subscriptions)
+            it.second->forgetServerIds();
     }
     // Worker thread terminates when client was destroyed
     if (workerThread) {
@@ -636,11 +743,74 @@ SessionOpen62541::isConnected () const
 void
 SessionOpen62541::requestRead (ItemOpen62541 &item)
 {
+    if (item.linkinfo.readGroup.length()) {
+        std::vector<std::shared_ptr<ReadRequest>> ready;
+        {
+            Guard G(readGroupsLock);
+            ReadGroup &group = readGroups[item.linkinfo.readGroup];
+            // A member asking again before the group is complete: read the members so far
+            if (std::find(group.pending.begin(), group.pending.end(), &item) != group.pending.end())
+                ready.push_back(readGroupRequest(group));
+            if (group.pending.empty())
+                group.since = epicsTime::getCurrent();
+            group.pending.push_back(&item);
+            if (group.pending.size() >= group.members.size())
+                ready.push_back(readGroupRequest(group));
+        }
+        for (auto &cargo : ready)
+            reader.pushRequest(cargo, cargo->item->recConnector->getRecordPriority());
+        return;
+    }
     auto cargo = std::make_shared<ReadRequest>();
     cargo->item = &item;
     reader.pushRequest(cargo, item.recConnector->getRecordPriority());
 }
 
+std::shared_ptr<ReadRequest>
+SessionOpen62541::readGroupRequest (ReadGroup &group)
+{
+    auto cargo = std::make_shared<ReadRequest>();
+    cargo->item = group.pending.front();
+    group.reads++;
+    if (group.pending.size() < group.members.size()) {
+        group.partialReads++;
+        if (debug)
+            std::cout << "Session " << name
+                      << ": read group " << cargo->item->linkinfo.readGroup
+                      << " read with " << group.pending.size()
+                      << " of " << group.members.size() << " members"
+                      << std::endl;
+    }
+    cargo->group.swap(group.pending);
+    return cargo;
+}
+
+// Incomplete read groups wait at least this long [s]
+static const double readGroupHoldMin = 0.1;
+
+double
+SessionOpen62541::readGroupHold () const
+{
+    return std::max(reader.maxHoldOff() / 1e3, readGroupHoldMin);
+}
+
+void
+SessionOpen62541::flushReadGroups (const double hold)
+{
+    std::vector<std::shared_ptr<ReadRequest>> ready;
+    {
+        Guard G(readGroupsLock);
+        epicsTime now = epicsTime::getCurrent();
+        for (auto &it : readGroups) {
+            ReadGroup &group = it.second;
+            if (group.pending.size() && now - group.since >= hold)
+                ready.push_back(readGroupRequest(group));
+        }
+    }
+    for (auto &cargo : ready)
+        reader.pushRequest(cargo, cargo->item->recConnector->getRecordPriority());
+}
+
 // Low level reader function called by the RequestQueueBatcher
 void
 SessionOpen62541::processRequests (std::vector<std::shared_ptr<ReadRequest>> &batch)
@@ -648,67 +818,200 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<ReadRequest>> &ba
     if (!isConnected())
         return;
 
+    // maxAge is a parameter of the Read service: one request per maxAge value
+    // Read groups get a request of their own (one consistent snapshot per group)
+    std::map<double, std::unique_ptr<std::vector<ItemOpen62541 *>>> itemsByMaxAge;
+    std::vector<std::unique_ptr<std::vector<ItemOpen62541 *>>> groups;
+    for (auto c : batch) {
+        if (c->group.size()) {
+            groups.emplace_back(new std::vector<ItemOpen62541 *>(c->group));
+            continue;
+        }
+        auto &itemsToRead = itemsByMaxAge[c->item->linkinfo.maxAge];
+        if (!itemsToRead)
+            itemsToRead.reset(new std::vector<ItemOpen62541 *>);
+        itemsToRead->push_back(c->item);
+    }
+
+    // node ids may change when a registration completes
+    Guard G(clientlock);
+
+    // Items with an unresolved browse path are not read (a group fails as a whole)
+    std::vector<ItemOpen62541 *> unresolved;
+    for (auto &group : itemsByMaxAge) {
+        auto &itemsToRead = *group.second;
+        auto it = std::partition(itemsToRead.begin(), itemsToRead.end(),
+                                 [] (const ItemOpen62541 *item) { return !item->isUnresolved(); });
+        unresolved.insert(unresolved.end(), it, itemsToRead.end());
+        itemsToRead.erase(it, itemsToRead.end());
+    }
+    for (auto &group : groups) {
+        if (std::any_of(group->begin(), group->end(),
+                        [] (const ItemOpen62541 *item) { return item->isUnresolved(); })) {
+            unresolved.insert(unresolved.end(), group->begin(), group->end());
+            group->clear();
+        }
+    }
+
+    for (auto &group : itemsByMaxAge)
+        if (group.second->size() && isConnected()) // may have disconnected while we waited
+            sendReadRequest(std::move(group.second));
+    for (auto &group : groups)
+        if (group->size() && isConnected())
+            sendReadRequest(std::move(group), true);
+    failUnresolved(unresolved, ProcessReason::readFailure);
+}
+
+void
+SessionOpen62541::prepareRead (const std::vector<UA_NodeId> &nodeSet, PreparedRead &prepared)
+{
+    prepared.nodesToRead.resize(nodeSet.size() * no_of_properties_read);
+    size_t i = 0;
+    for (auto &nodeId : nodeSet) {
+        UA_ReadValueId_init(&prepared.nodesToRead[i]);
+        prepared.nodesToRead[i].nodeId = nodeId; // shallow copy
+        prepared.nodesToRead[i].attributeId = UA_ATTRIBUTEID_DATATYPE;
+        i++;
+        UA_ReadValueId_init(&prepared.nodesToRead[i]);
+        prepared.nodesToRead[i].nodeId = nodeId; // shallow copy
+        prepared.nodesToRead[i].attributeId = UA_ATTRIBUTEID_VALUE;
+        i++;
+    }
+}
+
+void
+SessionOpen62541::sendReadRequest (std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToRead,
+                                   const bool group)
+{
     UA_StatusCode status;
-    std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToRead(new std::vector<ItemOpen62541 *>);
     UA_UInt32 id = getTransactionId();
     UA_ReadRequest request;
 
-    UA_ReadRequest_init(&request);
-    request.maxAge = 0;
-    request.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
-    request.nodesToRead = static_cast<UA_ReadValueId*>(
-        UA_Array_new(batch.size() * no_of_properties_read, &UA_TYPES[UA_TYPES_READVALUEID]));
+    // Items linking the same node share one set of read operations
+    std::vector<UA_NodeId> nodeIds;
+    nodeIds.reserve(itemsToRead->size());
+    bool sourceTime = false;
+    bool serverTime = false;
+    for (auto item : *itemsToRead) {
+        nodeIds.push_back(item->getNodeId()); // shallow copy
+        sourceTime |= item->needsSourceTime();
+        serverTime |= item->needsServerTime();
+    }
+    const std::vector<UA_NodeId> nodeSet = sortedNodeSet(nodeIds);
+    const size_t nodes = nodeSet.size();
+
+    // Node (result) index of every item
+    std::vector<UA_UInt32> slots = nodeSlots(nodeIds, nodeSet);
+    std::vector<bool> counted(nodes, false);
+    bool inOrder = true;
+    long saved = 0;
+    for (size_t k = 0; k < itemsToRead->size(); k++) {
+        inOrder &= slots[k] == k;
+        if (!counted[slots[k]]) {
+            counted[slots[k]] = true;
+            saved += 2 * (*itemsToRead)[k]->getRegistrationSaving();
+        }
+    }
 
-    UA_UInt32 i = 0;
-    for (auto c : batch) {
-        UA_NodeId_copy(&c->item->getNodeId(), &request.nodesToRead[i].nodeId);
-        request.nodesToRead[i].attributeId = UA_ATTRIBUTEID_DATATYPE;
-        i++;
-        UA_NodeId_copy(&c->item->getNodeId(), &request.nodesToRead[i].nodeId);
-        request.nodesToRead[i].attributeId = UA_ATTRIBUTEID_VALUE;
-        itemsToRead->push_back(c->item);
-        i++;
+    // Recurring batches (e.g. records on the same periodic scan) reuse their prepared read
+    PreparedRead scratch;
+    const PreparedRead *prepared = &scratch;
+    bool reused = false;
+    if (preparedReadsMax) {
+        if (PreparedRead *entry = preparedReads.find(nodeSet)) {
+            prepared = entry;
+            reused = true;
+        } else {
+            PreparedRead &fresh = preparedReads.insert(nodeSet);
+            prepareRead(nodeSet, fresh);
+            prepared = &fresh;
+        }
+    } else {
+        prepareRead(nodeSet, scratch);
     }
-    request.nodesToReadSize = i;
 
-    {
-        Guard G(clientlock);
-        if (isConnected()) { // may have disconnected while we waited
-            status=UA_Client_sendAsyncReadRequest(client, &request,
-                [] (UA_Client *client,
-                    void *userdata,
-                    UA_UInt32
-                    requestId,
-                    UA_ReadResponse *response)
-                {
-                    static_cast<SessionOpen62541*>(userdata)->readComplete(requestId, response);
-                },
-                this, &id);
-            if (UA_STATUS_IS_BAD(status)) {
-                errlogPrintf(
-                    "OPC UA session %s: (requestRead) beginRead service failed with status %s\n",
-                    name.c_str(),
-                    UA_StatusCode_name(status));
-                // Create readFailure events for all items of the batch
-                for (auto c : batch) {
-                    c->item->setIncomingEvent(ProcessReason::readFailure);
-                }
-            } else {
-                if (debug >= 5)
-                    std::cout << "Session " << name
-                              << ": (requestRead) beginRead service ok"
-                              << " (transaction id " << id
-                              << "; retrieving " << itemsToRead->size()
-                              << " nodes)"
-                              << std::endl;
-                outstandingOps.insert(
-                    std::pair<UA_UInt32,
-                        std::unique_ptr<std::vector<ItemOpen62541 *>>>(id, std::move(itemsToRead)));
-            }
+    // Items of a batch share the maxAge, read groups use the smallest one
+    double maxAge = itemsToRead->front()->linkinfo.maxAge;
+    for (auto item : *itemsToRead)
+        maxAge = std::min(maxAge, item->linkinfo.maxAge);
+
+    UA_ReadRequest_init(&request);
+    request.maxAge = maxAge;
+    // Only request the timestamps that the records of the batch use
+    request.timestampsToReturn = ItemOpen62541::timestampsToReturn(sourceTime, serverTime);
+    request.nodesToRead = const_cast<UA_ReadValueId *>(prepared->nodesToRead.data());
+    request.nodesToReadSize = prepared->nodesToRead.size();
+
+    status=UA_Client_sendAsyncReadRequest(client, &request,
+        [] (UA_Client *client,
+            void *userdata,
+            UA_UInt32
+            requestId,
+            UA_ReadResponse *response)
+        {
+            static_cast<SessionOpen62541*>(userdata)->readComplete(requestId, response);
+        },
+        this, &id);
+    // request contents are owned by the prepared read: no UA_ReadRequest_clear
+
+    if (isBatchTooLarge(status) && itemsToRead->size() > 1 && !group) {
+        preparedReads.erase(nodeSet);
+        splitReadRequest(std::move(itemsToRead), status);
+    } else if (UA_STATUS_IS_BAD(status)) {
+        errlogPrintf(
+            "OPC UA session %s: (requestRead) beginRead service%s failed with status %s\n",
+            name.c_str(), group ? " for a read group" : "",
+            UA_StatusCode_name(status));
+        // Create readFailure events for all items of the batch (a group fails as a whole)
+        ProcessingBarrier barrier;
+        for (auto item : *itemsToRead) {
+            item->setIncomingEvent(ProcessReason::readFailure);
         }
+    } else {
+        readRequestsNo++;
+        readBytesSaved += saved;
+        if (reused)
+            preparedReadsUsed++;
+        if (debug >= 5)
+            std::cout << "Session " << name
+                      << ": (requestRead) beginRead service ok"
+                      << " (transaction id " << id
+                      << "; retrieving " << nodes
+                      << " nodes for " << itemsToRead->size()
+                      << " items; " << saved
+                      << " bytes saved by registration"
+                      << (reused ? "; prepared" : "") << ")"
+                      << std::endl;
+        if (nodes < itemsToRead->size())
+            readNodesShared += itemsToRead->size() - nodes;
+        if (!inOrder)
+            outstandingReadSlots.insert({id, std::move(slots)});
+        if (group)
+            outstandingGroups.insert(id);
+        outstandingOps.insert(
+            std::pair<UA_UInt32,
+                std::unique_ptr<std::vector<ItemOpen62541 *>>>(id, std::move(itemsToRead)));
     }
+}
 
-    UA_ReadRequest_clear(&request);
+void
+SessionOpen62541::splitReadRequest (std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToRead,
+                                    UA_StatusCode status)
+{
+    unsigned int half = static_cast<unsigned int>((itemsToRead->size() + 1) / 2);
+    if (!learnedReadNodesMax || half < learnedReadNodesMax) {
+        learnedReadNodesMax = half;
+        errlogPrintf("OPC UA session %s: read of %lu nodes failed with status %s"
+                     " - limiting read batches to %u nodes\n",
+                     name.c_str(), static_cast<unsigned long>(itemsToRead->size()),
+                     UA_StatusCode_name(status), half);
+        reader.setParams(readBatchMax(), readTimeoutMin, readTimeoutMax);
+    }
+    std::unique_ptr<std::vector<ItemOpen62541 *>> secondHalf(
+        new std::vector<ItemOpen62541 *>(itemsToRead->begin() + half, itemsToRead->end()));
+    itemsToRead->resize(half);
+    sendReadRequest(std::move(itemsToRead));
+    sendReadRequest(std::move(secondHalf));
 }
 
 void
@@ -722,9 +1025,55 @@ SessionOpen62541::requestWrite (ItemOpen62541 &item)
                       << ": (requestWrite) pushing write request for item " << item
                       << " = " << cargo->wvalue.value.value
                       << std::endl;
+    if (item.linkinfo.writeGroup.length()) {
+        Guard G(writeGroupsLock);
+        WriteGroup &group = writeGroups[item.linkinfo.writeGroup];
+        if (!item.linkinfo.commit) {
+            if (group.staged.empty())
+                group.since = epicsTime::getCurrent();
+            group.staged.push_back(cargo); // sent with the next commit
+            return;
+        }
+        cargo->group.swap(group.staged);
+        group.commits++;
+        if (debug >= 5)
+            std::cout << "Session " << name
+                      << ": (requestWrite) committing write group " << item.linkinfo.writeGroup
+                      << " with " << cargo->group.size() + 1 << " writes"
+                      << std::endl;
+    }
     writer.pushRequest(cargo, item.recConnector->getRecordPriority());
 }
 
+void
+SessionOpen62541::expireWriteGroups ()
+{
+    if (writeGroupTimeout <= 0.0)
+        return;
+    std::vector<ItemOpen62541 *> failed;
+    {
+        Guard G(writeGroupsLock);
+        epicsTime now = epicsTime::getCurrent();
+        for (auto &it : writeGroups) {
+            WriteGroup &group = it.second;
+            if (group.staged.empty() || now - group.since < writeGroupTimeout)
+                continue;
+            errlogPrintf("OPC UA session %s: write group %s got no commit within %g s"
+                         " - dropping %lu staged writes\n",
+                         name.c_str(), it.first.c_str(), writeGroupTimeout,
+                         static_cast<unsigned long>(group.staged.size()));
+            for (auto &cargo : group.staged) {
+                UA_WriteValue_clear(&cargo->wvalue);
+                failed.push_back(cargo->item);
+            }
+            group.staged.clear();
+        }
+    }
+    ProcessingBarrier barrier;
+    for (auto item : failed)
+        item->setIncomingEvent(ProcessReason::writeFailure);
+}
+
 // Low level writer function called by the RequestQueueBatcher
 void
 SessionOpen62541::processRequests (std::vector<std::shared_ptr<WriteRequest>> &batch)
@@ -732,60 +1081,199 @@ SessionOpen62541::processRequests (std::vector<std::shared_ptr<WriteRequest>> &b
     if (!isConnected())
         return;
 
+    // Write groups get a request of their own (the commit write last)
+    std::vector<std::vector<WriteRequest *>> requests(1);
+    for (auto c : batch) {
+        if (c->group.size()) {
+            requests.emplace_back();
+            for (auto &staged : c->group)
+                requests.back().push_back(staged.get());
+            requests.back().push_back(c.get());
+        } else {
+            requests.front().push_back(c.get());
+        }
+    }
+
+    // node ids may change when a registration completes
+    Guard G(clientlock);
+
+    // Items with an unresolved browse path are not written (a group fails as a whole)
+    std::vector<ItemOpen62541 *> unresolved;
+    for (auto &cargos : requests) {
+        const bool group = &cargos != &requests.front();
+        auto it = cargos.begin();
+        if (group) {
+            if (std::none_of(cargos.begin(), cargos.end(),
+                             [] (const WriteRequest *c) { return c->item->isUnresolved(); }))
+                it = cargos.end();
+        } else {
+            it = std::partition(cargos.begin(), cargos.end(),
+                                [] (const WriteRequest *c) { return !c->item->isUnresolved(); });
+        }
+        for (auto c = it; c != cargos.end(); ++c) {
+            UA_WriteValue_clear(&(*c)->wvalue);
+            unresolved.push_back((*c)->item);
+        }
+        cargos.erase(it, cargos.end());
+    }
+
+    for (auto &cargos : requests) {
+        if (cargos.empty())
+            continue;
+        const bool group = &cargos != &requests.front();
+        std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToWrite(new std::vector<ItemOpen62541 *>);
+        UA_WriteRequest request;
+
+        UA_WriteRequest_init(&request);
+        request.nodesToWriteSize = cargos.size();
+        request.nodesToWrite = static_cast<UA_WriteValue*>(UA_Array_new(cargos.size(), &UA_TYPES[UA_TYPES_WRITEVALUE]));
+
+        UA_UInt32 i = 0;
+        for (auto c : cargos) {
+            UA_NodeId_copy(&c->item->getNodeId(), &request.nodesToWrite[i].nodeId);
+            request.nodesToWrite[i].attributeId = UA_ATTRIBUTEID_VALUE;
+            request.nodesToWrite[i].value.hasValue = true;
+            request.nodesToWrite[i].value.value = c->wvalue.value.value;
+            itemsToWrite->push_back(c->item);
+            i++;
+        }
+
+        if (isConnected()) // may have disconnected while we waited
+            sendWriteRequest(std::move(itemsToWrite), request, group);
+        else
+            UA_WriteRequest_clear(&request);
+    }
+    failUnresolved(unresolved, ProcessReason::writeFailure);
+}
+
+void
+SessionOpen62541::failUnresolved (const std::vector<ItemOpen62541 *> &unresolved, const ProcessReason reason)
+{
+    if (unresolved.empty())
+        return;
+    ProcessingBarrier barrier;
+    for (auto item : unresolved) {
+        if (item->isUnresolved())
+            item->setLastStatus(UA_STATUSCODE_BADNOMATCH); // browse path unresolved
+        item->setIncomingEvent(reason);
+    }
+}
+
+void
+SessionOpen62541::sendWriteRequest (std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToWrite,
+                                    UA_WriteRequest &request,
+                                    const bool group)
+{
     UA_StatusCode status;
-    std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToWrite(new std::vector<ItemOpen62541 *>);
     UA_UInt32 id = getTransactionId();
-    UA_WriteRequest request;
 
-    UA_WriteRequest_init(&request);
-    request.nodesToWriteSize = batch.size();
-    request.nodesToWrite = static_cast<UA_WriteValue*>(UA_Array_new(batch.size(), &UA_TYPES[UA_TYPES_WRITEVALUE]));
+    long saved = 0;
+    for (auto item : *itemsToWrite)
+        saved += item->getRegistrationSaving();
 
-    UA_UInt32 i = 0;
-    for (auto c : batch) {
-        UA_NodeId_copy(&c->item->getNodeId(), &request.nodesToWrite[i].nodeId);
-        request.nodesToWrite[i].attributeId = UA_ATTRIBUTEID_VALUE;
-        request.nodesToWrite[i].value.hasValue = true;
-        request.nodesToWrite[i].value.value = c->wvalue.value.value;
-        itemsToWrite->push_back(c->item);
-        i++;
+    status=UA_Client_sendAsyncWriteRequest(client, &request,
+        [] (UA_Client *client,
+            void *userdata,
+            UA_UInt32 requestId,
+            UA_WriteResponse *response)
+        {
+            static_cast<SessionOpen62541*>(userdata)->writeComplete(requestId, response);
+        },
+        this, &id);
+
+    if (isBatchTooLarge(status) && itemsToWrite->size() > 1 && !group) {
+        splitWriteRequest(std::move(itemsToWrite), request, status);
+    } else if (UA_STATUS_IS_BAD(status)) {
+        errlogPrintf("OPC UA session %s: (requestWrite) beginWrite service%s failed with status %s\n",
+                     name.c_str(), group ? " for a write group" : "", UA_StatusCode_name(status));
+        // Create writeFailure events for all items of the batch (a group fails as a whole)
+        ProcessingBarrier barrier;
+        for (auto item : *itemsToWrite) {
+            item->setIncomingEvent(ProcessReason::writeFailure);
+        }
+        UA_WriteRequest_clear(&request);
+    } else {
+        writeRequestsNo++;
+        writeBytesSaved += saved;
+        if (debug >= 5)
+            std::cout << "Session " << name
+                      << ": (requestWrite) beginWrite service ok"
+                      << " (transaction id " << id
+                      << "; writing " << itemsToWrite->size()
+                      << " nodes; " << saved
+                      << " bytes saved by registration)"
+                      << std::endl;
+        outstandingOps.insert(std::pair<UA_UInt32,
+            std::unique_ptr<std::vector<ItemOpen62541 *>>>(id, std::move(itemsToWrite)));
+        // keep the values until completion (for splitting the request)
+        outstandingWrites.insert({id, request});
+        if (group)
+            outstandingGroups.insert(id);
     }
+}
 
-    {
-        Guard G(clientlock);
-        if (isConnected()) { // may have disconnected while we waited
-            status=UA_Client_sendAsyncWriteRequest(client, &request,
-                [] (UA_Client *client,
-                    void *userdata,
-                    UA_UInt32 requestId,
-                    UA_WriteResponse *response)
-                {
-                    static_cast<SessionOpen62541*>(userdata)->writeComplete(requestId, response);
-                },
-                this, &id);
-
-            if (UA_STATUS_IS_BAD(status)) {
-                errlogPrintf("OPC UA session %s: (requestWrite) beginWrite service failed with status %s\n",
-                             name.c_str(), UA_StatusCode_name(status));
-                // Create writeFailure events for all items of the batch
-                for (auto c : batch) {
-                    c->item->setIncomingEvent(ProcessReason::writeFailure);
-                }
-            } else {
-                if (debug >= 5)
-                    std::cout << "Session " << name
-                              << ": (requestWrite) beginWrite service ok"
-                              << " (transaction id " << id
-                              << "; writing " << itemsToWrite->size()
-                              << " nodes)"
-                              << std::endl;
-                outstandingOps.insert(std::pair<UA_UInt32,
-                    std::unique_ptr<std::vector<ItemOpen62541 *>>>(id, std::move(itemsToWrite)));
-            }
-        }
+void
+SessionOpen62541::splitWriteRequest (std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToWrite,
+                                     UA_WriteRequest &request,
+                                     UA_StatusCode status)
+{
+    unsigned int half = static_cast<unsigned int>((itemsToWrite->size() + 1) / 2);
+    if (!learnedWriteNodesMax || half < learnedWriteNodesMax) {
+        learnedWriteNodesMax = half;
+        errlogPrintf("OPC UA session %s: write of %lu nodes failed with status %s"
+                     " - limiting write batches to %u nodes\n",
+                     name.c_str(), static_cast<unsigned long>(itemsToWrite->size()),
+                     UA_StatusCode_name(status), half);
+        writer.setParams(writeBatchMax(), writeTimeoutMin, writeTimeoutMax);
+    }
+    std::unique_ptr<std::vector<ItemOpen62541 *>> secondHalf(
+        new std::vector<ItemOpen62541 *>(itemsToWrite->begin() + half, itemsToWrite->end()));
+    itemsToWrite->resize(half);
+
+    // move the second half of the write values into a new request
+    UA_WriteRequest second;
+    UA_WriteRequest_init(&second);
+    second.nodesToWriteSize = request.nodesToWriteSize - half;
+    second.nodesToWrite = static_cast<UA_WriteValue*>(
+        UA_Array_new(second.nodesToWriteSize, &UA_TYPES[UA_TYPES_WRITEVALUE]));
+    for (size_t i = 0; i < second.nodesToWriteSize; i++) {
+        second.nodesToWrite[i] = request.nodesToWrite[half + i];
+        UA_WriteValue_init(&request.nodesToWrite[half + i]);
     }
+    request.nodesToWriteSize = half;
 
-    UA_WriteRequest_clear(&request);
+    sendWriteRequest(std::move(itemsToWrite), request);
+    sendWriteRequest(std::move(secondHalf), second);
+}
+
+bool
+SessionOpen62541::isBatchTooLarge (const UA_StatusCode status)
+{
+    return status == UA_STATUSCODE_BADTOOMANYOPERATIONS
+            || status == UA_STATUSCODE_BADENCODINGLIMITSEXCEEDED
+            || status == UA_STATUSCODE_BADREQUESTTOOLARGE
+            || status == UA_STATUSCODE_BADRESPONSETOOLARGE;
+}
+
+// Combine batch size limits (0 = no limit)
+static unsigned int
+combineLimits (const unsigned int a, const unsigned int b)
+{
+    if (a > 0 && b > 0)
+        return std::min(a, b);
+    return a + b;
+}
+
+unsigned int
+SessionOpen62541::readBatchMax () const
+{
+    return combineLimits(combineLimits(MaxNodesPerRead, readNodesMax), learnedReadNodesMax);
+}
+
+unsigned int
+SessionOpen62541::writeBatchMax () const
+{
+    return combineLimits(combineLimits(MaxNodesPerWrite, writeNodesMax), learnedWriteNodesMax);
 }
 
 void
@@ -804,56 +1292,248 @@ SessionOpen62541::addAllMonitoredItems ()
     }
 }
 
+bool
+SessionOpen62541::isRegisterCandidate (const ItemOpen62541 &item) const
+{
+    if (item.linkinfo.registerNode)
+        return true;
+    // Numeric node ids are about as short as registered ones.
+    // Monitored items use their node id only once (when created).
+    return registerAuto
+            && !item.linkinfo.identifierIsNumeric
+            && (item.linkinfo.isOutput || !item.isMonitored());
+}
+
 void
 SessionOpen62541::registerNodes ()
 {
-    UA_RegisterNodesRequest request;
-    UA_RegisterNodesRequest_init(&request);
+    registeredItemsNo = 0;
+    registrationValid = true;
 
-    request.nodesToRegister = static_cast<UA_NodeId*>(UA_Array_new(items.size(), &UA_TYPES[UA_TYPES_NODEID]));
-    UA_UInt32 i = 0;
+    std::vector<ItemOpen62541 *> candidates;
     for (auto &it : items) {
-        if (it->linkinfo.registerNode) {
-            it->show(0);
-            UA_NodeId_copy(&it->getNodeId(), &request.nodesToRegister[i]);
-            i++;
-        }
+        if (isRegisterCandidate(*it) && !it->isUnresolved())
+            candidates.push_back(it);
     }
-    registeredItemsNo = i;
-    request.nodesToRegisterSize = registeredItemsNo;
+    if (candidates.empty())
+        return;
 
-    if (registeredItemsNo) {
-        UA_RegisterNodesResponse response = UA_Client_Service_registerNodes(client, request);
-        if (UA_STATUS_IS_BAD(response.responseHeader.serviceResult)) {
+    size_t maxNodes = MaxNodesPerRegisterNodes ? MaxNodesPerRegisterNodes : candidates.size();
+    for (size_t first = 0; first < candidates.size(); first += maxNodes) {
+        size_t count = std::min(maxNodes, candidates.size() - first);
+        RegisterNodesChunk *chunk = new RegisterNodesChunk;
+        chunk->session = this;
+        chunk->generation = registrationGeneration;
+        chunk->items.assign(candidates.begin() + first, candidates.begin() + first + count);
+
+        UA_RegisterNodesRequest request;
+        UA_RegisterNodesRequest_init(&request);
+        request.nodesToRegister = static_cast<UA_NodeId*>(UA_Array_new(count, &UA_TYPES[UA_TYPES_NODEID]));
+        request.nodesToRegisterSize = count;
+        for (size_t i = 0; i < count; i++)
+            UA_NodeId_copy(&chunk->items[i]->getNodeId(), &request.nodesToRegister[i]);
+
+        // There is no typed async registerNodes call: use the generic one
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 101
+        UA_StatusCode status = UA_Client_sendAsyncRequest(client, &request,
+#else
+        // Before 1.1 the generic async call was only available as internal API
+        UA_StatusCode status = __UA_Client_AsyncService(client, &request,
+#endif
+            &UA_TYPES[UA_TYPES_REGISTERNODESREQUEST],
+            [] (UA_Client *client,
+                void *userdata,
+                UA_UInt32 requestId,
+                void *response)
+            {
+                RegisterNodesChunk *chunk = static_cast<RegisterNodesChunk*>(userdata);
+                chunk->session->registerNodesComplete(chunk,
+                    static_cast<UA_RegisterNodesResponse*>(response));
+            },
+            &UA_TYPES[UA_TYPES_REGISTERNODESRESPONSE], chunk, nullptr);
+        UA_RegisterNodesRequest_clear(&request);
+
+        if (UA_STATUS_IS_BAD(status)) {
             errlogPrintf("OPC UA session %s: (registerNodes) registerNodes service failed with status %s\n",
-                         name.c_str(), UA_StatusCode_name(response.responseHeader.serviceResult));
-        } else {
-            if (debug)
-                std::cout << "Session " << name
-                          << ": (registerNodes) registerNodes service ok"
-                          << " (" << response.registeredNodeIdsSize
-                          << " nodes registered)"
-                          << std::endl;
-            i = 0;
-            for (auto &it : items) {
-                if (it->linkinfo.registerNode) {
-                    it->setRegisteredNodeId(response.registeredNodeIds[i]);
-                    i++;
-                }
-            }
-            registeredItemsNo = i;
+                         name.c_str(), UA_StatusCode_name(status));
+            delete chunk;
+        } else if (debug >= 5) {
+            std::cout << "Session " << name
+                      << ": (registerNodes) registerNodes service ok"
+                      << " (registering " << count
+                      << " nodes)"
+                      << std::endl;
         }
     }
-    UA_RegisterNodesRequest_clear(&request);
+}
+
+void
+SessionOpen62541::registerNodesComplete (RegisterNodesChunk *chunk, const UA_RegisterNodesResponse *response)
+{
+    std::unique_ptr<RegisterNodesChunk> owner(chunk);
+
+    // Node ids were rebuilt (or the session closed) while the request was outstanding
+    if (!registrationValid || chunk->generation != registrationGeneration)
+        return;
+
+    if (UA_STATUS_IS_BAD(response->responseHeader.serviceResult)) {
+        errlogPrintf("OPC UA session %s: (registerNodes) registerNodes service failed with status %s\n",
+                     name.c_str(), UA_StatusCode_name(response->responseHeader.serviceResult));
+        return;
+    }
+    if (response->registeredNodeIdsSize != chunk->items.size()) {
+        errlogPrintf("OPC UA session %s: (registerNodes) registerNodes service returned %lu node ids "
+                     "for %lu nodes - ignored\n",
+                     name.c_str(),
+                     static_cast<unsigned long>(response->registeredNodeIdsSize),
+                     static_cast<unsigned long>(chunk->items.size()));
+        return;
+    }
+
+    long saving = 0;
+    preparedReads.clear(); // they reference the node ids
+    for (size_t i = 0; i < chunk->items.size(); i++) {
+        chunk->items[i]->setRegisteredNodeId(response->registeredNodeIds[i]);
+        saving += chunk->items[i]->getRegistrationSaving();
+    }
+    registeredItemsNo += static_cast<UA_UInt32>(chunk->items.size());
+    if (debug)
+        std::cout << "Session " << name
+                  << ": (registerNodes) registerNodes service ok"
+                  << " (" << chunk->items.size()
+                  << " nodes registered, saving " << saving
+                  << " bytes per request containing all of them)"
+                  << std::endl;
 }
 
 void
 SessionOpen62541::rebuildNodeIds ()
 {
+    registrationGeneration++;
+    preparedReads.clear(); // they reference the node ids
     for (auto &it : items)
         it->rebuildNodeId();
 }
 
+std::string
+SessionOpen62541::browsePathKey (const linkInfo &info)
+{
+    std::string key;
+    if (info.identifierIsNumeric)
+        key = SB() << "ns=" << info.namespaceIndex << ";i=" << info.identifierNumber;
+    else if (info.identifierString.length())
+        key = SB() << "ns=" << info.namespaceIndex << ";s=" << info.identifierString;
+    return key + "|" + info.browsePathString;
+}
+
+bool
+SessionOpen62541::getBrowsePathTarget (const linkInfo &info, UA_NodeId &nodeId) const
+{
+    auto it = browsePathTargets.find(browsePathKey(info));
+    if (it == browsePathTargets.end())
+        return false;
+    UA_NodeId_copy(&it->second, &nodeId);
+    return true;
+}
+
+void
+SessionOpen62541::clearBrowsePathTargets ()
+{
+    for (auto &it : browsePathTargets)
+        UA_NodeId_clear(&it.second);
+    browsePathTargets.clear();
+}
+
+bool
+SessionOpen62541::resolveBrowsePaths ()
+{
+    std::vector<const linkInfo *> pending;
+    std::set<std::string> keys;
+    for (auto &it : items) {
+        if (it->linkinfo.browsePath.size()) {
+            std::string key = browsePathKey(it->linkinfo);
+            if (browsePathTargets.find(key) == browsePathTargets.end() && keys.insert(key).second)
+                pending.push_back(&it->linkinfo);
+        }
+    }
+    if (pending.empty())
+        return false;
+
+    bool resolved = false;
+    size_t maxNodes = MaxNodesPerTranslate ? MaxNodesPerTranslate : pending.size();
+    for (size_t first = 0; first < pending.size(); first += maxNodes) {
+        size_t count = std::min(maxNodes, pending.size() - first);
+        UA_TranslateBrowsePathsToNodeIdsRequest request;
+        UA_TranslateBrowsePathsToNodeIdsRequest_init(&request);
+        request.browsePaths = static_cast<UA_BrowsePath*>(UA_Array_new(count, &UA_TYPES[UA_TYPES_BROWSEPATH]));
+        request.browsePathsSize = count;
+
+        for (size_t i = 0; i < count; i++) {
+            const linkInfo &info = *pending[first + i];
+            UA_BrowsePath &path = request.browsePaths[i];
+            UA_UInt16 ns = mapNamespaceIndex(info.namespaceIndex);
+            if (info.identifierIsNumeric)
+                path.startingNode = UA_NODEID_NUMERIC(ns, info.identifierNumber);
+            else if (info.identifierString.length())
+                path.startingNode = UA_NODEID_STRING_ALLOC(ns, info.identifierString.c_str());
+            else
+                path.startingNode = UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER);
+            path.relativePath.elements = static_cast<UA_RelativePathElement*>(
+                UA_Array_new(info.browsePath.size(), &UA_TYPES[UA_TYPES_RELATIVEPATHELEMENT]));
+            path.relativePath.elementsSize = info.browsePath.size();
+            size_t j = 0;
+            for (const auto &element : info.browsePath) {
+                UA_RelativePathElement &elem = path.relativePath.elements[j++];
+                elem.referenceTypeId = UA_NODEID_NUMERIC(0, element.aggregates ? UA_NS0ID_AGGREGATES
+                                                                               : UA_NS0ID_HIERARCHICALREFERENCES);
+                elem.isInverse = false;
+                elem.includeSubtypes = true;
+                elem.targetName = UA_QUALIFIEDNAME_ALLOC(mapNamespaceIndex(element.namespaceIndex),
+                                                         element.name.c_str());
+            }
+        }
+
+        UA_TranslateBrowsePathsToNodeIdsResponse response
+                = UA_Client_Service_translateBrowsePathsToNodeIds(client, request);
+        if (UA_STATUS_IS_BAD(response.responseHeader.serviceResult)) {
+            errlogPrintf("OPC UA session %s: (resolveBrowsePaths) translateBrowsePathsToNodeIds service "
+                         "failed with status %s\n",
+                         name.c_str(), UA_StatusCode_name(response.responseHeader.serviceResult));
+        } else {
+            for (size_t i = 0; i < count && i < response.resultsSize; i++) {
+                const linkInfo &info = *pending[first + i];
+                const UA_BrowsePathResult &result = response.results[i];
+                if (UA_STATUS_IS_BAD(result.statusCode) || result.targetsSize == 0
+                        || result.targets[0].targetId.serverIndex != 0) {
+                    errlogPrintf("OPC UA session %s: browse path %s not resolved (%s)\n",
+                                 name.c_str(), browsePathKey(info).c_str(),
+                                 UA_StatusCode_name(UA_STATUS_IS_BAD(result.statusCode)
+                                                    ? result.statusCode : UA_STATUSCODE_BADNOMATCH));
+                    continue;
+                }
+                if (result.targetsSize > 1 && debug)
+                    std::cout << "Session " << name
+                              << ": browse path " << browsePathKey(info)
+                              << " has " << result.targetsSize
+                              << " targets, using the first one"
+                              << std::endl;
+                UA_NodeId &target = browsePathTargets[browsePathKey(info)];
+                UA_NodeId_copy(&result.targets[0].targetId.nodeId, &target);
+                resolved = true;
+            }
+            if (debug)
+                std::cout << "Session " << name
+                          << ": (resolveBrowsePaths) translateBrowsePathsToNodeIds service ok"
+                          << " (" << response.resultsSize
+                          << " browse paths)"
+                          << std::endl;
+        }
+        UA_TranslateBrowsePathsToNodeIdsRequest_clear(&request);
+        UA_TranslateBrowsePathsToNodeIdsResponse_clear(&response);
+    }
+    return resolved;
+}
+
 /* Add a mapping to the session's map, replacing any existing mappings with the same
  * index or URI */
 void
@@ -1231,6 +1911,13 @@ void SessionOpen62541::setupClientSecurityInfo(ClientSecurityInfo &securityInfo,
 void
 SessionOpen62541::show (const int level) const
 {
+    size_t preparedReadsNo;
+    unsigned long preparedReadsEvicted;
+    {
+        Guard G(clientlock);
+        preparedReadsNo = preparedReads.size();
+        preparedReadsEvicted = preparedReads.evicted();
+    }
     std::cout << "session="      << name
               << " url="         << serverURL
               << " connect status=" << UA_StatusCode_name(connectStatus)
@@ -1243,9 +1930,20 @@ SessionOpen62541::show (const int level) const
               << " debug="       << debug
               << " batch r/w="   << MaxNodesPerRead << "/" << MaxNodesPerWrite
               << "(" << readNodesMax << "/" << writeNodesMax << ")"
+              << " learned r/w=" << learnedReadNodesMax << "/" << learnedWriteNodesMax
               << " autoconnect=" << (autoConnect ? "y" : "n")
+              << " reconnects=" << autoConnector.attemptsTotal()
+              << " lazy-types=" << (lazyTypes ? "y" : "n")
               << " items=" << items.size()
               << " registered=" << registeredItemsNo
+              << "(" << (registerAuto ? "auto" : "link") << ")"
+              << " saved r/w=" << readBytesSaved << "/" << writeBytesSaved << "B"
+              << " in " << readRequestsNo << "/" << writeRequestsNo << " requests"
+              << " shared reads=" << readNodesShared
+              << " prepared reads=" << preparedReadsNo << "/" << preparedReadsMax
+              << "(" << preparedReadsUsed << " used, " << preparedReadsEvicted << " evicted)"
+              << " read groups=" << readGroups.size()
+              << " write groups=" << writeGroups.size()
               << " subscriptions=" << subscriptions.size()
               << " reader=" << reader.maxRequests() << "/"
               << reader.minHoldOff() << "-" << reader.maxHoldOff() << "ms"
@@ -1253,6 +1951,21 @@ SessionOpen62541::show (const int level) const
               << writer.minHoldOff() << "-" << writer.maxHoldOff() << "ms"
               << std::endl;
 
+    if (level >= 2) {
+        for (const auto &group : readGroups)
+            std::cout << "  read group=" << group.first
+                      << " members=" << group.second.members.size()
+                      << " pending=" << group.second.pending.size()
+                      << " reads=" << group.second.reads
+                      << "(" << group.second.partialReads << " partial)"
+                      << std::endl;
+        for (const auto &group : writeGroups)
+            std::cout << "  write group=" << group.first
+                      << " staged=" << group.second.staged.size()
+                      << " commits=" << group.second.commits
+                      << std::endl;
+    }
+
     if (level >= 3) {
         if (namespaceMap.size()) {
             std::cout << "Configured Namespace Mapping "
@@ -1296,6 +2009,14 @@ void
 SessionOpen62541::addItemOpen62541 (ItemOpen62541 *item)
 {
     items.push_back(item);
+    if (item->linkinfo.readGroup.length()) {
+        Guard G(readGroupsLock);
+        readGroups[item->linkinfo.readGroup].members.push_back(item);
+    }
+    if (item->linkinfo.writeGroup.length()) {
+        Guard G(writeGroupsLock);
+        writeGroups[item->linkinfo.writeGroup]; // known to the group timer
+    }
 }
 
 void
@@ -1304,6 +2025,26 @@ SessionOpen62541::removeItemOpen62541 (ItemOpen62541 *item)
     auto it = std::find(items.begin(), items.end(), item);
     if (it != items.end())
         items.erase(it);
+    if (item->linkinfo.readGroup.length()) {
+        Guard G(readGroupsLock);
+        ReadGroup &group = readGroups[item->linkinfo.readGroup];
+        group.members.erase(std::remove(group.members.begin(), group.members.end(), item), group.members.end());
+        group.pending.erase(std::remove(group.pending.begin(), group.pending.end(), item), group.pending.end());
+    }
+    if (item->linkinfo.writeGroup.length()) {
+        Guard G(writeGroupsLock);
+        auto &staged = writeGroups[item->linkinfo.writeGroup].staged;
+        for (auto it = staged.begin(); it != staged.end(); ) {
+            if ((*it)->item == item) {
+                UA_WriteValue_clear(&(*it)->wvalue);
+                it = staged.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    Guard G(clientlock);
+    preparedReads.clear();
 }
 
 UA_UInt16
@@ -1323,6 +2064,19 @@ SessionOpen62541::markConnectionLoss()
 {
     reader.clear();
     writer.clear();
+    {
+        Guard G(readGroupsLock);
+        for (auto &it : readGroups)
+            it.second.pending.clear();
+    }
+    {
+        Guard G(writeGroupsLock);
+        for (auto &it : writeGroups) {
+            for (auto &cargo : it.second.staged)
+                UA_WriteValue_clear(&cargo->wvalue);
+            it.second.staged.clear();
+        }
+    }
     for (auto it : items) {
         it->setState(ConnectionStatus::down);
         it->setIncomingEvent(ProcessReason::connectionLoss);
@@ -1488,9 +2242,195 @@ SessionOpen62541::run ()
         std::cerr << "Session " << name
                   << " worker thread error: status:" << UA_StatusCode_name(status)
                   << std::endl;
+    asyncConnectFailed();
     disconnect();
 }
 
+// Batched browse and read
+//
+// Synchronous services for many nodes per request, split according to the server's
+// operation limits. Used for discovery during connect (from the worker thread).
+
+void
+SessionOpen62541::browseBatched (const std::vector<UA_NodeId> &nodes,
+                                 const UA_BrowseDirection direction,
+                                 const UA_NodeId &referenceTypeId,
+                                 BrowseResults &results)
+{
+    results.clear();
+    results.references.resize(nodes.size());
+    size_t maxNodes = MaxNodesPerBrowse ? MaxNodesPerBrowse : nodes.size();
+
+    // Move the references of one result into our results, return continuation point
+    auto collect = [&results] (UA_BrowseResult &result, size_t index, UA_ByteString &continuationPoint) {
+        auto &refs = results.references[index];
+        if (UA_STATUS_IS_BAD(result.statusCode))
+            return;
+        refs.insert(refs.end(), result.references, result.references + result.referencesSize);
+        UA_free(result.references); // elements have been moved
+        result.references = nullptr;
+        result.referencesSize = 0;
+        continuationPoint = result.continuationPoint;
+        UA_ByteString_init(&result.continuationPoint);
+    };
+
+    std::vector<UA_BrowseDescription> descriptions;
+    for (size_t start = 0; start < nodes.size(); start += maxNodes) {
+        size_t n = std::min(maxNodes, nodes.size() - start);
+        descriptions.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            UA_BrowseDescription_init(&descriptions[i]);
+            descriptions[i].nodeId = nodes[start + i]; // shallow copy
+            descriptions[i].browseDirection = direction;
+            descriptions[i].referenceTypeId = referenceTypeId; // shallow copy
+            descriptions[i].includeSubtypes = true;
+            descriptions[i].resultMask = UA_BROWSERESULTMASK_ALL;
+        }
+        UA_BrowseRequest request;
+        UA_BrowseRequest_init(&request);
+        request.requestedMaxReferencesPerNode = 0;
+        request.nodesToBrowse = descriptions.data();
+        request.nodesToBrowseSize = n;
+        UA_BrowseResponse response = UA_Client_Service_browse(client, request);
+
+        std::vector<UA_ByteString> continuationPoints;
+        std::vector<size_t> continued;
+        if (response.responseHeader.serviceResult == UA_STATUSCODE_GOOD && response.resultsSize == n) {
+            for (size_t i = 0; i < n; i++) {
+                UA_ByteString cp = UA_BYTESTRING_NULL;
+                collect(response.results[i], start + i, cp);
+                if (cp.length) {
+                    continuationPoints.push_back(cp);
+                    continued.push_back(start + i);
+                }
+            }
+        } else if (debug) {
+            std::cerr << "Session " << name
+                      << ": (browseBatched) browse service failed with status "
+                      << UA_StatusCode_name(response.responseHeader.serviceResult) << std::endl;
+        }
+        UA_BrowseResponse_clear(&response);
+
+        // Collect the remaining references of all nodes in one request per round
+        while (continuationPoints.size()) {
+            UA_BrowseNextRequest next;
+            UA_BrowseNextRequest_init(&next);
+            next.continuationPoints = continuationPoints.data();
+            next.continuationPointsSize = continuationPoints.size();
+            UA_BrowseNextResponse nextResponse = UA_Client_Service_browseNext(client, next);
+            std::vector<UA_ByteString> nextPoints;
+            std::vector<size_t> nextContinued;
+            if (nextResponse.responseHeader.serviceResult == UA_STATUSCODE_GOOD
+                    && nextResponse.resultsSize == continuationPoints.size()) {
+                for (size_t i = 0; i < nextResponse.resultsSize; i++) {
+                    UA_ByteString cp = UA_BYTESTRING_NULL;
+                    collect(nextResponse.results[i], continued[i], cp);
+                    if (cp.length) {
+                        nextPoints.push_back(cp);
+                        nextContinued.push_back(continued[i]);
+                    }
+                }
+            }
+            UA_BrowseNextResponse_clear(&nextResponse);
+            for (auto &cp : continuationPoints)
+                UA_ByteString_clear(&cp);
+            continuationPoints.swap(nextPoints);
+            continued.swap(nextContinued);
+        }
+    }
+}
+
+void
+SessionOpen62541::readBatched (const std::vector<UA_NodeId> &nodes,
+                               const UA_UInt32 attributeId,
+                               ReadResults &results)
+{
+    results.clear();
+    results.values.resize(nodes.size());
+    for (auto &value : results.values)
+        UA_Variant_init(&value);
+    size_t maxNodes = MaxNodesPerRead ? MaxNodesPerRead : nodes.size();
+
+    std::vector<UA_ReadValueId> nodesToRead;
+    for (size_t start = 0; start < nodes.size(); start += maxNodes) {
+        size_t n = std::min(maxNodes, nodes.size() - start);
+        nodesToRead.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            UA_ReadValueId_init(&nodesToRead[i]);
+            nodesToRead[i].nodeId = nodes[start + i]; // shallow copy
+            nodesToRead[i].attributeId = attributeId;
+        }
+        UA_ReadRequest request;
+        UA_ReadRequest_init(&request);
+        request.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+        request.nodesToRead = nodesToRead.data();
+        request.nodesToReadSize = n;
+        UA_ReadResponse response = UA_Client_Service_read(client, request);
+        if (response.responseHeader.serviceResult == UA_STATUSCODE_GOOD && response.resultsSize == n) {
+            for (size_t i = 0; i < n; i++) {
+                if (response.results[i].hasValue && !UA_STATUS_IS_BAD(response.results[i].status)) {
+                    results.values[start + i] = response.results[i].value;
+                    UA_Variant_init(&response.results[i].value); // moved out
+                }
+            }
+        } else if (debug) {
+            std::cerr << "Session " << name
+                      << ": (readBatched) read service failed with status "
+                      << UA_StatusCode_name(response.responseHeader.serviceResult) << std::endl;
+        }
+        UA_ReadResponse_clear(&response);
+    }
+}
+
+UA_UInt64
+SessionOpen62541::dictionaryVersionHash (UA_UInt64 hash)
+{
+    // Dictionaries are the components of the OPC Binary type system
+    BrowseResults dicts;
+    browseBatched({UA_NODEID_NUMERIC(0, UA_NS0ID_OPCBINARYSCHEMA_TYPESYSTEM)}, UA_BROWSEDIRECTION_FORWARD,
+                  UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT), dicts);
+    std::vector<UA_NodeId> dictIds;
+    for (const auto &ref : dicts.references[0]) {
+        if (ref.nodeId.nodeId.namespaceIndex == 0) // custom type dictionaries only
+            continue;
+        dictIds.push_back(ref.nodeId.nodeId);
+        hash = fnv1a(hash, &ref.browseName.namespaceIndex, sizeof(ref.browseName.namespaceIndex));
+        hash = fnv1a(hash, ref.browseName.name);
+    }
+
+    // Their version properties
+    BrowseResults properties;
+    browseBatched(dictIds, UA_BROWSEDIRECTION_FORWARD, UA_NODEID_NUMERIC(0, UA_NS0ID_HASPROPERTY), properties);
+    const UA_String dataTypeVersion = UA_STRING_STATIC("DataTypeVersion");
+    const UA_String nodeVersion = UA_STRING_STATIC("NodeVersion");
+    std::vector<UA_NodeId> versionIds;
+    std::vector<UA_NodeId> unversionedIds;
+    for (size_t d = 0; d < dictIds.size(); d++) {
+        size_t n = versionIds.size();
+        for (const auto &ref : properties.references[d])
+            if (UA_String_equal(&ref.browseName.name, &dataTypeVersion)
+                || UA_String_equal(&ref.browseName.name, &nodeVersion))
+                versionIds.push_back(ref.nodeId.nodeId);
+        if (versionIds.size() == n)
+            unversionedIds.push_back(dictIds[d]);
+    }
+
+    // Versions where available, contents otherwise
+    ReadResults versions;
+    readBatched(versionIds, UA_ATTRIBUTEID_VALUE, versions);
+    ReadResults contents;
+    readBatched(unversionedIds, UA_ATTRIBUTEID_VALUE, contents);
+    for (const auto *results : {&versions, &contents})
+        for (const auto &value : results->values) {
+            if (UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_STRING])
+                || UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_BYTESTRING]))
+                hash = fnv1a(hash, *static_cast<const UA_String *>(value.data));
+            else
+                hash = fnv1a(hash, "", 1);
+        }
+    return hash;
+}
+
 #ifdef HAS_XMLPARSER
 
 #ifndef UA_ENABLE_TYPEDESCRIPTION
@@ -1544,43 +2484,368 @@ SessionOpen62541::getTypeIndexByName(UA_UInt16 nsIndex, const char* typeName)
     return UnknownType;
 }
 
-// Wrapper to use lambda with capture in C callback
-struct LambdaHolder {
-    std::function<UA_StatusCode(const UA_NodeId&, UA_Boolean, const UA_NodeId&, void*)> func;
-};
+// Persistent cache of the parsed type dictionaries
+//
+// One text file per server (named by a hash of the server URI) in the directory
+// set with the session option "type-cache". The file is valid as long as the
+// server's fingerprint (NamespaceArray and BuildInfo) and the open62541 version
+// match. Strings are written as <length>:<bytes>, NodeIds as <ns> i <number>
+// or <ns> s <string>.
+
+static const char *typeCacheMagic = "opcua-typecache";
+static const unsigned int typeCacheVersion = 1;
+
+static bool
+writeNodeId (std::ostream &os, const UA_NodeId &id)
+{
+    os << ' ' << id.namespaceIndex;
+    switch (id.identifierType) {
+    case UA_NODEIDTYPE_NUMERIC:
+        os << " i " << id.identifier.numeric;
+        return true;
+    case UA_NODEIDTYPE_STRING:
+        os << " s";
+        writeToken(os, to_string(id.identifier.string));
+        return true;
+    default:
+        return false; // GUID and opaque NodeIds are not cached
+    }
+}
+
+static bool
+readNodeId (std::istream &is, UA_NodeId &id)
+{
+    UA_UInt16 ns;
+    char kind;
+    if (!(is >> ns >> kind))
+        return false;
+    if (kind == 'i') {
+        UA_UInt32 n;
+        if (!(is >> n))
+            return false;
+        id = UA_NODEID_NUMERIC(ns, n);
+        return true;
+    }
+    if (kind == 's') {
+        std::string str;
+        if (!readToken(is, str))
+            return false;
+        UA_NodeId tmp = UA_NODEID_STRING(ns, const_cast<char *>(str.c_str()));
+        return UA_NodeId_copy(&tmp, &id) == UA_STATUSCODE_GOOD;
+    }
+    return false;
+}
+
+static void
+freeCustomTypes (std::vector<UA_DataType> &types)
+{
+    for (auto type: types) {
+        for (UA_UInt32 i = 0; i < type.membersSize; i++)
+        {
+            free(const_cast<char*>(type.members[i].memberName));
+        }
+        free(type.members);
+    }
+    types.clear();
+}
+
+std::string
+SessionOpen62541::typeCacheFingerprint (std::string &serverUri)
+{
+    // One read request for everything that identifies the server's type system
+    UA_ReadValueId ids[3];
+    for (auto &id : ids) {
+        UA_ReadValueId_init(&id);
+        id.attributeId = UA_ATTRIBUTEID_VALUE;
+    }
+    ids[0].nodeId = UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERARRAY);
+    ids[1].nodeId = UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_NAMESPACEARRAY);
+    ids[2].nodeId = UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERSTATUS_BUILDINFO);
+    UA_ReadRequest request;
+    UA_ReadRequest_init(&request);
+    request.nodesToRead = ids;
+    request.nodesToReadSize = 3;
+    UA_ReadResponse response = UA_Client_Service_read(client, request);
+
+    std::string fingerprint;
+    if (response.responseHeader.serviceResult == UA_STATUSCODE_GOOD && response.resultsSize == 3) {
+        const UA_Variant &servers = response.results[0].value;
+        const UA_Variant &namespaces = response.results[1].value;
+        const UA_Variant &buildInfo = response.results[2].value;
+        if (UA_Variant_hasArrayType(&servers, &UA_TYPES[UA_TYPES_STRING]) && servers.arrayLength
+            && UA_Variant_hasArrayType(&namespaces, &UA_TYPES[UA_TYPES_STRING])
+            && UA_Variant_hasScalarType(&buildInfo, &UA_TYPES[UA_TYPES_BUILDINFO])) {
+            serverUri = to_string(static_cast<UA_String *>(servers.data)[0]);
+            UA_UInt64 hash = 0xcbf29ce484222325ULL;
+            for (size_t i = 0; i < namespaces.arrayLength; i++)
+                hash = fnv1a(hash, static_cast<UA_String *>(namespaces.data)[i]);
+            const UA_BuildInfo *bi = static_cast<UA_BuildInfo *>(buildInfo.data);
+            hash = fnv1a(hash, bi->productUri);
+            hash = fnv1a(hash, bi->softwareVersion);
+            hash = fnv1a(hash, bi->buildNumber);
+            hash = fnv1a(hash, &bi->buildDate, sizeof(bi->buildDate));
+            hash = dictionaryVersionHash(hash);
+            char buf[17];
+            snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash));
+            fingerprint = buf;
+        }
+    }
+    UA_ReadResponse_clear(&response);
+    return fingerprint;
+}
+
+std::string
+SessionOpen62541::typeCacheFile (const std::string &serverUri) const
+{
+    UA_UInt64 hash = fnv1a(0xcbf29ce484222325ULL, serverUri.c_str(), serverUri.length());
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(hash));
+    return typeCacheDir + "/" + buf + ".typecache";
+}
+
+bool
+SessionOpen62541::loadTypeCache (const std::string &serverUri, const std::string &fingerprint)
+{
+    std::ifstream is(typeCacheFile(serverUri));
+    if (!is)
+        return false;
+
+    if (!readCacheHeader(is, typeCacheMagic, typeCacheVersion, { cacheLibraryTag(), serverUri, fingerprint }))
+        return false;
+
+    bool complete = false;
+    std::string keyword;
+    while (!complete && is >> keyword) {
+        if (keyword == "binid") {
+            std::string typeName;
+            UA_NodeId id;
+            if (!readToken(is, typeName) || !readNodeId(is, id))
+                break;
+            binaryTypeIds.emplace(typeName, id);
+        } else if (keyword == "enum") {
+            UA_NodeId id;
+            size_t n;
+            if (!readNodeId(is, id) || !(is >> n))
+                break;
+            EnumChoices enumChoices;
+            epicsUInt32 value;
+            std::string choice;
+            for (size_t i = 0; i < n && is >> value && readToken(is, choice); i++)
+                enumChoices.emplace(value, choice);
+            if (enumChoices.size() != n)
+                break;
+            enumTypes.emplace(id, std::move(enumChoices));
+        } else if (keyword == "type") {
+            std::string typeName;
+            UA_DataType type = {};
+            unsigned int memSize, typeKind, pointerFree, overlayable, membersSize;
+            if (!readToken(is, typeName) || !readNodeId(is, type.typeId) || !readNodeId(is, type.binaryEncodingId)
+                || !(is >> memSize >> typeKind >> pointerFree >> overlayable >> membersSize))
+                break;
+            type.memSize = static_cast<UA_UInt16>(memSize);
+            type.typeKind = typeKind;
+            type.pointerFree = pointerFree;
+            type.overlayable = overlayable;
+#ifndef UA_DATATYPES_USE_POINTER
+            type.typeIndex = static_cast<UA_UInt16>(customTypes.size());
+#endif
+            type.typeName = strdup(typeName.c_str());
+            type.membersSize = 0;
+            type.members = static_cast<UA_DataTypeMember*>(calloc(membersSize ? membersSize : 1, sizeof(UA_DataTypeMember)));
+            customTypes.push_back(type); // now owned by customTypes (cleaned up on error)
+            UA_DataType &t = customTypes.back();
+            for (; t.membersSize < membersSize; t.membersSize++) {
+                std::string memberName;
+                unsigned int custom, index, padding, isArray, isOptional;
+                if (!(is >> keyword) || keyword != "member" || !readToken(is, memberName)
+                    || !(is >> custom >> index >> padding >> isArray >> isOptional))
+                    break;
+                UA_DataTypeMember &m = t.members[t.membersSize];
+#ifdef UA_DATATYPES_USE_POINTER
+                // Custom member types are resolved after loading (see readCustomTypeDictionaries)
+                if (custom)
+                    m.memberType = reinterpret_cast<const UA_DataType*>((static_cast<size_t>(index) << 1) | 1);
+                else if (index < UA_TYPES_COUNT)
+                    m.memberType = &UA_TYPES[index];
+                else
+                    break;
+#else
+                m.namespaceZero = !custom;
+                m.memberTypeIndex = static_cast<UA_UInt16>(index);
+#endif
+                m.padding = padding;
+                m.isArray = isArray;
+                m.isOptional = isOptional;
+                m.memberName = strdup(memberName.c_str());
+            }
+            if (t.membersSize != membersSize)
+                break;
+        } else if (keyword == "end") {
+            complete = true;
+        } else {
+            break;
+        }
+    }
+
+    // Member types must refer to existing types
+    for (const auto &type : customTypes) {
+        for (UA_UInt32 i = 0; complete && i < type.membersSize; i++) {
+#ifdef UA_DATATYPES_USE_POINTER
+            size_t ref = reinterpret_cast<size_t>(type.members[i].memberType);
+            if ((ref & 1) && (ref >> 1) >= customTypes.size())
+                complete = false;
+#else
+            if (type.members[i].memberTypeIndex >=
+                    (type.members[i].namespaceZero ? UA_TYPES_COUNT : customTypes.size()))
+                complete = false;
+#endif
+        }
+    }
+
+    if (!complete) {
+        freeCustomTypes(customTypes);
+        binaryTypeIds.clear();
+        enumTypes.clear();
+    }
+    return complete;
+}
 
-static UA_StatusCode iteratorCallbackAdapter(UA_NodeId childId, UA_Boolean isInverse,
-                              UA_NodeId referenceTypeId, void *handle)
+void
+SessionOpen62541::saveTypeCache (const std::string &serverUri, const std::string &fingerprint) const
 {
-    LambdaHolder *holder = static_cast<LambdaHolder*>(handle);
-    return holder->func(childId, isInverse, referenceTypeId, handle);
+    std::ostringstream os;
+    writeCacheHeader(os, typeCacheMagic, typeCacheVersion, { cacheLibraryTag(), serverUri, fingerprint });
+
+    bool ok = true;
+    for (const auto &it : binaryTypeIds) {
+        os << "binid";
+        writeToken(os, it.first);
+        ok = ok && writeNodeId(os, it.second);
+        os << '\n';
+    }
+    for (const auto &it : enumTypes) {
+        os << "enum";
+        ok = ok && writeNodeId(os, it.first);
+        os << ' ' << it.second.size();
+        for (const auto &choice : it.second) {
+            os << ' ' << choice.first;
+            writeToken(os, choice.second);
+        }
+        os << '\n';
+    }
+    for (const auto &type : customTypes) {
+        os << "type";
+        writeToken(os, type.typeName);
+        ok = ok && writeNodeId(os, type.typeId) && writeNodeId(os, type.binaryEncodingId);
+        os << ' ' << static_cast<unsigned int>(type.memSize)
+           << ' ' << static_cast<unsigned int>(type.typeKind)
+           << ' ' << static_cast<unsigned int>(type.pointerFree)
+           << ' ' << static_cast<unsigned int>(type.overlayable)
+           << ' ' << static_cast<unsigned int>(type.membersSize);
+        for (UA_UInt32 i = 0; i < type.membersSize; i++) {
+            const UA_DataTypeMember &m = type.members[i];
+            unsigned int custom;
+            size_t index;
+#ifdef UA_DATATYPES_USE_POINTER
+            if (m.memberType >= customTypes.data() && m.memberType < customTypes.data() + customTypes.size()) {
+                custom = 1;
+                index = m.memberType - customTypes.data();
+            } else if (m.memberType >= UA_TYPES && m.memberType < UA_TYPES + UA_TYPES_COUNT) {
+                custom = 0;
+                index = m.memberType - UA_TYPES;
+            } else {
+                ok = false;
+                break;
+            }
+#else
+            custom = m.namespaceZero ? 0 : 1;
+            index = m.memberTypeIndex;
+#endif
+            os << "\nmember";
+            writeToken(os, m.memberName);
+            os << ' ' << custom
+               << ' ' << index
+               << ' ' << static_cast<unsigned int>(m.padding)
+               << ' ' << static_cast<unsigned int>(m.isArray)
+               << ' ' << static_cast<unsigned int>(m.isOptional);
+        }
+        os << '\n';
+    }
+    os << "end\n";
+
+    if (!ok) {
+        if (debug)
+            std::cout << "Session " << name
+                      << ": type dictionaries contain NodeIds that can't be cached" << std::endl;
+        return;
+    }
+
+    // Write to a temporary file and rename, so that readers never see a partial file
+    std::string file = typeCacheFile(serverUri);
+    std::string tmpfile = file + "." + name + ".tmp";
+    {
+        std::ofstream out(tmpfile, std::ios::trunc);
+        out << os.str();
+        ok = bool(out);
+    }
+    if (!ok || std::rename(tmpfile.c_str(), file.c_str())) {
+        errlogPrintf("OPC UA session %s: can't write type cache file %s\n", name.c_str(), file.c_str());
+        std::remove(tmpfile.c_str());
+    } else if (debug) {
+        std::cout << "Session " << name
+                  << ": wrote type cache " << file << std::endl;
+    }
 }
 
 void
 SessionOpen62541::readCustomTypeDictionaries()
 {
     clearCustomTypeDictionaries();
-    UA_ClientConfig *config = UA_Client_getConfig(client);
-    if (debug)
-        std::cout << "Session " << name
-                  << ": reading Enums"
-                  << std::endl;
-    UA_Client_forEachChildNodeCall(client, UA_NODEID_NUMERIC(0, UA_NS0ID_ENUMERATION),
-        [] (UA_NodeId childNodeId, UA_Boolean isInverse, UA_NodeId referenceTypeId, void *handle)
-        {
-            return static_cast<SessionOpen62541*>(handle)->
-                enumIteratorCallback(childNodeId, referenceTypeId);
-        }, this);
-    if (debug)
-        std::cout << "\nSession " << name
-                  << ": reading type dictionaries"
-                  << std::endl;
-    UA_Client_forEachChildNodeCall(client, UA_NODEID_NUMERIC(0, UA_NS0ID_OPCBINARYSCHEMA_TYPESYSTEM),
-        [] (UA_NodeId childNodeId, UA_Boolean isInverse, UA_NodeId referenceTypeId, void *handle)
-        {
-            return static_cast<SessionOpen62541*>(handle)->
-                typeSystemIteratorCallback(childNodeId);
-        }, this);
+    if (lazyTypes)
+        return; // only the types used by items are resolved (resolveItemTypes)
+
+    std::string serverUri, fingerprint;
+    bool fromCache = false;
+    if (typeCacheDir.size()) {
+        fingerprint = typeCacheFingerprint(serverUri);
+        if (fingerprint.empty()) {
+            if (debug)
+                std::cout << "Session " << name
+                          << ": can't identify server type system - not using type cache"
+                          << std::endl;
+        } else {
+            fromCache = loadTypeCache(serverUri, fingerprint);
+            if (debug)
+                std::cout << "Session " << name
+                          << (fromCache ? ": using" : ": no valid")
+                          << " type cache " << typeCacheFile(serverUri)
+                          << " for " << serverUri
+                          << std::endl;
+        }
+    }
+
+    if (!fromCache) {
+        if (debug)
+            std::cout << "Session " << name
+                      << ": reading Enums"
+                      << std::endl;
+        readEnumTypes();
+        if (debug)
+            std::cout << "\nSession " << name
+                      << ": reading type dictionaries"
+                      << std::endl;
+        readTypeDictionaries();
+    }
+    installCustomTypes();
+
+    if (!fromCache && fingerprint.size())
+        saveTypeCache(serverUri, fingerprint);
+}
+
+void
+SessionOpen62541::installCustomTypes()
+{
+    uninstallCustomTypes();
 #ifdef UA_DATATYPES_USE_POINTER
     // Resolve all pointers to custom types
     for (auto type: customTypes) {
@@ -1599,12 +2864,13 @@ SessionOpen62541::readCustomTypeDictionaries()
 
     Guard G(clientlock);
     if (!client) return;
+    UA_ClientConfig *config = UA_Client_getConfig(client);
 
     // Add collected types to client
     UA_DataTypeArray *customTypesArray = static_cast<UA_DataTypeArray*>(malloc(sizeof(UA_DataTypeArray)));
     if (!customTypesArray) {
         errlogPrintf(
-            "OPC UA Session %s: (readCustomTypeDictionaries) out of memory\n",
+            "OPC UA Session %s: (installCustomTypes) out of memory\n",
             name.c_str());
         return;
     }
@@ -1613,6 +2879,8 @@ SessionOpen62541::readCustomTypeDictionaries()
     *const_cast<size_t*>(&customTypesArray->typesSize) = customTypes.size();
     customTypesArray->types = customTypes.data(); // zero-copy: direct access to vector data
     config->customDataTypes = customTypesArray;
+    typesInstalled = true;
+    typesLoaded = true;
 
     if (debug >= 2) {
         for (size_t i = 0; i < config->customDataTypes->typesSize; i++) {
@@ -1653,244 +2921,467 @@ SessionOpen62541::readCustomTypeDictionaries()
                   << " custom data types" << std::endl;
 }
 
+// Lazy type resolution
+//
+// Instead of reading all type dictionaries, only the data types of the
+// configured items (and their member types) are resolved, using the
+// DataTypeDefinition attribute (OPC UA 1.04).
+
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 101
+
+// Type definition as read from the server
+struct LazyTypeDefinition {
+    UA_NodeId dataTypeId;
+    std::string name;
+    UA_Variant definition;
+    enum { pending, built, failed } state;
+};
+
+// Look up a member data type: builtin, or a custom type that is already built
+// Returns nullptr if not (yet) available.
+static const UA_DataType *
+lazyMemberType (const UA_NodeId &dataTypeId,
+                const std::unordered_map<UA_NodeId, size_t> &customIndex,
+                const std::vector<UA_DataType> &customTypes,
+                size_t &index)
+{
+    if (dataTypeId.namespaceIndex == 0) {
+        if (dataTypeId.identifierType == UA_NODEIDTYPE_NUMERIC
+                && dataTypeId.identifier.numeric == UA_NS0ID_BASEDATATYPE) {
+            index = UA_TYPES_VARIANT;
+            return &UA_TYPES[UA_TYPES_VARIANT];
+        }
+        const UA_DataType *type = UA_findDataType(&dataTypeId);
+        if (type < &UA_TYPES[0] || type >= &UA_TYPES[UA_TYPES_COUNT])
+            return nullptr;
+        index = type - UA_TYPES;
+        return type;
+    }
+    auto it = customIndex.find(dataTypeId);
+    if (it == customIndex.end())
+        return nullptr;
+    index = UA_TYPES_COUNT + it->second;
+    return &customTypes[it->second];
+}
+
+#endif
+
+void
+SessionOpen62541::resolveItemTypes()
+{
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 101
+    std::vector<LazyTypeDefinition> defs;
+    std::unordered_map<UA_NodeId, size_t> defIndex;
+    auto want = [&defs, &defIndex] (const UA_NodeId &id) {
+        if (id.namespaceIndex == 0 || defIndex.count(id))
+            return;
+        defs.emplace_back();
+        UA_NodeId_copy(&id, &defs.back().dataTypeId);
+        UA_Variant_init(&defs.back().definition);
+        defs.back().state = LazyTypeDefinition::pending;
+        defIndex.emplace(defs.back().dataTypeId, defs.size() - 1); // key shares the id's data
+    };
+
+    // Data types used by the items
+    std::vector<UA_NodeId> ids;
+    ReadResults values;
+    for (auto it : items)
+        ids.push_back(it->getNodeId());
+    readBatched(ids, UA_ATTRIBUTEID_DATATYPE, values);
+    for (const auto &value : values.values) {
+        if (UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_NODEID]))
+            want(*static_cast<UA_NodeId *>(value.data));
+    }
+    size_t itemTypes = defs.size();
+
+    // Definitions, adding member types until all are known
+    for (size_t done = 0; done < defs.size(); ) {
+        ids.clear();
+        for (size_t i = done; i < defs.size(); i++)
+            ids.push_back(defs[i].dataTypeId);
+        readBatched(ids, UA_ATTRIBUTEID_DATATYPEDEFINITION, values);
+        ReadResults names;
+        readBatched(ids, UA_ATTRIBUTEID_BROWSENAME, names);
+        for (size_t i = 0; i < ids.size(); i++) {
+            LazyTypeDefinition &def = defs[done + i];
+            def.definition = values.values[i];
+            UA_Variant_init(&values.values[i]); // moved
+            if (UA_Variant_hasScalarType(&names.values[i], &UA_TYPES[UA_TYPES_QUALIFIEDNAME]))
+                def.name = to_string(static_cast<UA_QualifiedName *>(names.values[i].data)->name);
+        }
+        done += ids.size();
+        for (size_t i = done - ids.size(); i < done; i++) {
+            if (UA_Variant_hasScalarType(&defs[i].definition, &UA_TYPES[UA_TYPES_STRUCTUREDEFINITION])) {
+                auto sd = static_cast<const UA_StructureDefinition *>(defs[i].definition.data);
+                for (size_t f = 0; f < sd->fieldsSize; f++)
+                    want(sd->fields[f].dataType);
+            }
+        }
+    }
+
+    // Build the types, members first
+    std::unordered_map<UA_NodeId, size_t> customIndex;
+    for (bool progress = true; progress; ) {
+        progress = false;
+        for (auto &def : defs) {
+            if (def.state != LazyTypeDefinition::pending)
+                continue;
+
+            UA_DataType type = {};
+            type.pointerFree = true;
+#ifndef UA_DATATYPES_USE_POINTER
+            type.typeIndex = static_cast<UA_UInt16>(customTypes.size());
+#endif
+            if (UA_Variant_hasScalarType(&def.definition, &UA_TYPES[UA_TYPES_ENUMDEFINITION])) {
+                auto ed = static_cast<const UA_EnumDefinition *>(def.definition.data);
+                type.typeKind = UA_DATATYPEKIND_ENUM;
+                type.memSize = sizeof(UA_UInt32);
+                type.overlayable = UA_BINARY_OVERLAYABLE_INTEGER;
+                // Enums have no encoding of their own
+                UA_NodeId_copy(&def.dataTypeId, &type.binaryEncodingId);
+                EnumChoices enumChoices;
+                for (size_t f = 0; f < ed->fieldsSize; f++)
+                    enumChoices.emplace(static_cast<epicsUInt32>(ed->fields[f].value), to_string(ed->fields[f].name));
+                enumTypes.emplace(type.binaryEncodingId, std::move(enumChoices));
+
+            } else if (UA_Variant_hasScalarType(&def.definition, &UA_TYPES[UA_TYPES_STRUCTUREDEFINITION])) {
+                auto sd = static_cast<const UA_StructureDefinition *>(def.definition.data);
+                switch (sd->structureType) {
+                case UA_STRUCTURETYPE_STRUCTURE:
+                    type.typeKind = UA_DATATYPEKIND_STRUCTURE;
+                    break;
+                case UA_STRUCTURETYPE_STRUCTUREWITHOPTIONALFIELDS:
+                    type.typeKind = UA_DATATYPEKIND_OPTSTRUCT;
+                    break;
+                case UA_STRUCTURETYPE_UNION:
+                    type.typeKind = UA_DATATYPEKIND_UNION;
+                    type.memSize = sizeof(UA_UInt32); // switch field
+                    break;
+                default:
+                    def.state = LazyTypeDefinition::failed;
+                    continue;
+                }
+
+                // Wait until all member types are available
+                size_t index;
+                size_t f;
+                for (f = 0; f < sd->fieldsSize; f++)
+                    if (!lazyMemberType(sd->fields[f].dataType, customIndex, customTypes, index))
+                        break;
+                if (f < sd->fieldsSize)
+                    continue;
+
+                UA_UInt32 structureAlignment = 0;
+                std::vector<UA_DataTypeMember> members;
+                for (f = 0; f < sd->fieldsSize; f++) {
+                    const UA_StructureField &field = sd->fields[f];
+                    if (field.valueRank != -1 && field.valueRank != 1) {
+                        if (debug)
+                            std::cerr << "Session " << name
+                                      << ": field " << def.name << '.' << to_string(field.name)
+                                      << " has unsupported value rank " << field.valueRank << std::endl;
+                        break;
+                    }
+                    const UA_DataType *memberType = lazyMemberType(field.dataType, customIndex, customTypes, index);
+                    UA_DataTypeMember member = {};
+#ifdef UA_DATATYPES_USE_POINTER
+                    // Custom types are marked by an odd number (see parseCustomDataTypes)
+                    if (index < UA_TYPES_COUNT)
+                        member.memberType = memberType;
+                    else
+                        member.memberType = reinterpret_cast<const UA_DataType*>(((index - UA_TYPES_COUNT) << 1) | 1);
+#else
+                    member.namespaceZero = index < UA_TYPES_COUNT;
+                    member.memberTypeIndex = memberType->typeIndex;
+#endif
+                    UA_UInt32 memberSize;
+                    member.isOptional = field.isOptional && type.typeKind == UA_DATATYPEKIND_OPTSTRUCT;
+                    if (field.valueRank == 1) {
+                        // Arrays are stored as {size_t length; void* data;}.
+                        member.isArray = true;
+                        memberSize = sizeof(size_t) + sizeof(void*);
+                        type.pointerFree = false;
+                    } else if (member.isOptional) {
+                        // Optional fields are stored as pointers.
+                        memberSize = sizeof(void*);
+                        type.pointerFree = false;
+                    } else {
+                        memberSize = memberType->memSize;
+                        type.pointerFree = type.pointerFree && memberType->pointerFree;
+                    }
+                    member.memberName = strdup(to_string(field.name).c_str());
+                    layoutMember(type, member, memberSize, structureAlignment);
+                    members.push_back(member);
+                }
+                if (f < sd->fieldsSize || members.size() > 255) {
+                    for (auto &member : members)
+                        free(const_cast<char*>(member.memberName));
+                    def.state = LazyTypeDefinition::failed;
+                    continue;
+                }
+                // Pad structure to align with its largest primitive.
+                type.memSize += (structureAlignment & ~(type.memSize-1));
+                UA_NodeId_copy(&sd->defaultEncodingId, &type.binaryEncodingId);
+                type.membersSize = members.size();
+                type.members = static_cast<UA_DataTypeMember*>(
+                    malloc(std::max<size_t>(members.size(), 1) * sizeof(UA_DataTypeMember)));
+                if (!type.members) {
+                    errlogPrintf("OPC UA Session %s: (resolveItemTypes) out of memory\n", name.c_str());
+                    for (auto &member : members)
+                        free(const_cast<char*>(member.memberName));
+                    UA_NodeId_clear(&type.binaryEncodingId);
+                    def.state = LazyTypeDefinition::failed;
+                    break;
+                }
+                memcpy(type.members, members.data(), members.size() * sizeof(UA_DataTypeMember));
+
+            } else {
+                // No definition: abstract type or subtype of a builtin type
+                def.state = LazyTypeDefinition::failed;
+                continue;
+            }
+
+            UA_NodeId_copy(&type.binaryEncodingId, &type.typeId);
+            type.typeName = strdup(def.name.c_str());
+            customIndex.emplace(def.dataTypeId, customTypes.size());
+            customTypes.push_back(type);
+            def.state = LazyTypeDefinition::built;
+            progress = true;
+        }
+    }
+
+    unsigned int failed = 0;
+    for (auto &def : defs) {
+        if (def.state != LazyTypeDefinition::built) {
+            failed++;
+            if (debug >= 2)
+                std::cerr << "Session " << name
+                          << ": can't resolve data type " << def.dataTypeId
+                          << " (" << def.name << ")" << std::endl;
+        }
+        UA_Variant_clear(&def.definition);
+    }
+    defIndex.clear();
+    for (auto &def : defs)
+        UA_NodeId_clear(&def.dataTypeId);
+
+    if (debug)
+        std::cout << "Session " << name
+                  << ": resolved " << customTypes.size() << " data types ("
+                  << itemTypes << " used by items, "
+                  << failed << " not resolvable)" << std::endl;
+
+    installCustomTypes();
+#else
+    errlogPrintf("OPC UA session %s: option 'lazy-types' requires open62541 version 1.1 or higher\n",
+                 name.c_str());
+#endif
+}
+
 void
-SessionOpen62541::clearCustomTypeDictionaries()
+SessionOpen62541::uninstallCustomTypes()
 {
     Guard G(clientlock);
-    if (!client) return;
+    if (!client || !typesInstalled) return;
     UA_ClientConfig *config = UA_Client_getConfig(client);
     UA_DataTypeArray *customTypesArray = const_cast<UA_DataTypeArray *>(config->customDataTypes);
     if (customTypesArray) {
         config->customDataTypes = customTypesArray->next;
         free(customTypesArray);
     }
-    for (auto type: customTypes) {
-        for (UA_UInt32 i = 0; i < type.membersSize; i++)
-        {
-            free(const_cast<char*>(type.members[i].memberName));
-        }
-        free(type.members);
-    }
-    customTypes.clear();
-    binaryTypeIds.clear();
-    enumTypes.clear();
+    typesInstalled = false;
 }
 
-UA_StatusCode
-SessionOpen62541::enumIteratorCallback(const UA_NodeId& childId, const UA_NodeId& referenceTypeId)
+void
+SessionOpen62541::clearCustomTypeDictionaries()
 {
-    UA_StatusCode status = UA_STATUSCODE_GOOD;
-    UA_QualifiedName typeName;
-    UA_QualifiedName_init(&typeName);
-    UA_Client_readBrowseNameAttribute(client, childId, &typeName);
-    UA_NodeId binaryEncodingId = UA_NODEID_NULL;
-    UA_NodeId_copy(&childId, &binaryEncodingId);
-    if (debug >= 4)
-        std::cout << "\nEnum " << typeName
-                  << " { # binaryEncodingId: " << binaryEncodingId
-                  << std::endl;
-    EnumChoices enumChoices;
-    LambdaHolder holder;
-    holder.func = [&enumChoices, this] (UA_NodeId childNodeId, UA_Boolean isInverse, UA_NodeId referenceTypeId, void *handle)
-    {
-        return this->enumChoiceIteratorCallback(childNodeId, referenceTypeId, enumChoices);
-    };
-    status = UA_Client_forEachChildNodeCall(client, childId, iteratorCallbackAdapter, &holder);
-    if (debug >= 4)
-        std::cout << "};" << std::endl;
-    if (enumChoices.size() > 0) {
-        if (debug >= 5)
-            std::cout << "# adding enum " << typeName << " to known types" << std::endl;
-        enumTypes.emplace(binaryEncodingId, std::move(enumChoices));
-        binaryTypeIds.emplace(to_string(typeName.name), binaryEncodingId);
-
-        UA_DataType customDataType = {};
-        customDataType.memSize = sizeof(UA_UInt32);
-        customDataType.typeKind = UA_DATATYPEKIND_ENUM;
-        customDataType.pointerFree = true;
-        customDataType.overlayable = UA_BINARY_OVERLAYABLE_INTEGER;
-#ifndef UA_DATATYPES_USE_POINTER
-        customDataType.typeIndex = static_cast<UA_UInt16>(customTypes.size());
-#endif
-        UA_NodeId_copy(&binaryEncodingId, &customDataType.binaryEncodingId);
-        UA_NodeId_copy(&binaryEncodingId, &customDataType.typeId);
-        char* ctypeName = static_cast<char*>(calloc(typeName.name.length+1, 1));
-        if (!customDataType.typeName) {
-            status = UA_STATUSCODE_BADOUTOFMEMORY;
-        } else {
-            strncpy(ctypeName, reinterpret_cast<char*>(typeName.name.data), typeName.name.length);
-            customDataType.typeName = ctypeName;
-            customTypes.push_back(customDataType);
-        }
-    }
-
-    UA_QualifiedName_clear(&typeName);
-    return status;
+    Guard G(clientlock);
+    uninstallCustomTypes();
+    typesLoaded = false;
+    freeCustomTypes(customTypes);
+    binaryTypeIds.clear();
+    enumTypes.clear();
 }
 
-UA_StatusCode
-SessionOpen62541::enumChoiceIteratorCallback(const UA_NodeId& childId, const UA_NodeId& referenceTypeId, EnumChoices& enumChoices)
+void
+SessionOpen62541::readEnumTypes()
 {
-    UA_StatusCode status = UA_STATUSCODE_GOOD;
-    const UA_NodeId hasProperty = UA_NODEID_NUMERIC(0, UA_NS0ID_HASPROPERTY);
-
-    if (UA_NodeId_equal(&referenceTypeId, &hasProperty))
-    {
-        UA_Variant value;
-        UA_Variant_init(&value);
-        UA_Client_readValueAttribute(client, childId, &value);
-        if (UA_Variant_hasArrayType(&value, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]))
-        {
-            UA_LocalizedText* choices = static_cast<UA_LocalizedText*>(value.data);
-            for (size_t i = 0; i < value.arrayLength; i++) {
-                if (debug >= 4)
-                    std::cout << "  " << i << " = " << choices[i].text << ';' << std::endl;
-                enumChoices.emplace(static_cast<epicsInt32>(i), to_string(choices[i].text));
-            }
-        }
-        else if (UA_Variant_hasArrayType(&value, &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]))
-        {
-            UA_ExtensionObject* choices = static_cast<UA_ExtensionObject*>(value.data);
-            for (size_t i = 0; i < value.arrayLength; i++) {
-                if (choices[i].encoding == UA_EXTENSIONOBJECT_DECODED &&
-                    choices[i].content.decoded.type == &UA_TYPES[UA_TYPES_ENUMVALUETYPE])
-                {
-                    UA_EnumValueType *enumValue = static_cast<UA_EnumValueType*>(choices[i].content.decoded.data);
+    // Enum types are the subtypes of Enumeration
+    BrowseResults enums;
+    browseBatched({UA_NODEID_NUMERIC(0, UA_NS0ID_ENUMERATION)}, UA_BROWSEDIRECTION_FORWARD,
+                  UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE), enums);
+    std::vector<UA_NodeId> enumIds;
+    for (const auto &ref : enums.references[0])
+        enumIds.push_back(ref.nodeId.nodeId);
+
+    // Their EnumStrings or EnumValues properties
+    BrowseResults properties;
+    browseBatched(enumIds, UA_BROWSEDIRECTION_FORWARD, UA_NODEID_NUMERIC(0, UA_NS0ID_HASPROPERTY), properties);
+    std::vector<UA_NodeId> propertyIds;
+    for (const auto &refs : properties.references)
+        for (const auto &ref : refs)
+            propertyIds.push_back(ref.nodeId.nodeId);
+    ReadResults values;
+    readBatched(propertyIds, UA_ATTRIBUTEID_VALUE, values);
+
+    size_t p = 0;
+    for (size_t e = 0; e < enumIds.size(); e++) {
+        const UA_QualifiedName &typeName = enums.references[0][e].browseName;
+        UA_NodeId binaryEncodingId = UA_NODEID_NULL;
+        UA_NodeId_copy(&enumIds[e], &binaryEncodingId);
+        if (debug >= 4)
+            std::cout << "\nEnum " << typeName
+                      << " { # binaryEncodingId: " << binaryEncodingId
+                      << std::endl;
+        EnumChoices enumChoices;
+        for (size_t n = properties.references[e].size(); n; n--, p++) {
+            const UA_Variant &value = values.values[p];
+            if (UA_Variant_hasArrayType(&value, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]))
+            {
+                UA_LocalizedText* choices = static_cast<UA_LocalizedText*>(value.data);
+                for (size_t i = 0; i < value.arrayLength; i++) {
                     if (debug >= 4)
-                        std::cout << "  " << enumValue->value << " = " << enumValue->displayName.text << ';' << std::endl;
-                    enumChoices.emplace(static_cast<epicsInt32>(enumValue->value),
-                        to_string(enumValue->displayName.text));
+                        std::cout << "  " << i << " = " << choices[i].text << ';' << std::endl;
+                    enumChoices.emplace(static_cast<epicsInt32>(i), to_string(choices[i].text));
+                }
+            }
+            else if (UA_Variant_hasArrayType(&value, &UA_TYPES[UA_TYPES_EXTENSIONOBJECT]))
+            {
+                UA_ExtensionObject* choices = static_cast<UA_ExtensionObject*>(value.data);
+                for (size_t i = 0; i < value.arrayLength; i++) {
+                    if (choices[i].encoding == UA_EXTENSIONOBJECT_DECODED &&
+                        choices[i].content.decoded.type == &UA_TYPES[UA_TYPES_ENUMVALUETYPE])
+                    {
+                        UA_EnumValueType *enumValue = static_cast<UA_EnumValueType*>(choices[i].content.decoded.data);
+                        if (debug >= 4)
+                            std::cout << "  " << enumValue->value << " = " << enumValue->displayName.text << ';' << std::endl;
+                        enumChoices.emplace(static_cast<epicsInt32>(enumValue->value),
+                            to_string(enumValue->displayName.text));
+                    }
                 }
             }
         }
-        UA_Variant_clear(&value);
+        if (debug >= 4)
+            std::cout << "};" << std::endl;
+        if (enumChoices.size() > 0) {
+            if (debug >= 5)
+                std::cout << "# adding enum " << typeName << " to known types" << std::endl;
+            enumTypes.emplace(binaryEncodingId, std::move(enumChoices));
+            binaryTypeIds.emplace(to_string(typeName.name), binaryEncodingId);
+        } else {
+            UA_NodeId_clear(&binaryEncodingId);
+        }
     }
-    return status;
 }
 
-UA_StatusCode
-SessionOpen62541::typeSystemIteratorCallback(const UA_NodeId& dictNodeId)
+void
+SessionOpen62541::readTypeDictionaries()
 {
-    UA_QualifiedName dictName;
-    UA_QualifiedName_init(&dictName);
-    if (debug) {
-        // Show the dict name in debug messages
-        UA_Client_readBrowseNameAttribute(client, dictNodeId, &dictName);
+    // Dictionaries are the components of the OPC Binary type system
+    BrowseResults dicts;
+    browseBatched({UA_NODEID_NUMERIC(0, UA_NS0ID_OPCBINARYSCHEMA_TYPESYSTEM)}, UA_BROWSEDIRECTION_FORWARD,
+                  UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT), dicts);
+    std::vector<UA_NodeId> dictIds;
+    std::vector<const UA_QualifiedName *> dictNames;
+    for (const auto &ref : dicts.references[0]) {
+        if (ref.nodeId.nodeId.namespaceIndex == 0) { // custom type dictionaries only
+            if (debug)
+                std::cout << "Session " << name
+                          << ": ignoring system dict " << ref.browseName
+                          << std::endl;
+            continue;
+        }
+        dictIds.push_back(ref.nodeId.nodeId);
+        dictNames.push_back(&ref.browseName);
     }
 
-    if (dictNodeId.namespaceIndex == 0) { // custom type dictionaries only
+    // The XML type descriptions
+    ReadResults xmldata;
+    readBatched(dictIds, UA_ATTRIBUTEID_VALUE, xmldata);
+
+    // The data type description nodes of all dictionaries
+    BrowseResults descriptions;
+    browseBatched(dictIds, UA_BROWSEDIRECTION_FORWARD, UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT), descriptions);
+    std::vector<UA_NodeId> descriptionIds;
+    for (const auto &refs : descriptions.references)
+        for (const auto &ref : refs)
+            descriptionIds.push_back(ref.nodeId.nodeId);
+
+    // Their binary encoding nodes (source of the HasDescription reference)
+    BrowseResults encodings;
+    browseBatched(descriptionIds, UA_BROWSEDIRECTION_INVERSE, UA_NODEID_NUMERIC(0, UA_NS0ID_HASDESCRIPTION), encodings);
+
+    size_t t = 0;
+    for (size_t d = 0; d < dictIds.size(); d++) {
         if (debug) {
             std::cout << "Session " << name
-                      << ": ignoring system dict " << dictName
+                      << ": browsing custom dict " << *dictNames[d]
+                      << " for binary encoding IDs"
                       << std::endl;
-            UA_QualifiedName_clear(&dictName);
         }
-        return UA_STATUSCODE_GOOD;
-    }
-
-    if (debug) {
-        std::cout << "Session " << name
-                  << ": browsing custom dict " << dictName
-                  << " for binary encoding IDs"
-                  << std::endl;
-    }
 
-    // Browse the dictionary for binaryTypeIds
-    UA_Client_forEachChildNodeCall(client, dictNodeId,
-        [] (UA_NodeId childNodeId, UA_Boolean isInverse, UA_NodeId referenceTypeId, void *handle)
-        {
-            return static_cast<SessionOpen62541*>(handle)->
-                dictIteratorCallback(childNodeId, referenceTypeId);
-        }, this);
-
-    // Read the XML type descriptions
-    UA_Variant xmldata;
-    UA_Variant_init(&xmldata);
-    UA_Client_readValueAttribute(client, dictNodeId, &xmldata);
-    if (UA_Variant_hasScalarType(&xmldata, &UA_TYPES[UA_TYPES_BYTESTRING])) {
-        UA_ByteString* xmlstring = static_cast<UA_ByteString*>(xmldata.data);
-        if (debug >= 5)
-            std::cout << "\nSession " << name
-                      << ": Data type XML of dict " << dictName
-                      << '\n' << *xmlstring
-                      << std::endl;
-        xmlDocPtr xmldoc = xmlReadMemory(reinterpret_cast<const char*>(xmlstring->data),
-            static_cast<int>(xmlstring->length), NULL, NULL, 0);
-        if (xmldoc) {
-            parseCustomDataTypes(xmlDocGetRootElement(xmldoc), dictNodeId.namespaceIndex);
-            xmlFreeDoc(xmldoc);
+        for (const auto &description : descriptions.references[d]) {
+            const UA_QualifiedName &typeName = description.browseName;
+            if (debug >= 5)
+                std::cout << "Session " << name
+                          << ": type " << description.nodeId.nodeId << " = " << typeName
+                          << std::endl;
+            for (const auto &encoding : encodings.references[t])
+                addBinaryEncodingId(encoding.nodeId.nodeId, typeName);
+            t++;
         }
-    }
-    UA_Variant_clear(&xmldata);
-    UA_QualifiedName_clear(&dictName);
-    return UA_STATUSCODE_GOOD;
-}
-
-UA_StatusCode
-SessionOpen62541::dictIteratorCallback(const UA_NodeId& childId, const UA_NodeId& referenceTypeId)
-{
-    UA_StatusCode status = UA_STATUSCODE_GOOD;
-    const UA_NodeId hasComponent = UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT);
 
-    if (UA_NodeId_equal(&referenceTypeId, &hasComponent))
-    {
-        UA_QualifiedName typeName;
-        UA_QualifiedName_init(&typeName);
-        UA_Client_readBrowseNameAttribute(client, childId, &typeName);
-        if (debug >= 5)
-            std::cout << "Session " << name
-                      << ": type " << childId << " = " << typeName
-                      << std::endl;
-        LambdaHolder holder;
-        holder.func = [&typeName, this] (UA_NodeId childNodeId, UA_Boolean isInverse, UA_NodeId referenceTypeId, void *handle)
-        {
-            return this->typeIteratorCallback(childNodeId, referenceTypeId, typeName);
-        };
-        status = UA_Client_forEachChildNodeCall(client, childId, iteratorCallbackAdapter, &holder);
-        UA_QualifiedName_clear(&typeName);
+        const UA_Variant &xml = xmldata.values[d];
+        if (UA_Variant_hasScalarType(&xml, &UA_TYPES[UA_TYPES_BYTESTRING])) {
+            UA_ByteString* xmlstring = static_cast<UA_ByteString*>(xml.data);
+            if (debug >= 5)
+                std::cout << "\nSession " << name
+                          << ": Data type XML of dict " << *dictNames[d]
+                          << '\n' << *xmlstring
+                          << std::endl;
+            xmlDocPtr xmldoc = xmlReadMemory(reinterpret_cast<const char*>(xmlstring->data),
+                static_cast<int>(xmlstring->length), NULL, NULL, 0);
+            if (xmldoc) {
+                parseCustomDataTypes(xmlDocGetRootElement(xmldoc), dictIds[d].namespaceIndex);
+                xmlFreeDoc(xmldoc);
+            }
+        }
     }
-    return status;
 }
 
-UA_StatusCode
-SessionOpen62541::typeIteratorCallback(const UA_NodeId& childId, const UA_NodeId& referenceTypeId, const UA_QualifiedName& typeName)
+void
+SessionOpen62541::addBinaryEncodingId(const UA_NodeId& encodingId, const UA_QualifiedName& typeName)
 {
-    const UA_NodeId hasDescription = UA_NODEID_NUMERIC(0, UA_NS0ID_HASDESCRIPTION);
-
-    if (UA_NodeId_equal(&referenceTypeId, &hasDescription))
-    {
-        if (typeName.namespaceIndex != childId.namespaceIndex) {
-            if (debug)
-                std::cerr << "Session " << name
-                          << ": custom type " << typeName
-                          << " and its nodeId " << childId
-                          << " have different name spaces!"
-                          << std::endl;
-            return UA_STATUSCODE_BADUNEXPECTEDERROR;
-        }
-        if (debug >= 4)
-            std::cout << "Session " << name
+    if (typeName.namespaceIndex != encodingId.namespaceIndex) {
+        if (debug)
+            std::cerr << "Session " << name
                       << ": custom type " << typeName
-                      << " has binaryEncodingId " << childId
+                      << " and its nodeId " << encodingId
+                      << " have different name spaces!"
                       << std::endl;
+        return;
+    }
+    if (debug >= 4)
+        std::cout << "Session " << name
+                  << ": custom type " << typeName
+                  << " has binaryEncodingId " << encodingId
+                  << std::endl;
 
 #if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR < 103
-        // open62541 v1.2 crashes with non-numeric binaryEncodingIds
-        if (childId.identifierType != UA_NODEIDTYPE_NUMERIC) {
-            std::cerr << "Session " << name
-                      << ": (readCustomTypeDictionaries) Can't use type " << typeName
-                      << " because open62541 v1.2 can't handle non-numeric binaryEncodingId "
-                      << childId << std::endl;
-            return UA_STATUSCODE_BADUNEXPECTEDERROR;
-        }
+    // open62541 v1.2 crashes with non-numeric binaryEncodingIds
+    if (encodingId.identifierType != UA_NODEIDTYPE_NUMERIC) {
+        std::cerr << "Session " << name
+                  << ": (readCustomTypeDictionaries) Can't use type " << typeName
+                  << " because open62541 v1.2 can't handle non-numeric binaryEncodingId "
+                  << encodingId << std::endl;
+        return;
+    }
 #endif
 
-        // Need copy because content of non-numeric (e.g. string) childId is freed after this function returns
-        UA_NodeId binaryEncodingId = UA_NODEID_NULL;
-        UA_NodeId_copy(&childId, &binaryEncodingId);
-        binaryTypeIds.emplace(to_string(typeName.name), binaryEncodingId);
-    }
-    return UA_STATUSCODE_GOOD;
+    // Need copy because content of the browse results is freed later
+    UA_NodeId binaryEncodingId = UA_NODEID_NULL;
+    UA_NodeId_copy(&encodingId, &binaryEncodingId);
+    binaryTypeIds.emplace(to_string(typeName.name), binaryEncodingId);
 }
 
 static inline bool typeAlreadyKnown(const std::vector<UA_DataType>& knownTypes, const char* name)
@@ -1901,6 +3392,33 @@ static inline bool typeAlreadyKnown(const std::vector<UA_DataType>& knownTypes,
     return false;
 }
 
+// Place a member of a structure or union: set its padding, update the size of the type.
+// Returns the alignment (-1) of the member.
+static UA_UInt32
+layoutMember (UA_DataType &type, UA_DataTypeMember &member, const UA_UInt32 memberSize, UA_UInt32 &structureAlignment)
+{
+    // Pad to align this member.
+    // Primitives are max 8 bytes long (double, void*, int64).
+    // Thus, maximal 8 byte alignment is sufficient.
+    UA_UInt32 memberAlignment = (memberSize-1) & 7; // actually alignment-1
+    if (type.typeKind != UA_DATATYPEKIND_UNION) {
+        // Align this member on top of structure so far.
+        member.padding = memberAlignment & ~(type.memSize-1);
+        // Total size is the sum of all member sizes including padding.
+        type.memSize += member.padding + memberSize;
+    } else {
+        // For unions padding includes the UInt32 switch field.
+        member.padding = sizeof(UA_UInt32) + (memberAlignment & ~(sizeof(UA_UInt32)-1));
+        // Total size is the maximum of all member sizes including padding.
+        if (member.padding + memberSize > type.memSize)
+            type.memSize = member.padding + memberSize;
+    }
+    // Align structure to largest member alignment.
+    if (memberAlignment > structureAlignment)
+        structureAlignment = memberAlignment;
+    return memberAlignment;
+}
+
 void
 SessionOpen62541::parseCustomDataTypes(xmlNode* node, UA_UInt16 nsIndex)
 {
@@ -2172,25 +3690,7 @@ SessionOpen62541::parseCustomDataTypes(xmlNode* node, UA_UInt16 nsIndex)
                                   << std::endl;
                 }
 
-                // Pad to align this member.
-                // Primitives are max 8 bytes long (double, void*, int64).
-                // Thus, maximal 8 byte alignment is sufficient.
-                UA_UInt32 memberAlignment = (memberSize-1) & 7; // actually alignment-1
-                if (customDataType.typeKind != UA_DATATYPEKIND_UNION) {
-                    // Align this member on top of structure so far.
-                    member.padding = memberAlignment & ~(customDataType.memSize-1);
-                    // Total size is the sum of all member sizes including padding.
-                    customDataType.memSize += member.padding + memberSize;
-                } else {
-                    // For unions padding includes the UInt32 switch field.
-                    member.padding = sizeof(UA_UInt32) + (memberAlignment & ~(sizeof(UA_UInt32)-1));
-                    // Total size is the maximum of all member sizes including padding.
-                    if (member.padding + memberSize > customDataType.memSize)
-                        customDataType.memSize = member.padding + memberSize;
-                }
-                // Align structure to largest member alignment.
-                if (memberAlignment > structureAlignment)
-                    structureAlignment = memberAlignment;
+                UA_UInt32 memberAlignment = layoutMember(customDataType, member, memberSize, structureAlignment);
                 if (debug >= 4)
                     std::cout << "  # memberSize=" << memberSize
                               << " alignment=" << memberAlignment+1
@@ -2361,10 +3861,21 @@ SessionOpen62541::connectionInactive()
     UA_Client_getConfig(client)->connectivityCheckInterval = 0;
     errlogPrintf("OPC UA Session %s: server inactive\n", name.c_str());
     markConnectionLoss();
-    clearCustomTypeDictionaries();
+    uninstallCustomTypes();
     return;
 }
 
+void
+SessionOpen62541::asyncConnectFailed ()
+{
+    if (!connectingAsync)
+        return;
+    connectingAsync = false;
+    startupFinished(false);
+    if (autoConnect)
+        autoConnector.start();
+}
+
 void
 SessionOpen62541::connectionStatusChanged (
     UA_SecureChannelState newChannelState,
@@ -2378,6 +3889,7 @@ SessionOpen62541::connectionStatusChanged (
                       << " irrecoverably failed: "
                       << UA_StatusCode_name(connectStatus)
                       << std::endl;
+        asyncConnectFailed();
         return;
     }
 
@@ -2447,7 +3959,6 @@ SessionOpen62541::connectionStatusChanged (
                 // read some settings from server
                 UA_Variant value;
                 UA_StatusCode status;
-                unsigned int max;
 
                 UA_Variant_init(&value);
 
@@ -2458,12 +3969,8 @@ SessionOpen62541::connectionStatusChanged (
                 if (status == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_UINT32]))
                     MaxNodesPerRead = *static_cast<UA_UInt32*>(value.data);
                 UA_Variant_clear(&value);
-                if (MaxNodesPerRead > 0 && readNodesMax > 0)
-                    max = std::min<unsigned int>(MaxNodesPerRead, readNodesMax);
-                else
-                    max = MaxNodesPerRead + readNodesMax;
-                if (max != readNodesMax)
-                    reader.setParams(max, readTimeoutMin, readTimeoutMax);
+                if (readBatchMax() != reader.maxRequests())
+                    reader.setParams(readBatchMax(), readTimeoutMin, readTimeoutMax);
 
                 // max nodes per write request
                 status = UA_Client_readValueAttribute(client,
@@ -2472,24 +3979,108 @@ SessionOpen62541::connectionStatusChanged (
                 if (status == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_UINT32]))
                     MaxNodesPerWrite = *static_cast<UA_UInt32*>(value.data);
                 UA_Variant_clear(&value);
-                if (MaxNodesPerWrite > 0 && writeNodesMax > 0)
-                    max = std::min<unsigned int>(MaxNodesPerWrite, writeNodesMax);
-                else
-                    max = MaxNodesPerWrite + writeNodesMax;
-                if (max != writeNodesMax)
-                    writer.setParams(max, writeTimeoutMin, writeTimeoutMax);
+                if (writeBatchMax() != writer.maxRequests())
+                    writer.setParams(writeBatchMax(), writeTimeoutMin, writeTimeoutMax);
+
+                // max nodes per browse request
+                status = UA_Client_readValueAttribute(client,
+                    UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERBROWSE)
+                    , &value);
+                if (status == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_UINT32]))
+                    MaxNodesPerBrowse = *static_cast<UA_UInt32*>(value.data);
+                UA_Variant_clear(&value);
+
+                // max nodes per register request
+                status = UA_Client_readValueAttribute(client,
+                    UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERREGISTERNODES)
+                    , &value);
+                if (status == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_UINT32]))
+                    MaxNodesPerRegisterNodes = *static_cast<UA_UInt32*>(value.data);
+                UA_Variant_clear(&value);
 
-                // namespaces
+                // max nodes per translate browse path request
                 status = UA_Client_readValueAttribute(client,
-                    UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_NAMESPACEARRAY)
+                    UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERCAPABILITIES_OPERATIONLIMITS_MAXNODESPERTRANSLATEBROWSEPATHSTONODEIDS)
                     , &value);
-                if (status == UA_STATUSCODE_GOOD && UA_Variant_hasArrayType(&value, &UA_TYPES[UA_TYPES_STRING]))
-                    updateNamespaceMap(static_cast<UA_String*>(value.data), static_cast<UA_UInt16>(value.arrayLength));
+                if (status == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_UINT32]))
+                    MaxNodesPerTranslate = *static_cast<UA_UInt32*>(value.data);
+                UA_Variant_clear(&value);
+
+#ifdef UA_NS0ID_SERVER_SERVERCAPABILITIES_MAXMONITOREDITEMSPERSUBSCRIPTION
+                // max monitored items per subscription (used by the subscription planner)
+                status = UA_Client_readValueAttribute(client,
+                    UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERCAPABILITIES_MAXMONITOREDITEMSPERSUBSCRIPTION)
+                    , &value);
+                if (status == UA_STATUSCODE_GOOD && UA_Variant_hasScalarType(&value, &UA_TYPES[UA_TYPES_UINT32]))
+                    MaxMonitoredItemsPerSubscription = *static_cast<UA_UInt32*>(value.data);
                 UA_Variant_clear(&value);
+#endif
+
+                // namespaces and server identity (for skipping unchanged setup on reconnect)
+                ReadResults server;
+                readBatched({UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_NAMESPACEARRAY),
+                             UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERSTATUS_STARTTIME),
+                             UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERSTATUS_BUILDINFO)},
+                            UA_ATTRIBUTEID_VALUE, server);
+                const UA_Variant &nsArray = server.values[0];
+                const UA_Variant &startTime = server.values[1];
+                const UA_Variant &buildInfo = server.values[2];
+                UA_UInt64 namespaceHash = 0;
+                UA_DateTime serverStart = 0;
+                UA_UInt64 typeHash = 0;
+                if (UA_Variant_hasArrayType(&nsArray, &UA_TYPES[UA_TYPES_STRING])) {
+                    updateNamespaceMap(static_cast<UA_String*>(nsArray.data), static_cast<UA_UInt16>(nsArray.arrayLength));
+                    namespaceHash = 0xcbf29ce484222325ULL;
+                    for (size_t i = 0; i < nsArray.arrayLength; i++)
+                        namespaceHash = fnv1a(namespaceHash, static_cast<UA_String*>(nsArray.data)[i]);
+                }
+                if (UA_Variant_hasScalarType(&startTime, &UA_TYPES[UA_TYPES_DATETIME]))
+                    serverStart = *static_cast<UA_DateTime*>(startTime.data);
+                if (namespaceHash && UA_Variant_hasScalarType(&buildInfo, &UA_TYPES[UA_TYPES_BUILDINFO])) {
+                    const UA_BuildInfo *bi = static_cast<UA_BuildInfo*>(buildInfo.data);
+                    typeHash = fnv1a(namespaceHash, bi->productUri);
+                    typeHash = fnv1a(typeHash, bi->softwareVersion);
+                    typeHash = fnv1a(typeHash, bi->buildNumber);
+                    typeHash = fnv1a(typeHash, &bi->buildDate, sizeof(bi->buildDate));
+                    typeHash = dictionaryVersionHash(typeHash);
+                }
+
+                // Same server instance (not restarted), unchanged namespaces and types?
+                const bool sameServer = serverStart && serverStart == serverStartTime;
+                const bool sameNamespaces = sameServer && namespaceHash && namespaceHash == serverNamespaceHash;
+                const bool sameTypes = sameNamespaces && typesLoaded && typeHash && typeHash == serverTypeHash;
+                bool sameRegistration = sameNamespaces && registrationValid;
+                // Like registrations, resolved browse paths don't survive a server restart
+                if (!sameNamespaces)
+                    clearBrowsePathTargets();
+                serverStartTime = serverStart;
+                serverNamespaceHash = namespaceHash;
+                serverTypeHash = typeHash;
+                if (resolveBrowsePaths())
+                    sameRegistration = false;
+                if (debug && sameServer)
+                    std::cout << "Session " << name
+                              << ": reconnected to same server instance; "
+                              << (sameTypes ? "reusing" : "reloading") << " data types, "
+                              << (sameRegistration ? "reusing" : "rebuilding") << " node ids"
+                              << std::endl;
 
-                readCustomTypeDictionaries();
-                rebuildNodeIds();
-                registerNodes();
+                if (sameTypes)
+                    installCustomTypes();
+                else
+                    readCustomTypeDictionaries();
+                if (!sameRegistration)
+                    rebuildNodeIds();
+                if (lazyTypes && !sameTypes)
+                    resolveItemTypes();
+                if (!sameRegistration) {
+                    registerNodes();
+                } else {
+                    registeredItemsNo = 0;
+                    for (auto it : items)
+                        if (it->isRegistered())
+                            registeredItemsNo++;
+                }
                 createAllSubscriptions();
                 if (debug) {
                     std::cout << "Session " << name
@@ -2500,7 +4091,8 @@ SessionOpen62541::connectionStatusChanged (
                 auto cargo = std::vector<std::shared_ptr<ReadRequest>>(items.size());
                 unsigned int i = 0;
                 for (auto it : items) {
-                    it->setState(ConnectionStatus::initialRead);
+                    // items with an unresolved browse path stay down (their read fails)
+                    it->setState(it->isUnresolved() ? ConnectionStatus::down : ConnectionStatus::initialRead);
                     cargo[i] = std::make_shared<ReadRequest>();
                     cargo[i]->item = it;
                     i++;
@@ -2514,13 +4106,24 @@ SessionOpen62541::connectionStatusChanged (
                 }
                 epicsThreadSleep(.1);
                 addAllMonitoredItems();
+                connectingAsync = false;
+                startupFinished(true);
+                autoConnector.reset();
                 break;
             }
 
             case UA_SESSIONSTATE_CREATED: {
                 if (sessionState == UA_SESSIONSTATE_ACTIVATED)
                     errlogPrintf("OPC UA session %s: disconnected\n", name.c_str());
-                clearCustomTypeDictionaries();
+                uninstallCustomTypes();
+                break;
+            }
+
+            case UA_SESSIONSTATE_CLOSED: {
+                // Registered nodes and subscriptions are only valid within the session
+                registrationValid = false;
+                for (auto &it : subscriptions)
+                    it.second->forgetServerIds();
                 break;
             }
 
@@ -2534,6 +4137,12 @@ void
 SessionOpen62541::readComplete (UA_UInt32 transactionId,
                             UA_ReadResponse* response)
 {
+    // The records of a read group are processed once all of them got their data
+    const bool group = outstandingGroups.erase(transactionId);
+    std::unique_ptr<ProcessingBarrier> barrier;
+    if (group)
+        barrier.reset(new ProcessingBarrier);
+
     auto it = outstandingOps.find(transactionId);
     if (it == outstandingOps.end()) {
         errlogPrintf("OPC UA session %s: (readComplete) received a callback "
@@ -2546,15 +4155,26 @@ SessionOpen62541::readComplete (UA_UInt32 transactionId,
                       << " (transaction id " << transactionId
                       << "; data for " << response->resultsSize << " items)"
                       << std::endl;
-        if ((*it->second).size() * no_of_properties_read != response->resultsSize)
+        // Map items to the nodes in the request (shared nodes) and count the users of each node
+        const std::vector<UA_UInt32> *slots = nullptr;
+        std::vector<UA_UInt32> users;
+        auto sl = outstandingReadSlots.find(transactionId);
+        if (sl != outstandingReadSlots.end()) {
+            slots = &sl->second;
+            users = slotUsers(*slots);
+        }
+        size_t nodes = slots ? users.size() : it->second->size();
+        if (nodes * no_of_properties_read != response->resultsSize)
             errlogPrintf("OPC UA session %s: (readComplete) received a callback "
-                         "with %llu values for a request containing %llu items\n",
+                         "with %llu values for a request containing %llu nodes\n",
                          name.c_str(),
                          static_cast<long long unsigned>(response->resultsSize),
-                         static_cast<long long unsigned>((*it->second).size()));
-        UA_UInt32 i = 0;
-        for (auto item : (*it->second)) {
-            if (i >= response->resultsSize) {
+                         static_cast<long long unsigned>(nodes));
+        for (size_t k = 0; k < it->second->size(); k++) {
+            ItemOpen62541 *item = (*it->second)[k];
+            UA_UInt32 slot = slots ? (*slots)[k] : static_cast<UA_UInt32>(k);
+            UA_UInt32 i = slot * no_of_properties_read;
+            if (i + 1 >= response->resultsSize) {
                 item->setIncomingEvent(ProcessReason::readFailure);
             } else {
                 const UA_DataType* type = nullptr;
@@ -2578,11 +4198,26 @@ SessionOpen62541::readComplete (UA_UInt32 transactionId,
                 ProcessReason reason = ProcessReason::readComplete;
                 if (UA_STATUS_IS_BAD(response->results[i].status))
                     reason = ProcessReason::readFailure;
-                item->setIncomingData(response->results[i], reason);
-                i++;
+                if (slots && --users[slot]) {
+                    // The item takes ownership of the data: the last user of the node gets the original
+                    UA_DataValue copy;
+                    UA_DataValue_copy(&response->results[i], &copy);
+                    item->setIncomingData(copy, reason);
+                    UA_DataValue_clear(&copy);
+                } else {
+                    item->setIncomingData(response->results[i], reason);
+                }
             }
         }
+        if (sl != outstandingReadSlots.end())
+            outstandingReadSlots.erase(sl);
         outstandingOps.erase(it);
+    } else if (isBatchTooLarge(response->responseHeader.serviceResult) && it->second->size() > 1
+               && !group) {
+        std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToRead(std::move(it->second));
+        outstandingOps.erase(it);
+        outstandingReadSlots.erase(transactionId);
+        splitReadRequest(std::move(itemsToRead), response->responseHeader.serviceResult);
     } else {
         if (debug)
             std::cout << "Session " << name
@@ -2602,6 +4237,7 @@ SessionOpen62541::readComplete (UA_UInt32 transactionId,
             item->setState(ConnectionStatus::up);
         }
         outstandingOps.erase(it);
+        outstandingReadSlots.erase(transactionId);
     }
 }
 
@@ -2609,11 +4245,31 @@ void
 SessionOpen62541::writeComplete (UA_UInt32 transactionId,
                             UA_WriteResponse* response)
 {
+    // The records of a write group complete together
+    const bool group = outstandingGroups.erase(transactionId);
+    std::unique_ptr<ProcessingBarrier> barrier;
+    if (group)
+        barrier.reset(new ProcessingBarrier);
+
+    UA_WriteRequest request;
+    UA_WriteRequest_init(&request);
+    auto wr = outstandingWrites.find(transactionId);
+    if (wr != outstandingWrites.end()) {
+        request = wr->second;
+        outstandingWrites.erase(wr);
+    }
+
     auto it = outstandingOps.find(transactionId);
     if (it == outstandingOps.end()) {
         errlogPrintf("OPC UA session %s: (writeComplete) received a callback "
                      "with unknown transaction id %u - ignored\n",
                      name.c_str(), transactionId);
+    } else if (isBatchTooLarge(response->responseHeader.serviceResult) && it->second->size() > 1
+               && request.nodesToWriteSize == it->second->size() && !group) {
+        std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToWrite(std::move(it->second));
+        outstandingOps.erase(it);
+        splitWriteRequest(std::move(itemsToWrite), request, response->responseHeader.serviceResult);
+        return; // request was handed over
     } else if (!UA_STATUS_IS_BAD(response->responseHeader.serviceResult)) {
         if (debug >= 2)
             std::cout << "Session " << name
@@ -2657,6 +4313,123 @@ SessionOpen62541::writeComplete (UA_UInt32 transactionId,
         }
         outstandingOps.erase(it);
     }
+    UA_WriteRequest_clear(&request);
+}
+
+// Warm-start file
+//
+// Keeps the last value, status and time stamps of all items with built-in
+// scalar or array data, keyed by record name and node. At IOC start, records
+// are initialized from it (with status UncertainLastUsableValue) until the
+// initial read after connecting replaces the values.
+
+static const char *warmStartMagic = "opcua-warmstart";
+static const unsigned int warmStartVersion = 1;
+
+// Timer queue (with its own thread) for writing the warm-start files periodically
+static epicsTimerQueueActive *warmStartQueue = nullptr;
+
+static std::string
+warmStartNodeKey (const linkInfo &info)
+{
+    return SB() << info.namespaceIndex << (info.identifierIsNumeric ? ";i=" : ";s=")
+                << (info.identifierIsNumeric ? std::to_string(info.identifierNumber) : info.identifierString);
+}
+
+void
+SessionOpen62541::saveWarmStart () const
+{
+    std::ostringstream os;
+    writeCacheHeader(os, warmStartMagic, warmStartVersion, { cacheLibraryTag() });
+
+    // Take the snapshot under the client lock (string values are references to the items' data)
+    std::vector<std::pair<const ItemOpen62541 *, UA_DataValue>> values;
+    {
+        Guard G(clientlock);
+        values.reserve(items.size());
+        UA_DataValue value;
+        for (const auto it : items) {
+            UA_DataValue_init(&value);
+            if (it->copyLastValue(value))
+                values.emplace_back(it, value);
+        }
+    }
+
+    unsigned int n = 0;
+    for (auto &v : values) {
+        const ItemOpen62541 *it = v.first;
+        os << "item";
+        writeToken(os, it->recConnector->getRecordName());
+        writeToken(os, warmStartNodeKey(it->linkinfo));
+        ItemOpen62541::writeWarmStartValue(os, v.second);
+        os << '\n';
+        UA_DataValue_clear(&v.second);
+        n++;
+    }
+    os << "end\n";
+
+    Guard G(warmStartLock);
+    std::string tmpfile = warmStartFile + ".tmp";
+    bool ok;
+    {
+        std::ofstream out(tmpfile, std::ios::binary | std::ios::trunc);
+        out << os.str();
+        ok = bool(out);
+    }
+    if (!ok || std::rename(tmpfile.c_str(), warmStartFile.c_str())) {
+        errlogPrintf("OPC UA session %s: can't write warm-start file %s\n", name.c_str(), warmStartFile.c_str());
+        std::remove(tmpfile.c_str());
+    } else if (debug >= 2) {
+        std::cout << "Session " << name
+                  << ": wrote " << n << " values to warm-start file " << warmStartFile << std::endl;
+    }
+}
+
+void
+SessionOpen62541::loadWarmStart ()
+{
+    std::ifstream is(warmStartFile, std::ios::binary);
+    if (!is) {
+        if (debug)
+            std::cout << "Session " << name
+                      << ": no warm-start file " << warmStartFile << std::endl;
+        return;
+    }
+
+    if (!readCacheHeader(is, warmStartMagic, warmStartVersion, { cacheLibraryTag() })) {
+        errlogPrintf("OPC UA session %s: ignoring warm-start file %s (incompatible)\n",
+                     name.c_str(), warmStartFile.c_str());
+        return;
+    }
+
+    std::map<std::string, ItemOpen62541 *> byRecord;
+    for (auto it : items)
+        byRecord.emplace(it->recConnector->getRecordName(), it);
+
+    unsigned int n = 0;
+    std::string keyword;
+    while (is >> keyword && keyword == "item") {
+        std::string record, node;
+        UA_DataValue value;
+        if (!readToken(is, record) || !readToken(is, node)
+            || !ItemOpen62541::readWarmStartValue(is, value))
+            break;
+
+        // Records that were renamed or moved to a different node are skipped
+        auto it = byRecord.find(record);
+        if (it != byRecord.end() && warmStartNodeKey(it->second->linkinfo) == node) {
+            it->second->setWarmStartData(value);
+            n++;
+        }
+        UA_DataValue_clear(&value);
+    }
+    if (keyword != "end")
+        errlogPrintf("OPC UA session %s: warm-start file %s is damaged (using %u values)\n",
+                     name.c_str(), warmStartFile.c_str(), n);
+    else if (debug)
+        std::cout << "Session " << name
+                  << ": initialized " << n << " of " << items.size()
+                  << " items from warm-start file " << warmStartFile << std::endl;
 }
 
 void
@@ -2677,6 +4450,10 @@ SessionOpen62541::showAll (const int level)
               << subscriptions << " subscription(s) and "
               << items << " items"
               << std::endl;
+    std::cout << "OPC UA: " << reconnectAttempts << " reconnect attempt(s)";
+    if (opcua_ReconnectRate > 0.0)
+        std::cout << " (" << reconnectsDelayed << " delayed by rate limit)";
+    std::cout << std::endl;
     if (level >= 1) {
         for (auto &it : sessions) {
             it.second->show(level-1);
@@ -2688,6 +4465,91 @@ SessionOpen62541::~SessionOpen62541 ()
 {
     if (client)
         disconnect(); // also deletes client
+    clearBrowsePathTargets();
+}
+
+void
+SessionOpen62541::startupFinished (bool connected)
+{
+    Guard G(startupLock);
+    if (!connectingAtStartup)
+        return;
+    connectingAtStartup = false;
+    if (connected)
+        connectTime = epicsTime::getCurrent() - connectStarted;
+    startupPending--;
+    startupDone.signal();
+}
+
+void
+SessionOpen62541::startupConnect (void *arg)
+{
+    SessionOpen62541 *session = static_cast<SessionOpen62541 *>(arg);
+    if (session->connect(false))
+        session->startupFinished(false);
+}
+
+void
+SessionOpen62541::connectAllSessions ()
+{
+    epicsTime start = epicsTime::getCurrent();
+    unsigned int total = 0;
+
+    {
+        Guard G(startupLock);
+        for (auto &it : sessions) {
+            if (it.second->autoConnect) {
+                it.second->connectingAtStartup = true;
+                it.second->connectStarted = start;
+                it.second->connectTime = -1.0;
+                startupPending++;
+                total++;
+            }
+        }
+    }
+    for (auto &it : sessions) {
+        if (it.second->autoConnect) {
+#if UA_OPEN62541_VER_MAJOR*100+UA_OPEN62541_VER_MINOR >= 101
+            // Automatic connects don't block: the worker threads complete them concurrently
+            startupConnect(it.second);
+#else
+            if (!epicsThreadCreate(("OPCcon-" + it.first).c_str(),
+                                   epicsThreadPriorityMedium,
+                                   epicsThreadGetStackSize(epicsThreadStackMedium),
+                                   startupConnect, it.second))
+                startupConnect(it.second);
+#endif
+        }
+    }
+    if (!total)
+        return;
+
+    while (opcua_ConnectDeadline > 0.0) {
+        {
+            Guard G(startupLock);
+            if (!startupPending)
+                break;
+        }
+        double remaining = opcua_ConnectDeadline - (epicsTime::getCurrent() - start);
+        if (remaining <= 0.0)
+            break;
+        startupDone.wait(remaining);
+    }
+
+    Guard G(startupLock);
+    errlogPrintf("OPC UA: %u of %u sessions connected after %.2f s\n",
+                 total - startupPending, total, epicsTime::getCurrent() - start);
+    for (auto &it : sessions) {
+        SessionOpen62541 *s = it.second;
+        if (!s->autoConnect)
+            continue;
+        if (s->connectTime >= 0.0)
+            errlogPrintf("  %-20s connected in %.3f s\n", it.first.c_str(), s->connectTime);
+        else if (s->connectingAtStartup)
+            errlogPrintf("  %-20s still connecting\n", it.first.c_str());
+        else
+            errlogPrintf("  %-20s not connected (%s)\n", it.first.c_str(), UA_StatusCode_name(s->connectStatus));
+    }
 }
 
 void
@@ -2699,9 +4561,23 @@ SessionOpen62541::initHook (initHookState state)
         errlogPrintf("OPC UA: Autoconnecting sessions\n");
         for (auto &it : sessions) {
             it.second->markConnectionLoss();
-            if (it.second->autoConnect)
-                it.second->connect(false);
+            if (it.second->warmStartEnabled()) {
+                it.second->loadWarmStart();
+                if (it.second->warmStartPeriod > 0) {
+                    // File I/O must not delay the reconnect and group timers on the shared queue
+                    if (!warmStartQueue)
+                        warmStartQueue = &epicsTimerQueueActive::allocate(false, epicsThreadPriorityLow);
+                    it.second->warmStartTimer.reset(
+                        new WarmStartTimer(*it.second, it.second->warmStartPeriod, warmStartQueue));
+                    it.second->warmStartTimer->start();
+                }
+            }
+            if (it.second->readGroups.size() || it.second->writeGroups.size()) {
+                it.second->groupTimer.reset(new GroupTimer(*it.second, queue));
+                it.second->groupTimer->start();
+            }
         }
+        connectAllSessions();
         epicsThreadOnce(&DevOpcua::session_open62541_atexit_once, &DevOpcua::session_open62541_atexit_register, nullptr);
         break;
     }
@@ -2715,6 +4591,11 @@ SessionOpen62541::atExit (void *)
 {
     errlogPrintf("OPC UA: Disconnecting sessions\n");
     for (auto &it : sessions) {
+        if (it.second->warmStartEnabled()) {
+            it.second->warmStartTimer.reset();
+            it.second->saveWarmStart();
+        }
+        it.second->groupTimer.reset();
         it.second->disconnect();
         SessionOpen62541 *session = it.second;
         if (session->isConnected())
@@ -15,11 +15,14 @@
 
 #include "OpcuaRegistry.h"
 #include "RequestQueueBatcher.h"
+#include "LruCache.h"
 #include "Session.h"
 
 #include <epicsMutex.h>
 #include <epicsTypes.h>
 #include <epicsThread.h>
+#include <epicsEvent.h>
+#include <epicsTime.h>
 #include <initHooks.h>
 
 #include <open62541/client.h>
@@ -43,6 +46,8 @@
 #include <map>
 #include <unordered_map>
 #include <memory>
+#include <algorithm>
+#include <cstring>
 
 namespace std {
 
@@ -71,6 +76,92 @@ namespace DevOpcua {
 
 class SubscriptionOpen62541;
 class ItemOpen62541;
+
+/**
+ * @brief Strict weak ordering of node ids (independent of the open62541 version).
+ */
+struct NodeIdLess
+{
+    bool operator()(const UA_NodeId &a, const UA_NodeId &b) const noexcept
+    {
+        if (a.namespaceIndex != b.namespaceIndex)
+            return a.namespaceIndex < b.namespaceIndex;
+        if (a.identifierType != b.identifierType)
+            return a.identifierType < b.identifierType;
+        switch (a.identifierType) {
+        case UA_NODEIDTYPE_NUMERIC:
+            return a.identifier.numeric < b.identifier.numeric;
+        case UA_NODEIDTYPE_GUID:
+            return std::memcmp(&a.identifier.guid, &b.identifier.guid, sizeof(UA_Guid)) < 0;
+        default: // string, byte string
+            if (a.identifier.string.length != b.identifier.string.length)
+                return a.identifier.string.length < b.identifier.string.length;
+            return a.identifier.string.length
+                    && std::memcmp(a.identifier.string.data, b.identifier.string.data,
+                                   a.identifier.string.length) < 0;
+        }
+    }
+};
+
+/**
+ * @brief Lexicographical ordering of node id vectors.
+ */
+struct NodeIdsLess
+{
+    bool operator()(const std::vector<UA_NodeId> &a, const std::vector<UA_NodeId> &b) const noexcept
+    {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), NodeIdLess());
+    }
+};
+
+/**
+ * @brief Sorted set of the distinct node ids of a batch (key of prepared reads).
+ *
+ * @param nodeIds  node ids of the items in any order (shallow copies)
+ * @return sorted distinct node ids (shallow copies)
+ */
+inline std::vector<UA_NodeId>
+sortedNodeSet (std::vector<UA_NodeId> nodeIds)
+{
+    std::sort(nodeIds.begin(), nodeIds.end(), NodeIdLess());
+    nodeIds.erase(std::unique(nodeIds.begin(), nodeIds.end(), std::equal_to<UA_NodeId>()), nodeIds.end());
+    return nodeIds;
+}
+
+/**
+ * @brief Node (result) index of every item of a batch in its request.
+ *
+ * @param nodeIds  node ids of the items
+ * @param nodeSet  sorted distinct node ids of the batch (see sortedNodeSet)
+ * @return index into nodeSet for every item
+ */
+inline std::vector<UA_UInt32>
+nodeSlots (const std::vector<UA_NodeId> &nodeIds, const std::vector<UA_NodeId> &nodeSet)
+{
+    std::vector<UA_UInt32> slots(nodeIds.size());
+    for (size_t k = 0; k < nodeIds.size(); k++)
+        slots[k] = static_cast<UA_UInt32>(std::lower_bound(nodeSet.begin(), nodeSet.end(),
+                                                           nodeIds[k], NodeIdLess()) - nodeSet.begin());
+    return slots;
+}
+
+/**
+ * @brief Number of items sharing each node of a request.
+ *
+ * @param slots  node index of every item (see nodeSlots)
+ * @return number of items for every node index
+ */
+inline std::vector<UA_UInt32>
+slotUsers (const std::vector<UA_UInt32> &slots)
+{
+    std::vector<UA_UInt32> users;
+    if (slots.size())
+        users.resize(*std::max_element(slots.begin(), slots.end()) + 1);
+    for (auto slot : slots)
+        users[slot]++;
+    return users;
+}
+
 struct WriteRequest;
 struct ReadRequest;
 
@@ -79,6 +170,40 @@ struct ReadRequest;
  */
 enum RequestedSecurityMode { Best, None, Sign, SignAndEncrypt };
 
+/**
+ * @brief Read request contents prepared for a recurring set of nodes.
+ *
+ * Indexed by the sorted set of node ids, so that batches of the same items
+ * in a different order share it. The node ids are shallow copies of the
+ * items' node ids, so all prepared reads are dropped whenever node ids change.
+ */
+struct PreparedRead
+{
+    std::vector<UA_ReadValueId> nodesToRead;   /**< read operations (shallow node ids) */
+};
+
+/**
+ * @brief Read group: items that are read together in a single Read service call.
+ */
+struct ReadGroup
+{
+    std::vector<ItemOpen62541 *> members;      /**< items of the group */
+    std::vector<ItemOpen62541 *> pending;      /**< members that requested a read since the last group read */
+    epicsTime since;                           /**< time of the first pending request */
+    UA_UInt64 reads = 0;                       /**< number of group reads */
+    UA_UInt64 partialReads = 0;                /**< number of group reads without all members */
+};
+
+/**
+ * @brief Write group: writes that are staged until a commit write sends them together.
+ */
+struct WriteGroup
+{
+    std::vector<std::shared_ptr<WriteRequest>> staged;  /**< staged writes */
+    epicsTime since;                                    /**< time of the first staged write */
+    UA_UInt64 commits = 0;                              /**< number of group writes */
+};
+
 // print some UA types
 
 inline std::ostream& operator << (std::ostream& os, const UA_String& ua_string)
@@ -211,6 +336,8 @@ public:
     /**
      * @brief Request a beginRead service for an item
      *
+     * Items of a read group are read once all members of the group requested a read.
+     *
      * @param item  item to request beginRead for
      */
     void requestRead(ItemOpen62541 &item);
@@ -218,6 +345,9 @@ public:
     /**
      * @brief Request a beginWrite service for an item
      *
+     * Writes of a write group are staged until a write with the commit option
+     * sends them together in one request.
+     *
      * @param item  item to request beginWrite for
      */
     void requestWrite(ItemOpen62541 &item);
@@ -273,6 +403,12 @@ public:
      */
     virtual void addNamespaceMapping(const unsigned short nsIndex, const std::string &uri) override;
 
+    /**
+     * @brief Check if the session keeps a warm-start file.
+     * @return true if enabled
+     */
+    bool warmStartEnabled() const { return warmStartFile.size(); }
+
     unsigned int noOfSubscriptions() const { return static_cast<unsigned int>(subscriptions.size()); }
     unsigned int noOfItems() const { return static_cast<unsigned int>(items.size()); }
 
@@ -299,6 +435,16 @@ public:
      */
     UA_UInt16 mapNamespaceIndex(const UA_UInt16 nsIndex) const;
 
+    /**
+     * @brief Get the node id that a link's browse path was resolved to.
+     *
+     * @param info  link configuration (with browse path)
+     * @param[out] nodeId  resolved node id (copy)
+     *
+     * @return true if the browse path has been resolved
+     */
+    bool getBrowsePathTarget(const linkInfo &info, UA_NodeId &nodeId) const;
+
     /**
      * @brief EPICS IOC Database initHook function.
      *
@@ -309,6 +455,17 @@ public:
      */
     static void initHook(initHookState state);
 
+    /**
+     * @brief Connect all sessions with autoConnect=true concurrently.
+     *
+     * Called at IOC start. All connects are started asynchronously (with
+     * client libraries before 1.1, each from its own short-lived thread).
+     * Waits until all sessions are up or failed, at most opcua_ConnectDeadline
+     * seconds (not at all if <= 0), then prints a report of the per-session
+     * connect times.
+     */
+    static void connectAllSessions();
+
     /**
      * @brief EPICS IOC Database atExit function.
      *
@@ -348,16 +505,243 @@ public:
                                         const int debug = 0);
 
 private:
+    /**
+     * @brief Send a read request for a batch of items (clientlock must be held).
+     *
+     * A read group is never split: if the server rejects it as too large,
+     * all its members fail.
+     *
+     * @param itemsToRead  items to read
+     * @param group  true if the items are a read group
+     */
+    void sendReadRequest(std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToRead,
+                         const bool group = false);
+
+    /**
+     * @brief Prepare the read operations for a set of nodes.
+     *
+     * @param nodeSet  sorted distinct node ids (see sortedNodeSet)
+     * @param[out] prepared  read request contents
+     */
+    static void prepareRead(const std::vector<UA_NodeId> &nodeSet, PreparedRead &prepared);
+
+    /**
+     * @brief Create the read request for the pending members of a read group
+     * (readGroupsLock must be held).
+     *
+     * @param group  read group
+     * @return request cargo (pending members are cleared)
+     */
+    std::shared_ptr<ReadRequest> readGroupRequest(ReadGroup &group);
+
+    /**
+     * @brief Read the pending members of read groups that have been waiting
+     * longer than the hold time (e.g., a member is disabled or on another scan).
+     *
+     * @param hold  hold time [s]
+     */
+    void flushReadGroups(const double hold);
+
+    /**
+     * @brief Drop the staged writes of write groups that have been waiting
+     * for a commit longer than the writegroup-timeout option (records fail their writes).
+     */
+    void expireWriteGroups();
+
+    /**
+     * @brief Split a read batch that the server rejected as too large and resend the halves.
+     *
+     * Also lowers the session's learned read batch size.
+     *
+     * @param itemsToRead  items of the rejected batch
+     * @param status  status that rejected the batch
+     */
+    void splitReadRequest(std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToRead,
+                          UA_StatusCode status);
+
+    /**
+     * @brief Send a write request for a batch of items (clientlock must be held).
+     *
+     * A write group is never split: if the server rejects it as too large,
+     * all its members fail.
+     *
+     * @param itemsToWrite  items to write
+     * @param request  write request (ownership is taken)
+     * @param group  true if the items are a write group
+     */
+    void sendWriteRequest(std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToWrite,
+                          UA_WriteRequest &request,
+                          const bool group = false);
+
+    /**
+     * @brief Split a write batch that the server rejected as too large and resend the halves.
+     *
+     * Also lowers the session's learned write batch size.
+     *
+     * @param itemsToWrite  items of the rejected batch
+     * @param request  write request of the rejected batch (ownership is taken)
+     * @param status  status that rejected the batch
+     */
+    void splitWriteRequest(std::unique_ptr<std::vector<ItemOpen62541 *>> itemsToWrite,
+                           UA_WriteRequest &request,
+                           UA_StatusCode status);
+
+    /**
+     * @brief Fail the requests of items that were taken out of a batch
+     * because of an unresolved browse path.
+     *
+     * Items without a browse path target get the status BadNoMatch.
+     *
+     * @param unresolved  items to fail
+     * @param reason  readFailure or writeFailure
+     */
+    static void failUnresolved(const std::vector<ItemOpen62541 *> &unresolved, const ProcessReason reason);
+
+    /**
+     * @brief Check if a status means that a request had too many nodes.
+     * @param status  service result
+     * @return true for BadTooManyOperations and encoding/size limit errors
+     */
+    static bool isBatchTooLarge(const UA_StatusCode status);
+
+    /** @brief Effective max number of nodes per read request (0 = no limit). */
+    unsigned int readBatchMax() const;
+
+    /** @brief Effective max number of nodes per write request (0 = no limit). */
+    unsigned int writeBatchMax() const;
+
+    /** @brief Items of one outstanding RegisterNodes request. */
+    struct RegisterNodesChunk {
+        SessionOpen62541 *session;
+        UA_UInt32 generation;                /**< registrationGeneration at time of request */
+        std::vector<ItemOpen62541 *> items;  /**< items in request order */
+    };
+
     /**
      * @brief Register all nodes that are configured to be registered.
+     *
+     * Sends asynchronous RegisterNodes requests, split according to
+     * the server's MaxNodesPerRegisterNodes. Items keep using their
+     * original node ids until the response arrives.
      */
     void registerNodes();
 
+    /**
+     * @brief Process the response to a RegisterNodes request.
+     * @param chunk  items of the request (ownership is taken)
+     * @param response  RegisterNodes response
+     */
+    void registerNodesComplete(RegisterNodesChunk *chunk, const UA_RegisterNodesResponse *response);
+
+    /**
+     * @brief Check if an item should be registered.
+     *
+     * Items are registered if their link has the 'register' option set.
+     * With the session option 'register-nodes=auto', items with
+     * non-numeric node ids that are read or written (not monitored) are
+     * registered as well.
+     *
+     * @param item  item to check
+     * @return true if the item should be registered
+     */
+    bool isRegisterCandidate(const ItemOpen62541 &item) const;
+
     /**
      * @brief Rebuild nodeIds for all nodes that were registered.
      */
     void rebuildNodeIds();
 
+    /**
+     * @brief Resolve the browse paths of all items that are not resolved yet.
+     *
+     * Synchronous; uses TranslateBrowsePathsToNodeIds requests split according
+     * to the server's MaxNodesPerTranslateBrowsePathsToNodeIds. Results are kept
+     * until the server's namespace array changes.
+     *
+     * @return true if any browse path was newly resolved
+     */
+    bool resolveBrowsePaths();
+
+    /**
+     * @brief Discard all resolved browse paths.
+     */
+    void clearBrowsePathTargets();
+
+    /**
+     * @brief Key of a link's browse path in the browse path cache.
+     * @param info  link configuration (with browse path)
+     * @return starting node and browse path as string
+     */
+    static std::string browsePathKey(const linkInfo &info);
+
+    /** @brief References found by browseBatched(), per browsed node (owned). */
+    struct BrowseResults {
+        std::vector<std::vector<UA_ReferenceDescription>> references;
+        BrowseResults() = default;
+        BrowseResults(const BrowseResults &) = delete;
+        BrowseResults &operator=(const BrowseResults &) = delete;
+        ~BrowseResults() { clear(); }
+        void clear() {
+            for (auto &refs : references)
+                for (auto &ref : refs)
+                    UA_ReferenceDescription_clear(&ref);
+            references.clear();
+        }
+    };
+
+    /** @brief Values read by readBatched(), per node (owned; empty if failed). */
+    struct ReadResults {
+        std::vector<UA_Variant> values;
+        ReadResults() = default;
+        ReadResults(const ReadResults &) = delete;
+        ReadResults &operator=(const ReadResults &) = delete;
+        ~ReadResults() { clear(); }
+        void clear() {
+            for (auto &value : values)
+                UA_Variant_clear(&value);
+            values.clear();
+        }
+    };
+
+    /**
+     * @brief Browse many nodes, following continuation points.
+     *
+     * Synchronous; requests are split according to the server's MaxNodesPerBrowse.
+     *
+     * @param nodes  nodes to browse
+     * @param direction  browse direction
+     * @param referenceTypeId  reference type (including subtypes)
+     * @param[out] results  references for each node (in order of nodes)
+     */
+    void browseBatched(const std::vector<UA_NodeId> &nodes,
+                       const UA_BrowseDirection direction,
+                       const UA_NodeId &referenceTypeId,
+                       BrowseResults &results);
+
+    /**
+     * @brief Read one attribute of many nodes.
+     *
+     * Synchronous; requests are split according to the server's MaxNodesPerRead.
+     *
+     * @param nodes  nodes to read
+     * @param attributeId  attribute to read
+     * @param[out] results  values for each node (in order of nodes)
+     */
+    void readBatched(const std::vector<UA_NodeId> &nodes,
+                     const UA_UInt32 attributeId,
+                     ReadResults &results);
+
+    /**
+     * @brief Add the versions of the server's type dictionaries to a hash.
+     *
+     * Uses the DataTypeVersion and NodeVersion properties of the dictionaries,
+     * or the dictionary contents for dictionaries that have neither.
+     *
+     * @param hash  hash to extend
+     * @return  extended hash
+     */
+    UA_UInt64 dictionaryVersionHash(UA_UInt64 hash);
+
     /**
      * @brief Rebuild the namespace index map from the server's array.
      */
@@ -374,6 +758,83 @@ private:
      */
     void markConnectionLoss();
 
+    /**
+     * @brief Initialize items from the warm-start file (values are marked stale).
+     */
+    void loadWarmStart();
+
+    /**
+     * @brief Write the last values of all items to the warm-start file.
+     */
+    void saveWarmStart() const;
+
+    /** @brief Timer writing the warm-start file periodically. */
+    class WarmStartTimer : public epicsTimerNotify {
+    public:
+        WarmStartTimer(SessionOpen62541 &session, const double period, epicsTimerQueueActive *queue)
+            : timer(queue->createTimer())
+            , session(session)
+            , period(period)
+        {}
+        virtual ~WarmStartTimer() override { timer.destroy(); }
+        void start() { timer.start(*this, period); }
+        virtual expireStatus expire(const epicsTime &/*currentTime*/) override {
+            session.saveWarmStart();
+            return expireStatus(restart, period);
+        }
+    private:
+        epicsTimer &timer;
+        SessionOpen62541 &session;
+        const double period;
+    };
+
+    /** @brief Timer reading incomplete read groups and expiring uncommitted write groups. */
+    class GroupTimer : public epicsTimerNotify {
+    public:
+        GroupTimer(SessionOpen62541 &session, epicsTimerQueueActive *queue)
+            : timer(queue->createTimer())
+            , session(session)
+        {}
+        virtual ~GroupTimer() override { timer.destroy(); }
+        void start() { timer.start(*this, session.readGroupHold()); }
+        virtual expireStatus expire(const epicsTime &/*currentTime*/) override {
+            double hold = session.readGroupHold();
+            session.flushReadGroups(hold);
+            session.expireWriteGroups();
+            return expireStatus(restart, hold);
+        }
+    private:
+        epicsTimer &timer;
+        SessionOpen62541 &session;
+    };
+
+    /**
+     * @brief Time after which an incomplete read group is read [s]:
+     * the reader's maximal hold-off, at least readGroupHoldMin.
+     */
+    double readGroupHold() const;
+
+    /**
+     * @brief Body of the short-lived connect threads started at IOC start.
+     * @param arg  session (SessionOpen62541 *)
+     */
+    static void startupConnect(void *arg);
+
+    /**
+     * @brief Mark the IOC-start connection attempt of this session as finished.
+     * @param connected  true if the session is up
+     */
+    void startupFinished(bool connected);
+
+    /**
+     * @brief Handle the failure of an asynchronous connect (restart autoconnect timer).
+     */
+    void asyncConnectFailed();
+
+    static epicsMutex startupLock;                                /**< lock for IOC-start connection bookkeeping */
+    static epicsEvent startupDone;                                /**< signalled when a session finished connecting */
+    static unsigned int startupPending;                           /**< number of sessions still connecting at IOC start */
+
     /**
      * @brief Read user/pass or cert/key/pass credentials from credentials file.
      */
@@ -407,8 +868,16 @@ private:
     std::map<std::string, SubscriptionOpen62541*> subscriptions;  /**< subscriptions on this session */
     std::vector<ItemOpen62541 *> items;                           /**< items on this session */
     UA_UInt32 registeredItemsNo;                                  /**< number of registered items */
+    bool registerAuto;                                            /**< register items with non-numeric node ids automatically */
+    UA_UInt32 registrationGeneration;                             /**< incremented when node ids are rebuilt */
+    UA_UInt64 readBytesSaved;                                     /**< request bytes saved by registration (reads) */
+    UA_UInt64 readRequestsNo;                                     /**< number of read requests sent */
+    UA_UInt64 readNodesShared;                                    /**< read operations saved by items sharing a node */
+    UA_UInt64 writeBytesSaved;                                    /**< request bytes saved by registration (writes) */
+    UA_UInt64 writeRequestsNo;                                    /**< number of write requests sent */
     std::map<std::string, UA_UInt16> namespaceMap;                /**< local namespace map (URI->index) */
     std::map<UA_UInt16, UA_UInt16> nsIndexMap;                    /**< namespace index map (local->server-side) */
+    std::map<std::string, UA_NodeId> browsePathTargets;           /**< resolved browse paths (key->node id) */
 
     ClientSecurityInfo securityInfo;                              /**< security metadata */
     unsigned int securityLevel;                                   /**< actual security level */
@@ -418,6 +887,18 @@ private:
     int transactionId;                                            /**< next transaction id */
     /** itemOpen62541 vectors of outstanding read or write operations, indexed by transaction id */
     std::map<UA_UInt32, std::unique_ptr<std::vector<ItemOpen62541 *>>> outstandingOps;
+    /** write requests of outstanding write operations (kept for splitting), indexed by transaction id */
+    std::map<UA_UInt32, UA_WriteRequest> outstandingWrites;
+    /** node (result) index of every item of outstanding reads with shared nodes, indexed by transaction id */
+    std::map<UA_UInt32, std::vector<UA_UInt32>> outstandingReadSlots;
+    /** transaction ids of outstanding read or write group operations (completed together) */
+    std::set<UA_UInt32> outstandingGroups;
+    /** read requests prepared for recurring batches, indexed by the items of the batch */
+    LruCache<std::vector<UA_NodeId>, PreparedRead, NodeIdsLess> preparedReads;
+    std::map<std::string, ReadGroup> readGroups;                  /**< read groups, indexed by name */
+    epicsMutex readGroupsLock;                                    /**< lock for readGroups */
+    std::map<std::string, WriteGroup> writeGroups;                /**< write groups, indexed by name */
+    epicsMutex writeGroupsLock;                                   /**< lock for writeGroups */
 
     RequestQueueBatcher<WriteRequest> writer;                     /**< batcher for write requests */
     unsigned int writeNodesMax;                                   /**< max number of nodes per write request */
@@ -427,16 +908,42 @@ private:
     unsigned int readNodesMax;                                    /**< max number of nodes per read request */
     unsigned int readTimeoutMin;                                  /**< timeout after read request batch of 1 node [ms] */
     unsigned int readTimeoutMax;                                  /**< timeout after read request batch of NodesMax nodes [ms] */
+    unsigned int learnedReadNodesMax;                             /**< max number of nodes per read request learned from errors */
+    unsigned int learnedWriteNodesMax;                            /**< max number of nodes per write request learned from errors */
+    unsigned int preparedReadsMax;                                /**< max number of prepared reads (0 = off) */
+    UA_UInt64 preparedReadsUsed;                                  /**< number of read requests sent from prepared reads */
 
     /** open62541 interfaces */
     UA_Client *client;                                            /**< low level handle for this session */
-    epicsMutex clientlock;                                        /**< lock for client implementation */
+    mutable epicsMutex clientlock;                                /**< lock for client implementation */
     UA_SecureChannelState channelState;                           /**< status for this session */
     UA_SessionState sessionState;                                 /**< status for this session */
     UA_StatusCode connectStatus;                                  /**< status for this session */
     unsigned int MaxNodesPerRead;                                 /**< server max number of nodes per write request */
     unsigned int MaxNodesPerWrite;                                /**< server max number of nodes per write request */
+    unsigned int MaxNodesPerBrowse;                               /**< server max number of nodes per browse request */
+    unsigned int MaxNodesPerRegisterNodes;                        /**< server max number of nodes per register request */
+    unsigned int MaxNodesPerTranslate;                            /**< server max number of nodes per translate browse path request */
+    unsigned int MaxMonitoredItemsPerSubscription;                /**< server max number of monitored items per subscription */
     epicsThread *workerThread;                                    /**< Asynchronous worker thread */
+    bool connectingAsync;                                         /**< asynchronous connect in progress */
+    bool connectingAtStartup;                                     /**< IOC-start connection attempt in progress */
+    epicsTime connectStarted;                                     /**< start of IOC-start connection attempt */
+    double connectTime;                                           /**< time to connect at IOC start [s] (<0 = not connected) */
+    std::string warmStartFile;                                    /**< warm-start file (empty = off) */
+    double warmStartPeriod;                                       /**< warm-start file write period [s] (0 = at exit only) */
+    std::unique_ptr<WarmStartTimer> warmStartTimer;               /**< periodic writer of the warm-start file */
+    std::unique_ptr<GroupTimer> groupTimer;                       /**< periodic check of read and write groups */
+    double writeGroupTimeout;                                     /**< max time staged writes wait for a commit [s] (0 = forever) */
+    mutable epicsMutex warmStartLock;                             /**< lock for writing the warm-start file */
+    bool lazyTypes;                                               /**< resolve only the data types used by items */
+    UA_UInt64 serverNamespaceHash;                                /**< hash of the server's NamespaceArray at last activation */
+    UA_DateTime serverStartTime;                                  /**< server StartTime at last activation */
+    UA_UInt64 serverTypeHash;                                     /**< hash of NamespaceArray and BuildInfo at last activation */
+    bool registrationValid;                                       /**< node ids (and registrations) are valid for the current session */
+    bool typesLoaded;                                             /**< custom types have been read from the server */
+    bool typesInstalled;                                          /**< custom types are installed in the client */
+    std::string typeCacheDir;                                     /**< directory for cached type dictionaries (empty = off) */
 
 #ifdef HAS_XMLPARSER
     /** open62541 type dictionary handling */
@@ -444,15 +951,20 @@ private:
     std::map<std::string, UA_NodeId> binaryTypeIds;               /**< server defined binary ids of custom types */
     std::unordered_map<UA_NodeId, EnumChoices> enumTypes;         /**< all the enum definitions from the server */
     void readCustomTypeDictionaries();                            /**< read custom types from the server */
+    void resolveItemTypes();                                      /**< resolve custom types used by items (lazy mode) */
+    void installCustomTypes();                                    /**< resolve member type pointers, add types to client */
     void clearCustomTypeDictionaries();                           /**< clear old custom types */
+    void uninstallCustomTypes();                                  /**< remove custom types from the client (keeping them) */
     void parseCustomDataTypes(xmlNode* node, UA_UInt16 nsIndex);  /**< parse XML representation of custom types */
     size_t getTypeIndexByName(UA_UInt16 nsIndex, const char* typeName);
-    UA_StatusCode typeSystemIteratorCallback(const UA_NodeId& dictNodeId);
-    UA_StatusCode enumIteratorCallback(const UA_NodeId& childId, const UA_NodeId& referenceTypeId);
-    UA_StatusCode enumChoiceIteratorCallback(const UA_NodeId& childId, const UA_NodeId& referenceTypeId, EnumChoices& enumChoices);
-    UA_StatusCode dictIteratorCallback(const UA_NodeId& childId, const UA_NodeId& referenceTypeId);
-    UA_StatusCode typeIteratorCallback(const UA_NodeId& childId, const UA_NodeId& referenceTypeId, const UA_QualifiedName& typeName);
+    void readEnumTypes();                                         /**< read all enum types (batched browse) */
+    void readTypeDictionaries();                                  /**< read and parse all type dictionaries (batched browse) */
+    void addBinaryEncodingId(const UA_NodeId& encodingId, const UA_QualifiedName& typeName);
     void showCustomDataTypes(int level) const;
+    std::string typeCacheFingerprint(std::string &serverUri);     /**< identify server type system (empty = unknown) */
+    std::string typeCacheFile(const std::string &serverUri) const;
+    bool loadTypeCache(const std::string &serverUri, const std::string &fingerprint);
+    void saveTypeCache(const std::string &serverUri, const std::string &fingerprint) const;
 #endif
 };
 
@@ -57,6 +57,12 @@ const char Subscription::optionUsage[]
     = "Valid subscription options are:\n"
       "debug              debug level [default 0 = no debug]\n"
       "priority           priority level [default 0(lowest) .. 255]\n"
+      "publishing-interval  publishing interval [ms] (changes a running subscription)\n"
+      "sampling, qsize, discard, deadband  change all monitored items at runtime\n"
+      "idle               mode of monitored items without interest [off/sampling/disabled; default off]\n"
+      "idle-check         period of the interest check [s; default 1]\n"
+      "plan               split into several server subscriptions [default n]\n"
+      "items-max          max. monitored items per server subscription (plan=y) [0 = no limit]\n"
       "";
 
 } // namespace DevOpcua
@@ -16,15 +16,21 @@
 #include "OpcuaRegistry.h"
 #include "RecordConnector.h"
 #include "devOpcua.h"
+#include "linkParser.h"
 
 #include <errlog.h>
+#include <epicsStdlib.h>
+#include <epicsMutex.h>
 
 #include <open62541/client_subscriptions.h>
 
 #include <iostream>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
+#include <stdexcept>
+#include <cmath>
 
 // Note: No guard needed for UA_Client_* functions calls because SubscriptionOpen62541 methods
 // are either called by UA_Client_run_iterate via SessionOpen62541::connectionStatusChanged
@@ -41,6 +47,10 @@ SubscriptionOpen62541::SubscriptionOpen62541 (const std::string &name, SessionOp
     //TODO: add runtime support for subscription enable/disable
     , requestedSettings(UA_CreateSubscriptionRequest_default())
     , enable(true)
+    , plan(false)
+    , itemsMax(0)
+    , idleMode(UA_MONITORINGMODE_REPORTING)
+    , idleCheck(1.0)
 {
     UA_CreateSubscriptionResponse_init(&subscriptionSettings);
     // keep the default timeout
@@ -65,15 +75,54 @@ void SubscriptionOpen62541::setOption(const std::string &name, const std::string
         debug = ul;
     } else if (name == "priority") {
         unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
-        if (ul > 255ul)
+        if (ul > 255ul) {
             errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
-        else
+        } else {
             requestedSettings.priority = static_cast<UA_Byte>(ul);
+            modifySubscription();
+        }
+    } else if (name == "publishing-interval") {
+        double interval = std::strtod(value.c_str(), nullptr);
+        if (interval <= 0.0) {
+            errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
+        } else {
+            // keep the lifetime (timeout) of the subscription
+            double timeout = requestedSettings.requestedPublishingInterval * requestedSettings.requestedLifetimeCount;
+            requestedSettings.requestedPublishingInterval = interval;
+            requestedSettings.requestedLifetimeCount = std::max(3 * requestedSettings.requestedMaxKeepAliveCount,
+                                                                static_cast<UA_UInt32>(timeout / interval));
+            modifySubscription();
+        }
+    } else if (name == "sampling" || name == "qsize" || name == "discard" || name == "deadband") {
+        modifyMonitoredItems(std::vector<Item *>(items.begin(), items.end()), {{name, value}});
+    } else if (name == "idle") {
+        if (value == "off")
+            idleMode = UA_MONITORINGMODE_REPORTING;
+        else if (value == "sampling")
+            idleMode = UA_MONITORINGMODE_SAMPLING;
+        else if (value == "disabled")
+            idleMode = UA_MONITORINGMODE_DISABLED;
+        else
+            errlogPrintf("invalid idle mode (valid: off sampling disabled)\n");
+    } else if (name == "idle-check") {
+        double period = std::strtod(value.c_str(), nullptr);
+        if (period <= 0.0)
+            errlogPrintf("option '%s' value out of range - ignored\n", name.c_str());
+        else
+            idleCheck = period;
+    } else if (name == "plan") {
+        if (value.length() > 0)
+            plan = getYesNo(value[0]);
+    } else if (name == "items-max") {
+        unsigned long ul = std::strtoul(value.c_str(), nullptr, 0);
+        itemsMax = static_cast<UA_UInt32>(ul);
     } else {
         errlogPrintf("unknown option '%s' - ignored\n", name.c_str());
     }
 }
 
+static const char *recordPriorityNames[menuPriority_NUM_CHOICES] = { "LOW", "MEDIUM", "HIGH" };
+
 void
 SubscriptionOpen62541::show (int level) const
 {
@@ -86,9 +135,35 @@ SubscriptionOpen62541::show (int level) const
               << "(" << (enable ? "Y" : "N") << ")"
               << " debug=" << debug
               << " items=" << items.size()
-              << std::endl;
+              << " monitored=" << monitoredNodes.size()
+              << " plan=" << (plan ? "y" : "n");
+    if (idleMode != UA_MONITORINGMODE_REPORTING) {
+        size_t idle = 0;
+        for (const auto &node : monitoredNodes)
+            if (node.mode != (node.triggeredBy ? UA_MONITORINGMODE_SAMPLING : UA_MONITORINGMODE_REPORTING))
+                idle++;
+        std::cout << " idle=" << (idleMode == UA_MONITORINGMODE_SAMPLING ? "sampling" : "disabled")
+                  << "(" << idle << ")";
+    }
+    size_t triggered = 0;
+    for (const auto &node : monitoredNodes)
+        if (node.triggeredBy)
+            triggered++;
+    if (triggered)
+        std::cout << " triggered=" << triggered;
+    if (plan)
+        std::cout << " shards=" << shards.size();
+    std::cout << std::endl;
 
     if (level >= 1) {
+        for (const auto &shard : shards) {
+            std::cout << "  shard id=" << shard.subscriptionId
+                      << " interval=" << shard.publishingInterval
+                      << " prio=" << static_cast<int>(shard.priority)
+                      << "(" << recordPriorityNames[shard.recordPriority] << ")"
+                      << " monitored=" << shard.nodes
+                      << std::endl;
+        }
         for (auto &it : items) {
             it->show(level-1);
         }
@@ -122,87 +197,750 @@ SubscriptionOpen62541::getSessionOpen62541 () const
 }
 
 void
-SubscriptionOpen62541::create ()
+SubscriptionOpen62541::createOnServer (const UA_CreateSubscriptionRequest &request,
+                                       UA_CreateSubscriptionResponse &response,
+                                       const std::string &what)
 {
-    subscriptionSettings = UA_Client_Subscriptions_create(session.client,
-        requestedSettings, this, [] (UA_Client *client, UA_UInt32 subscriptionId,
+    response = UA_Client_Subscriptions_create(session.client,
+        request, this, [] (UA_Client *client, UA_UInt32 subscriptionId,
             void *context, UA_StatusChangeNotification *notification) {
                 static_cast<SubscriptionOpen62541*>(context)->
                     subscriptionStatusChanged(notification->status);
             }, NULL);
-    if (subscriptionSettings.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
-        errlogPrintf("OPC UA subscription %s: createSubscription on session %s failed (%s)\n",
-                    name.c_str(), session.getName().c_str(),
-                    UA_StatusCode_name(subscriptionSettings.responseHeader.serviceResult));
+    if (response.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+        errlogPrintf("OPC UA subscription %s%s: createSubscription on session %s failed (%s)\n",
+                    name.c_str(), what.c_str(), session.getName().c_str(),
+                    UA_StatusCode_name(response.responseHeader.serviceResult));
+        response.subscriptionId = 0;
     } else {
         if (debug)
-            errlogPrintf("OPC UA subscription %s on session %s created (%s)\n",
-                    name.c_str(), session.getName().c_str(),
-                    UA_StatusCode_name(subscriptionSettings.responseHeader.serviceResult));
+            errlogPrintf("OPC UA subscription %s%s on session %s created (%s)\n",
+                    name.c_str(), what.c_str(), session.getName().c_str(),
+                    UA_StatusCode_name(response.responseHeader.serviceResult));
     }
 }
 
 void
-SubscriptionOpen62541::addMonitoredItems ()
+SubscriptionOpen62541::deleteOnServer ()
+{
+    // Leftover client-side subscriptions have monitored items that refer to the node table.
+    // Only ids of the current session are left here (see forgetServerIds).
+    if (subscriptionSettings.subscriptionId)
+        UA_Client_Subscriptions_deleteSingle(session.client, subscriptionSettings.subscriptionId);
+    subscriptionSettings.subscriptionId = 0;
+    for (const auto &shard : shards) {
+        if (shard.subscriptionId)
+            UA_Client_Subscriptions_deleteSingle(session.client, shard.subscriptionId);
+    }
+    shards.clear();
+}
+
+void
+SubscriptionOpen62541::forgetServerIds ()
+{
+    subscriptionSettings.subscriptionId = 0;
+    shards.clear();
+}
+
+void
+SubscriptionOpen62541::create ()
+{
+    deleteOnServer();
+    if (plan)
+        return; // server subscriptions are created by the planner in addMonitoredItems()
+    createOnServer(requestedSettings, subscriptionSettings, "");
+}
+
+UA_CreateSubscriptionRequest
+SubscriptionOpen62541::shardRequest (const menuPriority prio, const double fastest) const
+{
+    UA_CreateSubscriptionRequest request = requestedSettings;
+    if (fastest > request.requestedPublishingInterval) {
+        // keep the lifetime (timeout) of the subscription
+        request.requestedLifetimeCount = std::max(3 * request.requestedMaxKeepAliveCount,
+            static_cast<UA_UInt32>(request.requestedLifetimeCount
+                                   * request.requestedPublishingInterval / fastest));
+        request.requestedPublishingInterval = fastest;
+    }
+    // Map record priority LOW/MEDIUM/HIGH into the range [priority..255]
+    request.priority = static_cast<UA_Byte>(requestedSettings.priority
+        + (255 - requestedSettings.priority) * prio / (menuPriority_NUM_CHOICES - 1));
+    return request;
+}
+
+std::vector<ShardPlan>
+SubscriptionOpen62541::planShardGroups (const std::vector<ShardCandidate> &candidates,
+                                        const double defaultInterval,
+                                        const size_t max)
+{
+    // Group by record priority (highest first), then by sampling interval (factor 2 bands)
+    std::map<std::pair<int, int>, std::vector<size_t>> groups;
+    std::vector<std::pair<int, int>> keys(candidates.size());
+    for (size_t i = 0; i < candidates.size(); i++) {
+        const ShardCandidate &c = candidates[i];
+        if (c.triggered)
+            continue;
+        double interval = c.samplingInterval > 0.0 ? c.samplingInterval : defaultInterval;
+        int band = static_cast<int>(std::floor(std::log2(std::max(interval, 1.0))));
+        keys[i] = std::make_pair(-c.priority, band);
+        groups[keys[i]].push_back(i);
+    }
+    // Triggering only works within a server subscription: triggered items join their trigger
+    // (if the trigger is triggered itself or unknown, they go to the default group)
+    for (size_t i = 0; i < candidates.size(); i++) {
+        const ShardCandidate &c = candidates[i];
+        if (!c.triggered)
+            continue;
+        bool known = c.trigger < candidates.size() && !candidates[c.trigger].triggered;
+        groups[known ? keys[c.trigger] : std::make_pair(-menuPriorityLOW, 0)].push_back(i);
+    }
+
+    std::vector<ShardPlan> plans;
+    for (auto &group : groups) {
+        std::vector<size_t> &members = group.second;
+        size_t chunk = max ? max : members.size();
+        for (size_t first = 0; first < members.size(); first += chunk) {
+            size_t last = std::min(first + chunk, members.size());
+            ShardPlan plan;
+            plan.priority = -group.first.first;
+            // Publishing faster than the fastest sampling in the shard gains nothing
+            plan.fastestSampling = 0.0;
+            for (size_t i = first; i < last; i++) {
+                double interval = candidates[members[i]].samplingInterval;
+                if (interval > 0.0 && (plan.fastestSampling == 0.0 || interval < plan.fastestSampling))
+                    plan.fastestSampling = interval;
+            }
+            plan.members.assign(members.begin() + first, members.begin() + last);
+            plans.push_back(std::move(plan));
+        }
+    }
+    return plans;
+}
+
+void
+SubscriptionOpen62541::planShards ()
+{
+    UA_UInt32 max = session.MaxMonitoredItemsPerSubscription;
+    if (itemsMax && (!max || itemsMax < max))
+        max = itemsMax;
+
+    std::vector<MonitoredNode *> nodes;
+    std::unordered_map<MonitoredNode *, size_t> index;
+    for (auto &node : monitoredNodes) {
+        index[&node] = nodes.size();
+        nodes.push_back(&node);
+    }
+    std::unordered_map<std::string, MonitoredNode *> records = recordNodes();
+    std::vector<ShardCandidate> candidates(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const MonitoringParameters &monitoring = nodes[i]->items.front()->getMonitoring();
+        ShardCandidate &c = candidates[i];
+        c.priority = menuPriorityLOW;
+        for (auto item : nodes[i]->items)
+            c.priority = std::max(c.priority, static_cast<int>(item->recConnector->getRecordPriority()));
+        c.samplingInterval = monitoring.samplingInterval;
+        c.triggered = monitoring.trigger.length();
+        c.trigger = nodes.size();
+        if (c.triggered) {
+            auto trigger = records.find(monitoring.trigger);
+            if (trigger != records.end())
+                c.trigger = index[trigger->second];
+        }
+    }
+
+    for (auto &plan : planShardGroups(candidates, requestedSettings.requestedPublishingInterval, max)) {
+        menuPriority prio = static_cast<menuPriority>(plan.priority);
+        UA_CreateSubscriptionRequest request = shardRequest(prio, plan.fastestSampling);
+
+        SubscriptionShard shard;
+        UA_CreateSubscriptionResponse response;
+        createOnServer(request, response, "[" + std::to_string(shards.size()) + "]");
+        shard.subscriptionId = response.subscriptionId;
+        shard.publishingInterval = response.subscriptionId ? response.revisedPublishingInterval
+                                                           : request.requestedPublishingInterval;
+        shard.priority = request.priority;
+        shard.recordPriority = prio;
+        shard.fastestSampling = plan.fastestSampling;
+        shard.nodes = plan.members.size();
+        for (auto i : plan.members)
+            nodes[i]->shard = shards.size();
+        shards.push_back(shard);
+    }
+    if (debug)
+        std::cout << "Subscription " << name << "@" << session.getName()
+                  << ": planned " << monitoredNodes.size() << " monitored items in "
+                  << shards.size() << " shards" << std::endl;
+}
+
+// Filter must stay valid until the request has been sent
+static void
+setRequestedParameters (UA_MonitoringParameters &params, const MonitoringParameters &monitoring,
+                        UA_DataChangeFilter &dataChangeFilter)
+{
+    UA_MonitoringParameters_init(&params);
+    params.samplingInterval = monitoring.samplingInterval;
+    params.queueSize = monitoring.queueSize;
+    params.discardOldest = monitoring.discardOldest;
+    if (monitoring.deadband > 0.0) {
+        UA_DataChangeFilter_init(&dataChangeFilter);
+        dataChangeFilter.deadbandType = UA_DEADBANDTYPE_ABSOLUTE;
+        dataChangeFilter.deadbandValue = monitoring.deadband;
+        dataChangeFilter.trigger = UA_DATACHANGETRIGGER_STATUSVALUE;
+        params.filter.content.decoded.data = &dataChangeFilter;
+        params.filter.content.decoded.type = &UA_TYPES[UA_TYPES_DATACHANGEFILTER];
+        params.filter.encoding = UA_EXTENSIONOBJECT_DECODED;
+    }
+}
+
+void
+SubscriptionOpen62541::modifySubscription ()
+{
+    Guard G(session.clientlock);
+    if (!session.isConnected())
+        return; // settings are used when the subscriptions are created
+
+    auto modify = [this] (UA_UInt32 id, const UA_CreateSubscriptionRequest &settings,
+                          UA_Double &revisedInterval, const std::string &what) {
+        UA_ModifySubscriptionRequest request;
+        UA_ModifySubscriptionRequest_init(&request);
+        request.subscriptionId = id;
+        request.requestedPublishingInterval = settings.requestedPublishingInterval;
+        request.requestedLifetimeCount = settings.requestedLifetimeCount;
+        request.requestedMaxKeepAliveCount = settings.requestedMaxKeepAliveCount;
+        request.maxNotificationsPerPublish = settings.maxNotificationsPerPublish;
+        request.priority = settings.priority;
+        UA_ModifySubscriptionResponse response = UA_Client_Subscriptions_modify(session.client, request);
+        if (response.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+            errlogPrintf("OPC UA subscription %s%s: modifySubscription on session %s failed (%s)\n",
+                         name.c_str(), what.c_str(), session.getName().c_str(),
+                         UA_StatusCode_name(response.responseHeader.serviceResult));
+        } else {
+            revisedInterval = response.revisedPublishingInterval;
+            if (debug)
+                std::cout << "Subscription " << name << what << "@" << session.getName()
+                          << ": modified (interval " << response.revisedPublishingInterval
+                          << " prio " << static_cast<int>(settings.priority) << ")" << std::endl;
+        }
+        UA_ModifySubscriptionResponse_clear(&response);
+    };
+
+    if (plan) {
+        for (size_t i = 0; i < shards.size(); i++) {
+            SubscriptionShard &shard = shards[i];
+            if (!shard.subscriptionId)
+                continue;
+            UA_CreateSubscriptionRequest settings = shardRequest(shard.recordPriority, shard.fastestSampling);
+            shard.priority = settings.priority;
+            modify(shard.subscriptionId, settings, shard.publishingInterval, "[" + std::to_string(i) + "]");
+        }
+    } else if (subscriptionSettings.subscriptionId) {
+        modify(subscriptionSettings.subscriptionId, requestedSettings,
+               subscriptionSettings.revisedPublishingInterval, "");
+    }
+}
+
+// Timestamps used by the records of a node table entry
+static UA_TimestampsToReturn
+timestampsToReturn (const MonitoredNode &node)
+{
+    bool source = false;
+    bool server = false;
+    for (auto item : node.items) {
+        source |= item->needsSourceTime();
+        server |= item->needsServerTime();
+    }
+    return ItemOpen62541::timestampsToReturn(source, server);
+}
+
+// Returns false for names that are no monitored item options
+static bool
+setMonitoringOption (MonitoringParameters &params, const std::string &name, const std::string &value)
+{
+    if (name == "sampling") {
+        if (epicsParseDouble(value.c_str(), &params.samplingInterval, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << value << "' to Double");
+    } else if (name == "deadband") {
+        if (epicsParseDouble(value.c_str(), &params.deadband, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << value << "' to Double");
+    } else if (name == "qsize") {
+        if (epicsParseUInt32(value.c_str(), &params.queueSize, 0, nullptr))
+            throw std::runtime_error(SB() << "error converting '" << value << "' to UInt32");
+    } else if (name == "discard") {
+        if (value == "new")
+            params.discardOldest = false;
+        else if (value == "old")
+            params.discardOldest = true;
+        else
+            throw std::runtime_error(SB() << "illegal value '" << value << "'");
+    } else if (name == "trigger") {
+        params.trigger = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void
+SubscriptionOpen62541::modifyMonitoredItems (const std::vector<Item *> &changedItems,
+                                             const std::map<std::string, std::string> &options)
+{
+    Guard G(session.clientlock);
+
+    std::unordered_map<ItemOpen62541 *, MonitoredNode *> nodeOf;
+    for (auto &node : monitoredNodes)
+        for (auto item : node.items)
+            nodeOf[item] = &node;
+
+    std::vector<MonitoredNode *> touched;
+    for (auto pitem : changedItems) {
+        ItemOpen62541 *item = static_cast<ItemOpen62541 *>(pitem);
+        MonitoringParameters params = item->getMonitoring();
+        for (auto &opt : options)
+            if (!setMonitoringOption(params, opt.first, opt.second))
+                throw std::runtime_error(SB() << "unknown monitored item option '" << opt.first << "'");
+        item->setMonitoring(params);
+
+        auto it = nodeOf.find(item);
+        if (it == nodeOf.end())
+            continue; // no monitored item yet
+        if (std::find(touched.begin(), touched.end(), it->second) == touched.end())
+            touched.push_back(it->second);
+    }
+
+    // Items of a shared monitored item whose parameters differ now get their own monitored item.
+    // The group holding an unchanged item keeps the existing one.
+    std::vector<MonitoredNode *> modified, created;
+    for (auto node : touched) {
+        std::vector<std::vector<ItemOpen62541 *>> groups;
+        for (auto item : node->items) {
+            auto g = groups.begin();
+            while (g != groups.end() && !(g->front()->getMonitoring() == item->getMonitoring()))
+                ++g;
+            if (g == groups.end())
+                groups.push_back(std::vector<ItemOpen62541 *>(1, item));
+            else
+                g->push_back(item);
+        }
+        size_t keep = 0;
+        bool unchanged = false;
+        for (size_t i = 0; i < groups.size() && !unchanged; i++)
+            for (auto item : groups[i])
+                if (std::find(changedItems.begin(), changedItems.end(), item) == changedItems.end()) {
+                    keep = i;
+                    unchanged = true;
+                    break;
+                }
+        for (size_t i = 0; i < groups.size(); i++) {
+            if (i == keep) {
+                node->items = groups[i];
+                if (!unchanged)
+                    modified.push_back(node);
+                continue;
+            }
+            monitoredNodes.emplace_back();
+            MonitoredNode &split = monitoredNodes.back();
+            split.items = groups[i];
+            split.monitoredItemId = 0;
+            split.shard = node->shard;
+            split.mode = UA_MONITORINGMODE_REPORTING;
+            split.triggeredBy = nullptr;
+            split.triggers = 0;
+            if (plan && split.shard < shards.size())
+                shards[split.shard].nodes++;
+            created.push_back(&split);
+        }
+    }
+
+    if (session.isConnected()) {
+        for (auto node : created)
+            createMonitoredItem(*node, static_cast<UA_UInt32>(monitoredNodes.size()));
+        modifyOnServer(modified);
+        // Triggers refer to records, which may have moved to a new monitored item
+        std::vector<MonitoredNode *> nodes(modified);
+        nodes.insert(nodes.end(), created.begin(), created.end());
+        for (auto &node : monitoredNodes)
+            if (node.items.size() && node.items.front()->getMonitoring().trigger.length()
+                    && std::find(nodes.begin(), nodes.end(), &node) == nodes.end())
+                nodes.push_back(&node);
+        updateTriggering(nodes);
+    }
+}
+
+void
+SubscriptionOpen62541::modifyOnServer (const std::vector<MonitoredNode *> &nodes)
+{
+    // One request per server subscription and set of timestamps
+    std::map<std::pair<UA_UInt32, UA_TimestampsToReturn>, std::vector<MonitoredNode *>> bySubscription;
+    for (auto node : nodes) {
+        UA_UInt32 id = serverSubscriptionId(*node);
+        if (id && node->monitoredItemId && node->items.size())
+            bySubscription[std::make_pair(id, timestampsToReturn(*node))].push_back(node);
+    }
+
+    for (auto &sub : bySubscription) {
+        std::vector<MonitoredNode *> &subNodes = sub.second;
+        std::vector<UA_MonitoredItemModifyRequest> itemsToModify(subNodes.size());
+        std::vector<UA_DataChangeFilter> filters(subNodes.size());
+        for (size_t i = 0; i < subNodes.size(); i++) {
+            UA_MonitoredItemModifyRequest_init(&itemsToModify[i]);
+            itemsToModify[i].monitoredItemId = subNodes[i]->monitoredItemId;
+            setRequestedParameters(itemsToModify[i].requestedParameters,
+                                   subNodes[i]->items.front()->getMonitoring(), filters[i]);
+        }
+        UA_ModifyMonitoredItemsRequest request;
+        UA_ModifyMonitoredItemsRequest_init(&request);
+        request.subscriptionId = sub.first.first;
+        request.timestampsToReturn = sub.first.second;
+        request.itemsToModify = itemsToModify.data();
+        request.itemsToModifySize = itemsToModify.size();
+        UA_ModifyMonitoredItemsResponse response = UA_Client_MonitoredItems_modify(session.client, request);
+        // request contents are owned by the vectors: no UA_ModifyMonitoredItemsRequest_clear
+
+        if (response.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+            errlogPrintf("OPC UA subscription %s: modifyMonitoredItems on session %s failed (%s)\n",
+                         name.c_str(), session.getName().c_str(),
+                         UA_StatusCode_name(response.responseHeader.serviceResult));
+        } else {
+            for (size_t i = 0; i < subNodes.size() && i < response.resultsSize; i++) {
+                const UA_MonitoredItemModifyResult &result = response.results[i];
+                for (auto item : subNodes[i]->items) {
+                    if (result.statusCode == UA_STATUSCODE_GOOD) {
+                        item->setRevisedSamplingInterval(result.revisedSamplingInterval);
+                        item->setRevisedQueueSize(result.revisedQueueSize);
+                    } else {
+                        errlogPrintf("OPC UA record %s: modifying monitored item failed (%s)\n",
+                                     item->recConnector->getRecordName(),
+                                     UA_StatusCode_name(result.statusCode));
+                    }
+                }
+            }
+            if (debug)
+                std::cout << "Subscription " << name << "@" << session.getName()
+                          << ": modified " << subNodes.size() << " monitored items" << std::endl;
+        }
+        UA_ModifyMonitoredItemsResponse_clear(&response);
+    }
+}
+
+bool
+SubscriptionOpen62541::hasInterest (const MonitoredNode &node)
+{
+    // Only records that opted in (link option idle=y) may idle
+    for (auto item : node.items)
+        if (!item->linkinfo.idle || item->recConnector->hasInterest())
+            return true;
+    return false;
+}
+
+UA_MonitoringMode
+SubscriptionOpen62541::wantedMode (const MonitoredNode &node) const
+{
+    // A triggering item without interest still has to report for the items it triggers
+    if (idleMode != UA_MONITORINGMODE_REPORTING && !node.triggers && !hasInterest(node))
+        return idleMode;
+    return node.triggeredBy ? UA_MONITORINGMODE_SAMPLING : UA_MONITORINGMODE_REPORTING;
+}
+
+void
+SubscriptionOpen62541::updateMonitoringModes ()
+{
+    Guard G(session.clientlock);
+    if (!session.isConnected())
+        return;
+
+    std::vector<MonitoredNode *> nodes;
+    nodes.reserve(monitoredNodes.size());
+    for (auto &node : monitoredNodes)
+        nodes.push_back(&node);
+    setMonitoringModes(nodes);
+}
+
+void
+SubscriptionOpen62541::setMonitoringModes (const std::vector<MonitoredNode *> &nodes)
+{
+    // One request per server subscription and mode
+    std::map<std::pair<UA_UInt32, UA_MonitoringMode>, std::vector<MonitoredNode *>> changes;
+    for (auto node : nodes) {
+        UA_MonitoringMode mode = wantedMode(*node);
+        UA_UInt32 id = serverSubscriptionId(*node);
+        if (mode != node->mode && node->monitoredItemId && id)
+            changes[std::make_pair(id, mode)].push_back(node);
+    }
+
+    for (auto &change : changes) {
+        UA_MonitoringMode mode = change.first.second;
+        std::vector<MonitoredNode *> &group = change.second;
+        std::vector<UA_UInt32> ids;
+        ids.reserve(group.size());
+        for (auto node : group)
+            ids.push_back(node->monitoredItemId);
+        UA_SetMonitoringModeRequest request;
+        UA_SetMonitoringModeRequest_init(&request);
+        request.subscriptionId = change.first.first;
+        request.monitoringMode = mode;
+        request.monitoredItemIds = ids.data();
+        request.monitoredItemIdsSize = ids.size();
+        UA_SetMonitoringModeResponse response = UA_Client_MonitoredItems_setMonitoringMode(session.client, request);
+        // request contents are owned by the vector: no UA_SetMonitoringModeRequest_clear
+
+        if (response.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+            errlogPrintf("OPC UA subscription %s: setMonitoringMode on session %s failed (%s)\n",
+                         name.c_str(), session.getName().c_str(),
+                         UA_StatusCode_name(response.responseHeader.serviceResult));
+        } else {
+            for (size_t i = 0; i < group.size() && i < response.resultsSize; i++) {
+                if (response.results[i] != UA_STATUSCODE_GOOD)
+                    continue;
+                group[i]->mode = mode;
+                if (mode == UA_MONITORINGMODE_REPORTING) {
+                    // refresh the values that were not reported while idle or triggered
+                    for (auto item : group[i]->items)
+                        item->requestRead();
+                }
+            }
+            if (debug)
+                std::cout << "Subscription " << name << "@" << session.getName()
+                          << ": switched " << group.size() << " monitored items to "
+                          << (mode == UA_MONITORINGMODE_REPORTING ? "reporting" :
+                              mode == UA_MONITORINGMODE_SAMPLING ? "sampling" : "disabled")
+                          << std::endl;
+        }
+        UA_SetMonitoringModeResponse_clear(&response);
+    }
+}
+
+std::unordered_map<std::string, MonitoredNode *>
+SubscriptionOpen62541::recordNodes ()
+{
+    std::unordered_map<std::string, MonitoredNode *> records;
+    for (auto &node : monitoredNodes)
+        for (auto item : node.items)
+            records[item->recConnector->getRecordName()] = &node;
+    return records;
+}
+
+MonitoredNode *
+SubscriptionOpen62541::findTrigger (MonitoredNode &node,
+                                    const std::unordered_map<std::string, MonitoredNode *> &records) const
+{
+    ItemOpen62541 *item = node.items.front();
+    const std::string &trigger = item->getMonitoring().trigger;
+    if (trigger.empty())
+        return nullptr;
+    auto it = records.find(trigger);
+    if (it == records.end()) {
+        errlogPrintf("OPC UA record %s: trigger record %s is not monitored on subscription %s\n",
+                     item->recConnector->getRecordName(), trigger.c_str(), name.c_str());
+        return nullptr;
+    }
+    if (it->second == &node) {
+        errlogPrintf("OPC UA record %s: monitored item cannot trigger itself (trigger record %s)\n",
+                     item->recConnector->getRecordName(), trigger.c_str());
+        return nullptr;
+    }
+    return it->second;
+}
+
+void
+SubscriptionOpen62541::updateTriggering (const std::vector<MonitoredNode *> &nodes)
+{
+    std::unordered_map<std::string, MonitoredNode *> records = recordNodes();
+
+    // Links to add and remove, per triggering item
+    std::map<MonitoredNode *, std::pair<std::vector<MonitoredNode *>, std::vector<MonitoredNode *>>> links;
+    for (auto node : nodes) {
+        if (!node->items.size() || !node->monitoredItemId)
+            continue;
+        MonitoredNode *trigger = findTrigger(*node, records);
+        if (trigger && !trigger->monitoredItemId)
+            trigger = nullptr; // creation failed (already reported)
+        if (trigger && serverSubscriptionId(*trigger) != serverSubscriptionId(*node)) {
+            errlogPrintf("OPC UA record %s: trigger record %s is on a different server subscription"
+                         " (see items-max option)\n",
+                         node->items.front()->recConnector->getRecordName(),
+                         trigger->items.front()->recConnector->getRecordName());
+            trigger = nullptr;
+        }
+        if (trigger == node->triggeredBy)
+            continue;
+        if (node->triggeredBy) {
+            links[node->triggeredBy].second.push_back(node);
+            node->triggeredBy->triggers--;
+        }
+        if (trigger) {
+            links[trigger].first.push_back(node);
+            trigger->triggers++;
+        }
+        node->triggeredBy = trigger;
+    }
+
+    for (auto &link : links) {
+        MonitoredNode *trigger = link.first;
+        std::vector<MonitoredNode *> &toAdd = link.second.first;
+        std::vector<MonitoredNode *> &toRemove = link.second.second;
+        std::vector<UA_UInt32> addIds, removeIds;
+        addIds.reserve(toAdd.size());
+        for (auto node : toAdd)
+            addIds.push_back(node->monitoredItemId);
+        removeIds.reserve(toRemove.size());
+        for (auto node : toRemove)
+            removeIds.push_back(node->monitoredItemId);
+
+        UA_SetTriggeringRequest request;
+        UA_SetTriggeringRequest_init(&request);
+        request.subscriptionId = serverSubscriptionId(*trigger);
+        request.triggeringItemId = trigger->monitoredItemId;
+        request.linksToAdd = addIds.data();
+        request.linksToAddSize = addIds.size();
+        request.linksToRemove = removeIds.data();
+        request.linksToRemoveSize = removeIds.size();
+        UA_SetTriggeringResponse response = UA_Client_MonitoredItems_setTriggering(session.client, request);
+        // request contents are owned by the vectors: no UA_SetTriggeringRequest_clear
+
+        bool ok = response.responseHeader.serviceResult == UA_STATUSCODE_GOOD;
+        if (!ok)
+            errlogPrintf("OPC UA subscription %s: setTriggering on session %s failed (%s)\n",
+                         name.c_str(), session.getName().c_str(),
+                         UA_StatusCode_name(response.responseHeader.serviceResult));
+        // Items whose link could not be added keep reporting by themselves
+        for (size_t i = 0; i < toAdd.size(); i++) {
+            UA_StatusCode status = response.responseHeader.serviceResult;
+            if (ok)
+                status = i < response.addResultsSize ? response.addResults[i] : UA_STATUSCODE_BADUNEXPECTEDERROR;
+            if (status == UA_STATUSCODE_GOOD)
+                continue;
+            if (ok)
+                errlogPrintf("OPC UA record %s: adding triggering link failed (%s)\n",
+                             toAdd[i]->items.front()->recConnector->getRecordName(),
+                             UA_StatusCode_name(status));
+            toAdd[i]->triggeredBy = nullptr;
+            trigger->triggers--;
+        }
+        if (debug)
+            std::cout << "Subscription " << name << "@" << session.getName()
+                      << ": record " << trigger->items.front()->recConnector->getRecordName()
+                      << " triggering " << toAdd.size() << " items added, "
+                      << toRemove.size() << " removed ("
+                      << UA_StatusCode_name(response.responseHeader.serviceResult) << ")" << std::endl;
+        UA_SetTriggeringResponse_clear(&response);
+    }
+
+    // Triggered items sample, others report (modes of the triggering items may change as well)
+    std::vector<MonitoredNode *> changed(nodes);
+    for (auto &link : links)
+        changed.push_back(link.first);
+    setMonitoringModes(changed);
+}
+
+UA_StatusCode
+SubscriptionOpen62541::createMonitoredItem (MonitoredNode &node, const UA_UInt32 clientHandle)
 {
-    UA_UInt32 i;
     UA_MonitoredItemCreateRequest monitoredItemCreateRequest;
     UA_MonitoredItemCreateResult monitoredItemCreateResult;
     UA_DataChangeFilter dataChangeFilter;
 
-    if (items.size()) {
-        monitoredItemCreateResult.statusCode = UA_STATUSCODE_GOOD; // suppress compiler warning
-        i = 0;
-        for (auto &it : items) {
-            UA_MonitoredItemCreateRequest_init(&monitoredItemCreateRequest);
-            monitoredItemCreateRequest.itemToMonitor.nodeId = it->getNodeId();
-            monitoredItemCreateRequest.itemToMonitor.attributeId = UA_ATTRIBUTEID_VALUE;
-            monitoredItemCreateRequest.monitoringMode = UA_MONITORINGMODE_REPORTING;
-            monitoredItemCreateRequest.requestedParameters.clientHandle = i;
-            monitoredItemCreateRequest.requestedParameters.samplingInterval = it->linkinfo.samplingInterval;
-            monitoredItemCreateRequest.requestedParameters.queueSize = it->linkinfo.queueSize;
-            monitoredItemCreateRequest.requestedParameters.discardOldest = it->linkinfo.discardOldest;
-            if (it->linkinfo.deadband > 0.0) {
-                UA_DataChangeFilter_init(&dataChangeFilter);
-                dataChangeFilter.deadbandType = UA_DEADBANDTYPE_ABSOLUTE;
-                dataChangeFilter.deadbandValue = it->linkinfo.deadband;
-                dataChangeFilter.trigger = UA_DATACHANGETRIGGER_STATUSVALUE;
-                UA_ExtensionObject *filter = &monitoredItemCreateRequest.requestedParameters.filter;
-                filter->content.decoded.data = &dataChangeFilter;
-                filter->content.decoded.type = &UA_TYPES[UA_TYPES_DATACHANGEFILTER];
-                filter->encoding = UA_EXTENSIONOBJECT_DECODED;
-            }
-            monitoredItemCreateResult = UA_Client_MonitoredItems_createDataChange(
-                session.client, subscriptionSettings.subscriptionId, UA_TIMESTAMPSTORETURN_BOTH,
-                monitoredItemCreateRequest, it, [] (UA_Client *client, UA_UInt32 subId, void *subContext,
-                         UA_UInt32 monId, void *monContext, UA_DataValue *value) {
-                            static_cast<SubscriptionOpen62541*>(subContext)->
-                                dataChange(monId, *static_cast<ItemOpen62541*>(monContext), value);
-                         }, nullptr /* deleteCallback */);
-            if (monitoredItemCreateResult.statusCode == UA_STATUSCODE_GOOD) {
-                it->setRevisedSamplingInterval(monitoredItemCreateResult.revisedSamplingInterval);
-                it->setRevisedQueueSize(monitoredItemCreateResult.revisedQueueSize);
-                if (debug >= 5) {
-                    std::cout << "** OPC UA record " << it->recConnector->getRecordName()
-                              << " monitored item " << monitoredItemCreateRequest.itemToMonitor.nodeId
-                              << " succeeded with id " << monitoredItemCreateResult.monitoredItemId
-                              << " revised sampling interval " << monitoredItemCreateResult.revisedSamplingInterval
-                              << " revised queue size " << monitoredItemCreateResult.revisedQueueSize
-                              << std::endl;
-                }
-            } else {
-                std::cerr << "OPC UA record " << it->recConnector->getRecordName()
+    ItemOpen62541 *it = node.items.front();
+    UA_MonitoredItemCreateRequest_init(&monitoredItemCreateRequest);
+    monitoredItemCreateRequest.itemToMonitor.nodeId = it->getNodeId();
+    monitoredItemCreateRequest.itemToMonitor.attributeId = UA_ATTRIBUTEID_VALUE;
+    // Items nobody is interested in start idle (the initial read provides their values),
+    // triggered items start sampling (switched to reporting if the link fails)
+    if (idleMode != UA_MONITORINGMODE_REPORTING && !hasInterest(node))
+        node.mode = idleMode;
+    else if (it->getMonitoring().trigger.length())
+        node.mode = UA_MONITORINGMODE_SAMPLING;
+    monitoredItemCreateRequest.monitoringMode = node.mode;
+    setRequestedParameters(monitoredItemCreateRequest.requestedParameters, it->getMonitoring(),
+                           dataChangeFilter);
+    monitoredItemCreateRequest.requestedParameters.clientHandle = clientHandle;
+    monitoredItemCreateResult = UA_Client_MonitoredItems_createDataChange(
+        session.client, serverSubscriptionId(node),
+        timestampsToReturn(node), // only the timestamps that the records use
+        monitoredItemCreateRequest, &node, [] (UA_Client *client, UA_UInt32 subId, void *subContext,
+                 UA_UInt32 monId, void *monContext, UA_DataValue *value) {
+                    static_cast<SubscriptionOpen62541*>(subContext)->
+                        dataChange(monId, *static_cast<MonitoredNode*>(monContext), value);
+                 }, nullptr /* deleteCallback */);
+    if (monitoredItemCreateResult.statusCode == UA_STATUSCODE_GOOD) {
+        node.monitoredItemId = monitoredItemCreateResult.monitoredItemId;
+        for (auto item : node.items) {
+            item->setRevisedSamplingInterval(monitoredItemCreateResult.revisedSamplingInterval);
+            item->setRevisedQueueSize(monitoredItemCreateResult.revisedQueueSize);
+            if (debug >= 5) {
+                std::cout << "** OPC UA record " << item->recConnector->getRecordName()
                           << " monitored item " << monitoredItemCreateRequest.itemToMonitor.nodeId
-                          << " failed with error " << UA_StatusCode_name(monitoredItemCreateResult.statusCode)
+                          << " succeeded with id " << monitoredItemCreateResult.monitoredItemId
+                          << " revised sampling interval " << monitoredItemCreateResult.revisedSamplingInterval
+                          << " revised queue size " << monitoredItemCreateResult.revisedQueueSize
                           << std::endl;
-                it->setIncomingEvent(ProcessReason::connectionLoss);
             }
-            i++;
+        }
+    } else {
+        for (auto item : node.items) {
+            std::cerr << "OPC UA record " << item->recConnector->getRecordName()
+                      << " monitored item " << monitoredItemCreateRequest.itemToMonitor.nodeId
+                      << " failed with error " << UA_StatusCode_name(monitoredItemCreateResult.statusCode)
+                      << std::endl;
+            item->setIncomingEvent(ProcessReason::connectionLoss);
+        }
+    }
+    return monitoredItemCreateResult.statusCode;
+}
+
+void
+SubscriptionOpen62541::addMonitoredItems ()
+{
+    // Rebuild the node table: node ids may have changed since the last connect
+    monitoredNodes.clear();
+    std::unordered_map<UA_NodeId, std::vector<MonitoredNode *>> nodeTable;
+    for (auto &it : items) {
+        if (it->isUnresolved())
+            continue; // until the browse path is resolved at a reconnect
+        MonitoredNode *node = nullptr;
+        auto &candidates = nodeTable[it->getNodeId()];
+        for (auto c : candidates) {
+            if (c->items.front()->getMonitoring() == it->getMonitoring()) {
+                node = c;
+                break;
+            }
+        }
+        if (!node) {
+            monitoredNodes.emplace_back();
+            node = &monitoredNodes.back();
+            node->monitoredItemId = 0;
+            node->shard = 0;
+            node->mode = UA_MONITORINGMODE_REPORTING;
+            node->triggeredBy = nullptr;
+            node->triggers = 0;
+            candidates.push_back(node);
+        }
+        node->items.push_back(it);
+    }
+
+    if (plan)
+        planShards();
+
+    if (monitoredNodes.size()) {
+        UA_StatusCode status = UA_STATUSCODE_GOOD;
+        UA_UInt32 i = 0;
+        for (auto &node : monitoredNodes)
+            status = createMonitoredItem(node, i++);
+        // Set up the triggering links (also restores them after a reconnect)
+        std::vector<MonitoredNode *> nodes;
+        for (auto &node : monitoredNodes)
+            if (node.items.front()->getMonitoring().trigger.length())
+                nodes.push_back(&node);
+        if (nodes.size())
+            updateTriggering(nodes);
+        if (idleMode != UA_MONITORINGMODE_REPORTING && !interestTimer) {
+            interestTimer.reset(new InterestTimer(*this, idleCheck, SessionOpen62541::queue));
+            interestTimer->start();
         }
         if (debug)
             std::cout << "Subscription " << name << "@" << session.getName()
-                      << ": created " << items.size() << " monitored items ("
-                      << UA_StatusCode_name(monitoredItemCreateResult.statusCode) << ")" << std::endl;
+                      << ": created " << monitoredNodes.size() << " monitored items for "
+                      << items.size() << " items ("
+                      << UA_StatusCode_name(status) << ")" << std::endl;
     }
 }
 
@@ -210,7 +948,7 @@ void
 SubscriptionOpen62541::clear ()
 {
     if(session.client)
-        UA_Client_Subscriptions_deleteSingle(session.client, subscriptionSettings.subscriptionId);
+        deleteOnServer();
 }
 
 void
@@ -225,6 +963,11 @@ SubscriptionOpen62541::removeItemOpen62541 (ItemOpen62541 *item)
     auto it = std::find(items.begin(), items.end(), item);
     if (it != items.end())
         items.erase(it);
+    for (auto &node : monitoredNodes) {
+        auto nit = std::find(node.items.begin(), node.items.end(), item);
+        if (nit != node.items.end())
+            node.items.erase(nit);
+    }
 }
 
 
@@ -238,18 +981,29 @@ SubscriptionOpen62541::subscriptionStatusChanged (UA_StatusCode status)
 }
 
 void
-SubscriptionOpen62541::dataChange (UA_UInt32 monitorId, ItemOpen62541 &item, UA_DataValue *value)
+SubscriptionOpen62541::dataChange (UA_UInt32 monitorId, MonitoredNode &node, UA_DataValue *value)
 {
-    if (debug >= 5) {
-        std::cout << "** Subscription " << name
-                  << "@" << session.getName()
-                  << ": (dataChange) getting data for item " << monitorId
-                  << " " << item.getNodeId();
-        if (item.isRegistered() && ! item.linkinfo.identifierIsNumeric)
-            std::cout << "/" << item.linkinfo.identifierString;
-        std::cout << " = " << value->value << std::endl;
+    for (auto it = node.items.begin(); it != node.items.end(); ++it) {
+        ItemOpen62541 &item = **it;
+        if (debug >= 5) {
+            std::cout << "** Subscription " << name
+                      << "@" << session.getName()
+                      << ": (dataChange) getting data for item " << monitorId
+                      << " " << item.getNodeId();
+            if (item.isRegistered() && ! item.linkinfo.identifierIsNumeric)
+                std::cout << "/" << item.linkinfo.identifierString;
+            std::cout << " = " << value->value << std::endl;
+        }
+        if (it + 1 != node.items.end()) {
+            // The item takes ownership of the data: the last one gets the original
+            UA_DataValue copy;
+            UA_DataValue_copy(value, &copy);
+            item.setIncomingData(copy, ProcessReason::incomingData);
+            UA_DataValue_clear(&copy);
+        } else {
+            item.setIncomingData(*value, ProcessReason::incomingData);
+        }
     }
-    item.setIncomingData(*value, ProcessReason::incomingData);
 }
 
 } // namespace DevOpcua
@@ -17,16 +17,75 @@
 #include "Subscription.h"
 
 #include <open62541/client.h>
+#include <menuPriority.h>
+#include <epicsTimer.h>
 
 #include <string>
 #include <set>
+#include <map>
+#include <unordered_map>
+#include <list>
 #include <vector>
+#include <memory>
 
 namespace DevOpcua {
 
 class SessionOpen62541;
 class ItemOpen62541;
 
+/**
+ * @brief Node table entry of a subscription.
+ *
+ * One monitored item on the server, shared by all items that monitor
+ * the same node with the same sampling parameters.
+ */
+struct MonitoredNode
+{
+    std::vector<ItemOpen62541 *> items;  /**< items the data changes are fanned out to */
+    UA_UInt32 monitoredItemId;           /**< server-side monitored item id */
+    size_t shard;                        /**< index of the shard (planner only) */
+    UA_MonitoringMode mode;              /**< current monitoring mode */
+    MonitoredNode *triggeredBy;          /**< triggering entry (SetTriggering link), nullptr = none */
+    size_t triggers;                     /**< number of entries triggered by this one */
+};
+
+/**
+ * @brief Server subscription created by the subscription planner.
+ *
+ * Holds monitored items of similar sampling intervals
+ * that belong to records of the same priority.
+ */
+struct SubscriptionShard
+{
+    UA_UInt32 subscriptionId;            /**< server-side subscription id */
+    UA_Double publishingInterval;        /**< revised publishing interval */
+    UA_Byte priority;                    /**< requested priority */
+    menuPriority recordPriority;         /**< priority of the records */
+    double fastestSampling;              /**< fastest sampling interval of the items (0 = none) */
+    size_t nodes;                        /**< number of monitored items */
+};
+
+/**
+ * @brief Input of the subscription planner for one entry of the node table.
+ */
+struct ShardCandidate
+{
+    int priority;                        /**< highest priority of the records */
+    double samplingInterval;             /**< requested sampling interval (<= 0 = publishing interval) */
+    bool triggered;                      /**< reports when triggered by another entry */
+    size_t trigger;                      /**< index of the triggering entry (unknown = out of range) */
+};
+
+/**
+ * @brief Output of the subscription planner for one shard.
+ */
+struct ShardPlan
+{
+    int priority;                        /**< priority of the records */
+    double fastestSampling;              /**< fastest sampling interval of the entries (0 = none) */
+    std::vector<size_t> members;         /**< indices of the entries */
+};
+
 /**
  * @brief The SubscriptionOpen62541 implementation of an OPC UA Subscription.
  *
@@ -57,6 +116,16 @@ public:
      */
     virtual void setOption(const std::string &name, const std::string &value) override;
 
+    /**
+     * @brief Change monitoring parameters. See DevOpcua::Subscription::modifyMonitoredItems
+     *
+     * Sends batched ModifyMonitoredItems requests (one per server subscription).
+     * Changed items that share a monitored item with other items get their own monitored item.
+     * Changed triggering relationships are updated (SetTriggering service).
+     */
+    virtual void modifyMonitoredItems(const std::vector<Item *> &items,
+                                      const std::map<std::string, std::string> &options) override;
+
     /**
      * @brief Print configuration and status. See DevOpcua::Subscription::show
      */
@@ -102,6 +171,25 @@ public:
      */
     static bool subscriptionExists(const std::string &name);
 
+    /**
+     * @brief Group the entries of a node table into shards (planner).
+     *
+     * Entries are grouped by priority (highest first) and by sampling interval
+     * (bands of a factor of 2). Triggered entries join the group of their
+     * trigger; if the trigger is unknown or triggered itself, they join the
+     * group of priority LOW and the fastest band. Groups are split into shards
+     * of at most max entries.
+     *
+     * @param candidates  entries of the node table
+     * @param defaultInterval  sampling interval of entries that use the publishing interval
+     * @param max  max. number of entries per shard (0 = no limit)
+     *
+     * @return shards
+     */
+    static std::vector<ShardPlan> planShardGroups(const std::vector<ShardCandidate> &candidates,
+                                                  const double defaultInterval,
+                                                  const size_t max);
+
     /**
      * @brief Get the session. See DevOpcua::Subscription::getSession
      *
@@ -143,6 +231,8 @@ public:
      *
      * If the connection to the server (session) is up, the subscription is
      * created on the server side using the createSubscription service.
+     * With the planner enabled, only leftover subscriptions are removed;
+     * addMonitoredItems() creates the server subscriptions.
      */
     void create();
 
@@ -152,6 +242,9 @@ public:
      * If the subscription is created, all monitored items (i.e. all items
      * configured to be on the subscription) are being added (created on the
      * server side) using the createMonitoredItems service.
+     * Items that monitor the same node with the same sampling interval,
+     * queue size, discard policy, deadband and trigger share one monitored item.
+     * Finally, the triggering links are set up and the monitoring modes are adjusted.
      */
     void addMonitoredItems();
 
@@ -163,6 +256,14 @@ public:
      */
     void clear();
 
+    /**
+     * @brief Forget the server-side subscription ids.
+     *
+     * Called when the session is gone: its subscriptions have been removed
+     * from the client and can't be deleted on the server any more.
+     */
+    void forgetServerIds();
+
     // SubscriptionCallback interface
     void subscriptionStatusChanged(
             UA_StatusCode   status
@@ -170,17 +271,191 @@ public:
 
     void dataChange(
             UA_UInt32       monitorId,
-            ItemOpen62541   &item,
+            MonitoredNode   &node,
             UA_DataValue    *value
             );
 
 private:
+    /**
+     * @brief Create a subscription on the server.
+     *
+     * @param request  requested subscription settings
+     * @param[out] response  revised subscription settings
+     * @param what  description for messages
+     */
+    void createOnServer(const UA_CreateSubscriptionRequest &request,
+                        UA_CreateSubscriptionResponse &response,
+                        const std::string &what);
+
+    /**
+     * @brief Delete all subscriptions of this SubscriptionOpen62541 from the client and server.
+     */
+    void deleteOnServer();
+
+    /**
+     * @brief Apply the requested subscription settings to the server subscriptions
+     * (ModifySubscription service), if connected.
+     */
+    void modifySubscription();
+
+    /**
+     * @brief Send the monitoring parameters of node table entries to the server
+     * (ModifyMonitoredItems service; clientlock must be held).
+     *
+     * @param nodes  node table entries to modify
+     */
+    void modifyOnServer(const std::vector<MonitoredNode *> &nodes);
+
+    /**
+     * @brief Create the monitored item of a node table entry on the server
+     * (clientlock must be held).
+     *
+     * Sets the initial monitoring mode (idle, sampling for triggered items, reporting).
+     * On failure, the node's items are told about the connection loss.
+     *
+     * @param node  node table entry
+     * @param clientHandle  client handle for the request
+     *
+     * @return status of the monitored item creation
+     */
+    UA_StatusCode createMonitoredItem(MonitoredNode &node, const UA_UInt32 clientHandle);
+
+    /**
+     * @brief Settings for the server subscription of a shard (planner).
+     *
+     * @param prio  record priority of the shard
+     * @param fastest  fastest sampling interval of the shard's items (0 = none)
+     *
+     * @return request settings
+     */
+    UA_CreateSubscriptionRequest shardRequest(const menuPriority prio, const double fastest) const;
+
+    /**
+     * @brief Get the id of the server subscription that a node table entry is on.
+     *
+     * @param node  node table entry
+     * @return subscription id (0 = not created)
+     */
+    UA_UInt32 serverSubscriptionId(const MonitoredNode &node) const
+    {
+        return plan ? shards[node.shard].subscriptionId : subscriptionSettings.subscriptionId;
+    }
+
+    /**
+     * @brief Map the names of the records on this subscription to their node table entries.
+     *
+     * @return map record name -> node table entry
+     */
+    std::unordered_map<std::string, MonitoredNode *> recordNodes();
+
+    /**
+     * @brief Find the triggering entry that a node table entry has configured.
+     *
+     * Prints an error if the trigger record is not monitored on this subscription
+     * or is the entry itself.
+     *
+     * @param node  node table entry
+     * @param records  map of record names (see recordNodes())
+     * @return triggering entry, nullptr if none is configured or found
+     */
+    MonitoredNode *findTrigger(MonitoredNode &node,
+                               const std::unordered_map<std::string, MonitoredNode *> &records) const;
+
+    /**
+     * @brief Set up the triggering links of node table entries (SetTriggering service;
+     * clientlock must be held).
+     *
+     * Links are batched into one request per triggering item.
+     * Links that cannot be set up leave the triggered item reporting.
+     * The monitoring modes of the entries are adjusted afterwards.
+     *
+     * @param nodes  node table entries with changed triggers
+     */
+    void updateTriggering(const std::vector<MonitoredNode *> &nodes);
+
+    /**
+     * @brief Check if any record of a node table entry has interest in its updates.
+     *
+     * Items of opcuaItem records and of records without the link option idle=y
+     * always count as interested.
+     *
+     * @param node  node table entry
+     * @return true if there is interest
+     */
+    static bool hasInterest(const MonitoredNode &node);
+
+    /**
+     * @brief Get the monitoring mode that a node table entry should be in.
+     *
+     * Triggered items are SAMPLING, items without interest (and without
+     * triggered items) are in the idle mode, all others are REPORTING.
+     *
+     * @param node  node table entry
+     * @return monitoring mode
+     */
+    UA_MonitoringMode wantedMode(const MonitoredNode &node) const;
+
+    /**
+     * @brief Switch node table entries to their wanted monitoring mode
+     * (SetMonitoringMode service; clientlock must be held).
+     *
+     * Items that are switched to REPORTING are read once.
+     *
+     * @param nodes  node table entries to check
+     */
+    void setMonitoringModes(const std::vector<MonitoredNode *> &nodes);
+
+    /**
+     * @brief Switch the monitored items between REPORTING and the idle mode
+     * according to the interest in their records (SetMonitoringMode service).
+     *
+     * Items that are switched back to REPORTING are read once.
+     */
+    void updateMonitoringModes();
+
+    /** @brief Timer checking the interest in the monitored items periodically. */
+    class InterestTimer : public epicsTimerNotify {
+    public:
+        InterestTimer(SubscriptionOpen62541 &subscription, const double period, epicsTimerQueueActive *queue)
+            : timer(queue->createTimer())
+            , subscription(subscription)
+            , period(period)
+        {}
+        virtual ~InterestTimer() override { timer.destroy(); }
+        void start() { timer.start(*this, period); }
+        virtual expireStatus expire(const epicsTime &/*currentTime*/) override {
+            subscription.updateMonitoringModes();
+            return expireStatus(restart, period);
+        }
+    private:
+        epicsTimer &timer;
+        SubscriptionOpen62541 &subscription;
+        const double period;
+    };
+
+    /**
+     * @brief Plan the shards (planner): assign every entry of the node table to a shard
+     * and create the server subscriptions.
+     *
+     * Monitored items are grouped by the highest priority of their records
+     * and by sampling interval (within a factor of 2). Groups are split
+     * to respect the server's MaxMonitoredItemsPerSubscription and the items-max option.
+     */
+    void planShards();
+
     static Registry<SubscriptionOpen62541> subscriptions; /**< subscription management */
     SessionOpen62541 &session;                            /**< reference to session */
     std::vector<ItemOpen62541 *> items;                   /**< items on this subscription */
+    std::list<MonitoredNode> monitoredNodes;              /**< node table (monitored items on the server) */
     UA_CreateSubscriptionResponse subscriptionSettings;   /**< subscription specific settings */
     UA_CreateSubscriptionRequest requestedSettings;       /**< requested subscription specific settings */
     bool enable;                                          /**< subscription enable flag */
+    bool plan;                                            /**< use the subscription planner */
+    UA_UInt32 itemsMax;                                   /**< max number of monitored items per shard (planner) */
+    std::vector<SubscriptionShard> shards;                /**< server subscriptions (planner) */
+    UA_MonitoringMode idleMode;                           /**< mode for items without interest (REPORTING = off) */
+    double idleCheck;                                     /**< period of the interest check [s] */
+    std::unique_ptr<InterestTimer> interestTimer;         /**< periodic interest check */
 };
 
 } // namespace DevOpcua
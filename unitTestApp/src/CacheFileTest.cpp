@@ -0,0 +1,98 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "CacheFile.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+// Tokens
+
+TEST(CacheFileTest, Token_RoundTrip)
+{
+    const std::string tokens[] = {
+        "simple",
+        "",
+        "with blanks and\nnew lines",
+        std::string("embedded\0NUL", 12),
+        "12:looks like a token"
+    };
+    std::stringstream ss;
+    for (const auto &t : tokens)
+        writeToken(ss, t);
+
+    std::string str;
+    for (const auto &t : tokens) {
+        ASSERT_TRUE(readToken(ss, str)) << "can't read back token '" << t << "'";
+        EXPECT_EQ(str, t) << "token changed in round trip";
+    }
+    EXPECT_FALSE(readToken(ss, str)) << "token read past the end";
+}
+
+TEST(CacheFileTest, Token_Damaged)
+{
+    std::string str;
+    std::istringstream missingColon(" 5 hello");
+    EXPECT_FALSE(readToken(missingColon, str)) << "token without colon accepted";
+    std::istringstream truncated(" 10:short");
+    EXPECT_FALSE(readToken(truncated, str)) << "truncated token accepted";
+    std::istringstream noLength(" x:abc");
+    EXPECT_FALSE(readToken(noLength, str)) << "token without length accepted";
+}
+
+// Header (type cache: library version, server URI, fingerprint)
+
+TEST(CacheFileTest, Header_RoundTrip)
+{
+    std::stringstream ss;
+    writeCacheHeader(ss, "opcua-test", 3, { "1.3.5-p-200", "urn:server", "0123456789abcdef" });
+    ss << "payload";
+    EXPECT_TRUE(readCacheHeader(ss, "opcua-test", 3, { "1.3.5-p-200", "urn:server", "0123456789abcdef" }))
+        << "header doesn't match itself";
+    std::string rest;
+    ss >> rest;
+    EXPECT_EQ(rest, "payload") << "header read didn't stop at the contents";
+}
+
+TEST(CacheFileTest, Header_Mismatch)
+{
+    std::ostringstream os;
+    writeCacheHeader(os, "opcua-test", 3, { "1.3.5-p-200", "urn:server", "0123456789abcdef" });
+    const std::string file = os.str();
+
+    std::istringstream fingerprint(file);
+    EXPECT_FALSE(readCacheHeader(fingerprint, "opcua-test", 3, { "1.3.5-p-200", "urn:server", "0123456789abcdee" }))
+        << "different fingerprint accepted";
+    std::istringstream server(file);
+    EXPECT_FALSE(readCacheHeader(server, "opcua-test", 3, { "1.3.5-p-200", "urn:other", "0123456789abcdef" }))
+        << "different server accepted";
+    std::istringstream library(file);
+    EXPECT_FALSE(readCacheHeader(library, "opcua-test", 3, { "1.4.0-p-200", "urn:server", "0123456789abcdef" }))
+        << "different library version accepted";
+    std::istringstream version(file);
+    EXPECT_FALSE(readCacheHeader(version, "opcua-test", 4, { "1.3.5-p-200", "urn:server", "0123456789abcdef" }))
+        << "different file format version accepted";
+    std::istringstream magic(file);
+    EXPECT_FALSE(readCacheHeader(magic, "opcua-other", 3, { "1.3.5-p-200", "urn:server", "0123456789abcdef" }))
+        << "different file type accepted";
+    std::istringstream fewer(file.substr(0, file.find("urn:")));
+    EXPECT_FALSE(readCacheHeader(fewer, "opcua-test", 3, { "1.3.5-p-200", "urn:server", "0123456789abcdef" }))
+        << "truncated header accepted";
+    std::istringstream empty("");
+    EXPECT_FALSE(readCacheHeader(empty, "opcua-test", 3, {})) << "empty file accepted";
+}
+
+} // namespace
@@ -11,6 +11,9 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <utility>
+#include <vector>
+#include <string>
+#include <unordered_map>
 
 #include <epicsTime.h>
 
@@ -73,14 +76,18 @@ public:
     }
     virtual ~TestNode() override { instanceCount--; }
 
-    virtual void addChild(std::weak_ptr<TestBase> elem) override { elements.push_back(elem); }
+    virtual void addChild(std::weak_ptr<TestBase> elem) override
+    {
+        elements.push_back(elem);
+        if (auto pelem = elem.lock())
+            elementIndex.emplace(pelem->name, elem); // a duplicate name finds the first child
+    }
 
     virtual std::shared_ptr<TestBase> findChild(const std::string &name) const override
     {
-        for (const auto &it : elements)
-            if (auto pit = it.lock())
-                if (pit->name == name)
-                    return pit;
+        auto it = elementIndex.find(name);
+        if (it != elementIndex.end())
+            return it->second.lock();
         return std::shared_ptr<TestBase>();
     }
 
@@ -108,6 +115,7 @@ public:
     static unsigned int instances() { return instanceCount; }
 
     std::vector<std::weak_ptr<TestBase>> elements;
+    std::unordered_map<std::string, std::weak_ptr<TestBase>> elementIndex;
 
 private:
     static unsigned int instanceCount;
@@ -0,0 +1,347 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <epicsTypes.h>
+#include <epicsTime.h>
+
+#include "LeafConversion.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+// Minimal variant and traits class, standing in for a client library
+// (the conversion core is the same for all of them)
+
+struct TestVariant {
+    ScalarKind kind = ScalarKind::unsupported;
+    union {
+        bool b;
+        epicsInt8 i8;
+        epicsUInt8 u8;
+        epicsInt16 i16;
+        epicsUInt16 u16;
+        epicsInt32 i32;
+        epicsUInt32 u32;
+        epicsInt64 i64;
+        epicsUInt64 u64;
+        epicsFloat32 f32;
+        epicsFloat64 f64;
+    };
+    std::string text;
+    std::string locale;
+    int setCount = 0;
+
+    TestVariant() : u64(0) {}
+};
+
+struct TestTraits {
+    typedef TestVariant Variant;
+    typedef int Status;
+    typedef epicsInt8 SByte;
+    typedef epicsUInt8 Byte;
+    typedef epicsInt16 Int16;
+    typedef epicsUInt16 UInt16;
+    typedef epicsInt32 Int32;
+    typedef epicsUInt32 UInt32;
+    typedef epicsInt64 Int64;
+    typedef epicsUInt64 UInt64;
+    typedef epicsFloat32 Float;
+    typedef epicsFloat64 Double;
+
+    static ScalarKind kindOf (const TestVariant &v) { return v.kind; }
+
+    static bool getBoolean (const TestVariant &v) { return v.b; }
+    static void get (const TestVariant &v, epicsInt8 &value) { value = v.i8; }
+    static void get (const TestVariant &v, epicsUInt8 &value) { value = v.u8; }
+    static void get (const TestVariant &v, epicsInt16 &value) { value = v.i16; }
+    static void get (const TestVariant &v, epicsUInt16 &value) { value = v.u16; }
+    static void get (const TestVariant &v, epicsInt32 &value) { value = v.i32; }
+    static void get (const TestVariant &v, epicsUInt32 &value) { value = v.u32; }
+    static void get (const TestVariant &v, epicsInt64 &value) { value = v.i64; }
+    static void get (const TestVariant &v, epicsUInt64 &value) { value = v.u64; }
+    static void get (const TestVariant &v, epicsFloat32 &value) { value = v.f32; }
+    static void get (const TestVariant &v, epicsFloat64 &value) { value = v.f64; }
+    static void getText (const TestVariant &v, const char *&str, size_t &len)
+    {
+        str = v.text.data();
+        len = v.text.size();
+    }
+
+    static int setBoolean (TestVariant &v, const bool value) { v.kind = ScalarKind::boolean; v.b = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsInt8 value) { v.kind = ScalarKind::sByte; v.i8 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsUInt8 value) { v.kind = ScalarKind::byte; v.u8 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsInt16 value) { v.kind = ScalarKind::int16; v.i16 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsUInt16 value) { v.kind = ScalarKind::uInt16; v.u16 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsInt32 value) { v.kind = ScalarKind::int32; v.i32 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsUInt32 value) { v.kind = ScalarKind::uInt32; v.u32 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsInt64 value) { v.kind = ScalarKind::int64; v.i64 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsUInt64 value) { v.kind = ScalarKind::uInt64; v.u64 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsFloat32 value) { v.kind = ScalarKind::float32; v.f32 = value; return ++v.setCount; }
+    static int set (TestVariant &v, const epicsFloat64 value) { v.kind = ScalarKind::float64; v.f64 = value; return ++v.setCount; }
+    static int setText (TestVariant &v, const ScalarKind kind, const char *str, const size_t len,
+                        const TestVariant &incoming)
+    {
+        v.kind = kind;
+        v.text.assign(str, len);
+        v.locale = incoming.locale;
+        return ++v.setCount;
+    }
+};
+
+typedef LeafConversion<TestTraits> TestConversion;
+
+TestVariant
+makeInt32 (const epicsInt32 value, const ScalarKind kind = ScalarKind::int32)
+{
+    TestVariant v;
+    v.kind = kind;
+    v.i32 = value;
+    return v;
+}
+
+TestVariant
+makeText (const std::string &text, const ScalarKind kind = ScalarKind::string)
+{
+    TestVariant v;
+    v.kind = kind;
+    v.text = text;
+    return v;
+}
+
+// Incoming data
+
+TEST(LeafConversionTest, toEpics_Numeric)
+{
+    epicsInt32 i32 = 0;
+    EXPECT_EQ(TestConversion::toEpics(makeInt32(-5), i32), ConversionResult::ok) << "Int32 -> epicsInt32 failed";
+    EXPECT_EQ(i32, -5) << "Int32 -> epicsInt32 returned wrong value";
+
+    epicsUInt32 u32 = 0;
+    EXPECT_EQ(TestConversion::toEpics(makeInt32(-5), u32), ConversionResult::outOfRange)
+        << "Int32 -5 -> epicsUInt32 not detected as out of range";
+
+    TestVariant d;
+    d.kind = ScalarKind::float64;
+    d.f64 = 1e20;
+    epicsInt64 i64 = 0;
+    EXPECT_EQ(TestConversion::toEpics(d, i64), ConversionResult::outOfRange)
+        << "Double 1e20 -> epicsInt64 not detected as out of range";
+    epicsFloat64 f64 = 0.0;
+    EXPECT_EQ(TestConversion::toEpics(d, f64), ConversionResult::ok) << "Double -> epicsFloat64 failed";
+    EXPECT_EQ(f64, 1e20) << "Double -> epicsFloat64 returned wrong value";
+
+    TestVariant b;
+    b.kind = ScalarKind::boolean;
+    b.b = true;
+    EXPECT_EQ(TestConversion::toEpics(b, i32), ConversionResult::ok) << "Boolean -> epicsInt32 failed";
+    EXPECT_EQ(i32, 1) << "Boolean true -> epicsInt32 returned wrong value";
+}
+
+TEST(LeafConversionTest, toEpics_StringAndUnsupported)
+{
+    epicsInt32 i32 = 0;
+    EXPECT_EQ(TestConversion::toEpics(makeText("0x10"), i32), ConversionResult::ok) << "String -> epicsInt32 failed";
+    EXPECT_EQ(i32, 16) << "String \"0x10\" -> epicsInt32 returned wrong value";
+    EXPECT_EQ(TestConversion::toEpics(makeText("42", ScalarKind::localizedText), i32), ConversionResult::ok)
+        << "LocalizedText -> epicsInt32 failed";
+    EXPECT_EQ(i32, 42) << "LocalizedText \"42\" -> epicsInt32 returned wrong value";
+    EXPECT_EQ(TestConversion::toEpics(makeText("abc"), i32), ConversionResult::outOfRange)
+        << "String \"abc\" -> epicsInt32 not detected as invalid";
+    EXPECT_EQ(TestConversion::toEpics(TestVariant(), i32), ConversionResult::unsupported)
+        << "unsupported kind not detected";
+}
+
+TEST(LeafConversionTest, toEpics_Enum)
+{
+    EnumChoices choices = {{0, "Off"}, {1, "On"}};
+    epicsUInt32 u32 = 0;
+    EXPECT_EQ(TestConversion::toEpics(makeInt32(1, ScalarKind::enumeration), u32, &choices), ConversionResult::ok)
+        << "valid enum value not converted";
+    EXPECT_EQ(u32, 1u) << "enum value returned wrong value";
+    EXPECT_EQ(TestConversion::toEpics(makeInt32(2, ScalarKind::enumeration), u32, &choices),
+              ConversionResult::outOfRange)
+        << "undefined enum value not detected";
+}
+
+// Outgoing data
+
+TEST(LeafConversionTest, fromEpics_Numeric)
+{
+    TestVariant in, out;
+    int status = 0;
+    EXPECT_EQ(TestConversion::fromEpics(static_cast<epicsInt32>(200), ScalarKind::byte, in, out, nullptr, status),
+              ConversionResult::ok)
+        << "epicsInt32 200 -> Byte failed";
+    EXPECT_EQ(out.kind, ScalarKind::byte) << "epicsInt32 -> Byte set wrong type";
+    EXPECT_EQ(out.u8, 200) << "epicsInt32 -> Byte set wrong value";
+    EXPECT_EQ(status, 1) << "status of set operation not returned";
+
+    EXPECT_EQ(TestConversion::fromEpics(static_cast<epicsInt32>(300), ScalarKind::byte, in, out, nullptr, status),
+              ConversionResult::outOfRange)
+        << "epicsInt32 300 -> Byte not detected as out of range";
+    EXPECT_EQ(out.setCount, 1) << "out of range value was written";
+
+    EXPECT_EQ(TestConversion::fromEpics(static_cast<epicsFloat64>(1e40), ScalarKind::float32, in, out, nullptr, status),
+              ConversionResult::outOfRange)
+        << "epicsFloat64 1e40 -> Float not detected as out of range";
+    EXPECT_EQ(TestConversion::fromEpics(static_cast<epicsInt64>(-1), ScalarKind::uInt64, in, out, nullptr, status),
+              ConversionResult::outOfRange)
+        << "epicsInt64 -1 -> UInt64 not detected as out of range";
+    EXPECT_EQ(TestConversion::fromEpics(static_cast<epicsUInt32>(7), ScalarKind::unsupported, in, out, nullptr, status),
+              ConversionResult::unsupported)
+        << "unsupported kind not detected";
+}
+
+TEST(LeafConversionTest, fromEpics_StringAndEnum)
+{
+    TestVariant in, out;
+    in.locale = "en";
+    int status = 0;
+    EXPECT_EQ(TestConversion::fromEpics(static_cast<epicsInt32>(-12), ScalarKind::localizedText, in, out, nullptr, status),
+              ConversionResult::ok)
+        << "epicsInt32 -> LocalizedText failed";
+    EXPECT_EQ(out.text, "-12") << "epicsInt32 -> LocalizedText set wrong text";
+    EXPECT_EQ(out.locale, "en") << "epicsInt32 -> LocalizedText did not keep the locale";
+
+    EnumChoices choices = {{0, "Off"}, {1, "On"}};
+    EXPECT_EQ(TestConversion::fromEpics(static_cast<epicsUInt32>(1), ScalarKind::enumeration, in, out, &choices, status),
+              ConversionResult::ok)
+        << "valid enum value not written";
+    EXPECT_EQ(out.kind, ScalarKind::int32) << "enum value not written as Int32";
+    EXPECT_EQ(TestConversion::fromEpics(static_cast<epicsUInt32>(5), ScalarKind::enumeration, in, out, &choices, status),
+              ConversionResult::outOfRange)
+        << "undefined enum value not detected";
+}
+
+TEST(LeafConversionTest, fromString)
+{
+    TestVariant out;
+    int status = 0;
+    EXPECT_EQ(TestConversion::fromString("-129", 4, ScalarKind::sByte, out, nullptr, status),
+              ConversionResult::outOfRange)
+        << "\"-129\" -> SByte not detected as out of range";
+    EXPECT_EQ(TestConversion::fromString("-128", 4, ScalarKind::sByte, out, nullptr, status), ConversionResult::ok)
+        << "\"-128\" -> SByte failed";
+    EXPECT_EQ(out.i8, -128) << "\"-128\" -> SByte set wrong value";
+    EXPECT_EQ(TestConversion::fromString("2.5", 3, ScalarKind::float64, out, nullptr, status), ConversionResult::ok)
+        << "\"2.5\" -> Double failed";
+    EXPECT_EQ(out.f64, 2.5) << "\"2.5\" -> Double set wrong value";
+    EXPECT_EQ(TestConversion::fromString("yes", 3, ScalarKind::boolean, out, nullptr, status), ConversionResult::ok)
+        << "\"yes\" -> Boolean failed";
+    EXPECT_TRUE(out.b) << "\"yes\" -> Boolean set wrong value";
+
+    // enum strings have precedence over numbers
+    EnumChoices choices = {{0, "1st"}, {1, "0"}, {7, "Seven"}};
+    EXPECT_EQ(TestConversion::fromString("Seven", 5, ScalarKind::enumeration, out, &choices, status),
+              ConversionResult::ok)
+        << "enum string not converted";
+    EXPECT_EQ(out.i32, 7) << "enum string set wrong value";
+    EXPECT_EQ(TestConversion::fromString("0", 1, ScalarKind::enumeration, out, &choices, status), ConversionResult::ok)
+        << "enum string \"0\" not converted";
+    EXPECT_EQ(out.i32, 1) << "enum string \"0\" not preferred over number";
+    EXPECT_EQ(TestConversion::fromString("7", 1, ScalarKind::enumeration, out, &choices, status), ConversionResult::ok)
+        << "numeric enum value not converted";
+    EXPECT_EQ(out.i32, 7) << "numeric enum value set wrong value";
+    EXPECT_EQ(TestConversion::fromString("3", 1, ScalarKind::enumeration, out, &choices, status),
+              ConversionResult::outOfRange)
+        << "undefined numeric enum value not detected";
+    EXPECT_EQ(TestConversion::fromString("Sev", 3, ScalarKind::enumeration, out, &choices, status),
+              ConversionResult::outOfRange)
+        << "partial enum string accepted";
+}
+
+TEST(LeafConversionTest, copyArray)
+{
+    const epicsInt16 in[5] = {1, 2, 3, 4, 5};
+    epicsInt16 out[3] = {0, 0, 0};
+    EXPECT_EQ(TestConversion::copyArray(out, 3, in, 5), 3u) << "copy into smaller array returned wrong size";
+    EXPECT_EQ(out[2], 3) << "copy into smaller array copied wrong data";
+    EXPECT_EQ(TestConversion::copyArray(out, 3, in, 2), 2u) << "copy of smaller array returned wrong size";
+    EXPECT_EQ(TestConversion::copyArray(out, 3, nullptr, 0), 0u) << "copy of empty array returned wrong size";
+}
+
+// Benchmarks: throughput of the conversion core (same code for all client libraries)
+
+const unsigned int noOfConversions = 1000000;
+
+void
+report (const char *what, const double elapsed)
+{
+    std::cout << "[ BENCHMARK] " << what << ": "
+              << noOfConversions / elapsed / 1e6 << " M conversions/s ("
+              << elapsed * 1e9 / noOfConversions << " ns each)" << std::endl;
+}
+
+TEST(LeafConversionTest, benchmark_IncomingScalar)
+{
+    std::vector<TestVariant> input;
+    const ScalarKind kinds[] = {ScalarKind::int16, ScalarKind::int32, ScalarKind::float64, ScalarKind::string};
+    for (unsigned int i = 0; i < 1000; i++) {
+        TestVariant v;
+        v.kind = kinds[i % 4];
+        switch (v.kind) {
+        case ScalarKind::int16: v.i16 = static_cast<epicsInt16>(i); break;
+        case ScalarKind::int32: v.i32 = static_cast<epicsInt32>(i * 1000); break;
+        case ScalarKind::float64: v.f64 = i * 0.5; break;
+        default: v.text = std::to_string(i); break;
+        }
+        input.push_back(v);
+    }
+
+    epicsFloat64 sum = 0.0;
+    epicsTime start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++) {
+        epicsFloat64 value;
+        if (TestConversion::toEpics(input[i % input.size()], value) == ConversionResult::ok)
+            sum += value;
+    }
+    report("toEpics<epicsFloat64> (mixed kinds)", epicsTime::getCurrent() - start);
+    EXPECT_GT(sum, 0.0);
+}
+
+TEST(LeafConversionTest, benchmark_OutgoingScalar)
+{
+    TestVariant in, out;
+    int status = 0;
+    const ScalarKind kinds[] = {ScalarKind::byte, ScalarKind::int32, ScalarKind::float32, ScalarKind::uInt64};
+
+    unsigned int converted = 0;
+    epicsTime start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++) {
+        if (TestConversion::fromEpics(static_cast<epicsInt32>(i % 300), kinds[i % 4], in, out, nullptr, status)
+            == ConversionResult::ok)
+            converted++;
+    }
+    report("fromEpics<epicsInt32> (mixed kinds)", epicsTime::getCurrent() - start);
+    EXPECT_GT(converted, noOfConversions / 2);
+}
+
+TEST(LeafConversionTest, benchmark_CopyArray)
+{
+    std::vector<epicsFloat64> in(1000, 1.5), out(1000);
+
+    epicsTime start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions / 100; i++)
+        TestConversion::copyArray(out.data(), static_cast<epicsUInt32>(out.size()), in.data(), in.size());
+    double elapsed = epicsTime::getCurrent() - start;
+    std::cout << "[ BENCHMARK] copyArray<epicsFloat64>[1000]: "
+              << noOfConversions / 100 / elapsed / 1e6 << " M arrays/s ("
+              << elapsed * 1e9 / (noOfConversions / 100) << " ns each)" << std::endl;
+    EXPECT_EQ(out[999], 1.5);
+}
+
+} // namespace
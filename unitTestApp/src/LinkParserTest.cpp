@@ -172,4 +172,123 @@ TEST(LinkParserTest, splitString_endsWithTwoDelimiters) {
     EXPECT_EQ(*it++, "") << "path[2] not empty after splitting '" << s << "'";
 }
 
+
+/* std::list<BrowsePathElement> parseBrowsePath(const std::string &path);
+ *
+ * @brief Parse a relative browse path (OPC UA Part 4, A.2; '/' and '.' only).
+ *
+ * @param path  relative browse path
+ *
+ * @return  path elements in order of appearance as list<BrowsePathElement>
+ *
+ * @throws  std::runtime_error on syntax errors
+ */
+
+TEST(LinkParserTest, parseBrowsePath_oneElem) {
+    const std::string s = "/Objects";
+    auto path = parseBrowsePath(s);
+    EXPECT_EQ(path.size(), 1u) << "path doesn't have 1 element after parsing '" << s << "'";
+    auto it = path.begin();
+    EXPECT_FALSE(it->aggregates) << "path[0] not hierarchical after parsing '" << s << "'";
+    EXPECT_EQ(it->namespaceIndex, 0u) << "path[0] not in ns 0 after parsing '" << s << "'";
+    EXPECT_EQ(it->name, "Objects") << "path[0] not 'Objects' after parsing '" << s << "'";
+}
+
+TEST(LinkParserTest, parseBrowsePath_namespacesAndReferences) {
+    const std::string s = "/2:Machine/3:Axis.2:Position";
+    auto path = parseBrowsePath(s);
+    EXPECT_EQ(path.size(), 3u) << "path doesn't have 3 elements after parsing '" << s << "'";
+    auto it = path.begin();
+    EXPECT_FALSE(it->aggregates) << "path[0] not hierarchical after parsing '" << s << "'";
+    EXPECT_EQ(it->namespaceIndex, 2u) << "path[0] not in ns 2 after parsing '" << s << "'";
+    EXPECT_EQ(it->name, "Machine") << "path[0] not 'Machine' after parsing '" << s << "'";
+    it++;
+    EXPECT_FALSE(it->aggregates) << "path[1] not hierarchical after parsing '" << s << "'";
+    EXPECT_EQ(it->namespaceIndex, 3u) << "path[1] not in ns 3 after parsing '" << s << "'";
+    EXPECT_EQ(it->name, "Axis") << "path[1] not 'Axis' after parsing '" << s << "'";
+    it++;
+    EXPECT_TRUE(it->aggregates) << "path[2] not aggregates after parsing '" << s << "'";
+    EXPECT_EQ(it->namespaceIndex, 2u) << "path[2] not in ns 2 after parsing '" << s << "'";
+    EXPECT_EQ(it->name, "Position") << "path[2] not 'Position' after parsing '" << s << "'";
+}
+
+TEST(LinkParserTest, parseBrowsePath_escapedCharacters) {
+    const std::string s = "/2:a&/b&.c&&d/1&:x/e:f";
+    auto path = parseBrowsePath(s);
+    EXPECT_EQ(path.size(), 3u) << "path doesn't have 3 elements after parsing '" << s << "'";
+    auto it = path.begin();
+    EXPECT_EQ(it->name, "a/b.c&d") << "path[0] not 'a/b.c&d' after parsing '" << s << "'";
+    it++;
+    EXPECT_EQ(it->namespaceIndex, 0u) << "path[1] not in ns 0 after parsing '" << s << "'";
+    EXPECT_EQ(it->name, "1:x") << "path[1] not '1:x' after parsing '" << s << "'";
+    it++;
+    EXPECT_EQ(it->namespaceIndex, 0u) << "path[2] not in ns 0 after parsing '" << s << "'";
+    EXPECT_EQ(it->name, "e:f") << "path[2] not 'e:f' after parsing '" << s << "'";
+}
+
+TEST(LinkParserTest, parseBrowsePath_errors) {
+    EXPECT_THROW(parseBrowsePath(""), std::runtime_error) << "no exception for empty path";
+    EXPECT_THROW(parseBrowsePath("Objects"), std::runtime_error) << "no exception for missing '/'";
+    EXPECT_THROW(parseBrowsePath("/a//b"), std::runtime_error) << "no exception for empty browse name";
+    EXPECT_THROW(parseBrowsePath("/2:"), std::runtime_error) << "no exception for empty browse name";
+    EXPECT_THROW(parseBrowsePath("/a&"), std::runtime_error) << "no exception for dangling escape";
+    EXPECT_THROW(parseBrowsePath("/99999:a"), std::runtime_error) << "no exception for illegal namespace";
+}
+
+/* void parseLinkOption(linkInfo &info, const std::string &optname, const std::string &optval);
+ * void checkLinkOptions(const linkInfo &info);
+ *
+ * @brief Apply a single link option / check the combination of options.
+ */
+
+TEST(LinkParserTest, parseLinkOption_groupsAndTrigger) {
+    linkInfo info;
+    parseLinkOption(info, "readgroup", "snap");
+    EXPECT_EQ(info.readGroup, "snap") << "readgroup not set";
+    parseLinkOption(info, "writegroup", "recipe");
+    EXPECT_EQ(info.writeGroup, "recipe") << "writegroup not set";
+    parseLinkOption(info, "commit", "y");
+    EXPECT_TRUE(info.commit) << "commit not set";
+    parseLinkOption(info, "trigger", "REC:STATUS");
+    EXPECT_EQ(info.trigger, "REC:STATUS") << "trigger not set";
+    parseLinkOption(info, "maxage", "500");
+    EXPECT_EQ(info.maxAge, 500.0) << "maxage not set";
+    parseLinkOption(info, "idle", "y");
+    EXPECT_TRUE(info.idle) << "idle not set";
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "exception for commit with writegroup";
+}
+
+TEST(LinkParserTest, parseLinkOption_errors) {
+    linkInfo info;
+    EXPECT_THROW(parseLinkOption(info, "maxage", "-1"), std::runtime_error) << "no exception for negative maxage";
+    EXPECT_THROW(parseLinkOption(info, "maxage", "abc"), std::runtime_error) << "no exception for illegal maxage";
+    EXPECT_THROW(parseLinkOption(info, "commit", ""), std::runtime_error) << "no exception for empty commit";
+    EXPECT_THROW(parseLinkOption(info, "idle", ""), std::runtime_error) << "no exception for empty idle";
+    EXPECT_THROW(parseLinkOption(info, "nosuchoption", "1"), std::runtime_error) << "no exception for unknown option";
+
+    info.linkedToItem = false;
+    EXPECT_THROW(parseLinkOption(info, "readgroup", "snap"), std::runtime_error)
+        << "no exception for readgroup in a link to an opcuaItem record";
+    EXPECT_THROW(parseLinkOption(info, "trigger", "REC"), std::runtime_error)
+        << "no exception for trigger in a link to an opcuaItem record";
+}
+
+TEST(LinkParserTest, checkLinkOptions_commitWithoutWriteGroup) {
+    linkInfo info;
+    parseLinkOption(info, "commit", "y");
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "no exception for commit without writegroup";
+    parseLinkOption(info, "commit", "n");
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "exception for commit=n without writegroup";
+}
+
+TEST(LinkParserTest, checkLinkOptions_idleOnItemRecord) {
+    linkInfo info;
+    parseLinkOption(info, "idle", "y");
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "exception for idle on a regular record";
+    info.isItemRecord = true;
+    EXPECT_THROW(checkLinkOptions(info), std::runtime_error) << "no exception for idle on an item record";
+    parseLinkOption(info, "idle", "n");
+    EXPECT_NO_THROW(checkLinkOptions(info)) << "exception for idle=n on an item record";
+}
+
 } // namespace
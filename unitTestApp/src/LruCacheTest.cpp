@@ -0,0 +1,116 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "LruCache.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+TEST(LruCacheTest, insert_find_ReturnsValues)
+{
+    LruCache<std::string, int> c(3);
+    EXPECT_TRUE(c.empty()) << "new cache is not empty";
+    c.insert("a") = 1;
+    c.insert("b") = 2;
+    EXPECT_EQ(c.size(), 2u) << "cache with 2 entries has wrong size";
+    ASSERT_NE(c.find("a"), nullptr) << "entry 'a' not found";
+    EXPECT_EQ(*c.find("a"), 1) << "entry 'a' has wrong value";
+    EXPECT_EQ(*c.find("b"), 2) << "entry 'b' has wrong value";
+    EXPECT_EQ(c.find("c"), nullptr) << "missing entry 'c' found";
+    EXPECT_EQ(c.insert("a"), 1) << "inserting existing entry 'a' changed its value";
+    EXPECT_EQ(c.size(), 2u) << "inserting existing entry changed the size";
+}
+
+TEST(LruCacheTest, insert_full_EvictsLeastRecentlyUsed)
+{
+    LruCache<int, int> c(3);
+    c.insert(1) = 10;
+    c.insert(2) = 20;
+    c.insert(3) = 30;
+    c.find(1); // 2 is now least recently used
+    c.insert(4) = 40;
+    EXPECT_EQ(c.size(), 3u) << "full cache grew beyond its capacity";
+    EXPECT_EQ(c.find(2), nullptr) << "least recently used entry not evicted";
+    EXPECT_NE(c.find(1), nullptr) << "recently used entry evicted";
+    EXPECT_NE(c.find(3), nullptr) << "entry 3 evicted";
+    EXPECT_NE(c.find(4), nullptr) << "new entry missing";
+    EXPECT_EQ(c.evicted(), 1ul) << "eviction not counted";
+}
+
+TEST(LruCacheTest, steadyWorkloadAboveCapacity_KeepsHotEntries)
+{
+    // One hot entry used every cycle, and a stream of cold ones
+    LruCache<int, int> c(4);
+    for (int cycle = 0; cycle < 100; cycle++) {
+        if (!c.find(0))
+            c.insert(0) = cycle;
+        c.insert(1000 + cycle);
+    }
+    ASSERT_NE(c.find(0), nullptr) << "hot entry evicted";
+    EXPECT_EQ(*c.find(0), 0) << "hot entry was rebuilt";
+    EXPECT_EQ(c.size(), 4u) << "cache size not at capacity";
+}
+
+TEST(LruCacheTest, valuePointers_StayValid)
+{
+    LruCache<int, std::vector<int>> c(10);
+    std::vector<int> *p = &c.insert(1);
+    p->push_back(42);
+    for (int i = 2; i < 10; i++)
+        c.insert(i);
+    c.find(1);
+    EXPECT_EQ(c.find(1), p) << "value moved after inserts";
+    EXPECT_EQ(p->front(), 42) << "value changed after inserts";
+}
+
+TEST(LruCacheTest, erase_clear_setCapacity)
+{
+    LruCache<int, int> c(5);
+    for (int i = 0; i < 5; i++)
+        c.insert(i) = i;
+    c.erase(2);
+    c.erase(99); // not present
+    EXPECT_EQ(c.size(), 4u) << "erase did not remove the entry";
+    EXPECT_EQ(c.find(2), nullptr) << "erased entry found";
+    c.find(0);
+    c.setCapacity(2);
+    EXPECT_EQ(c.size(), 2u) << "shrinking did not evict";
+    EXPECT_NE(c.find(0), nullptr) << "most recently used entry evicted when shrinking";
+    EXPECT_NE(c.find(4), nullptr) << "second most recently used entry evicted when shrinking";
+    c.clear();
+    EXPECT_TRUE(c.empty()) << "clear did not empty the cache";
+}
+
+struct SortedLess
+{
+    bool operator()(std::vector<int> a, std::vector<int> b) const
+    {
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        return a < b;
+    }
+};
+
+TEST(LruCacheTest, customCompare_OrderInsensitiveKeys)
+{
+    LruCache<std::vector<int>, int, SortedLess> c(2);
+    c.insert({3, 1, 2}) = 7;
+    ASSERT_NE(c.find({1, 2, 3}), nullptr) << "same set in a different order not found";
+    EXPECT_EQ(*c.find({2, 3, 1}), 7) << "same set in a different order has wrong value";
+    EXPECT_EQ(c.find({1, 2}), nullptr) << "subset found";
+}
+
+} // namespace
@@ -0,0 +1,109 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <gtest/gtest.h>
+
+#include <epicsTime.h>
+
+#include "ReconnectPolicy.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+// Exponential backoff
+
+TEST(ReconnectPolicyTest, backoffDelay_GrowsUpToMax)
+{
+    EXPECT_EQ(backoffDelay(5.0, 0, 2.0, 60.0), 5.0) << "first attempt doesn't use the initial delay";
+    EXPECT_EQ(backoffDelay(5.0, 1, 2.0, 60.0), 5.0) << "second attempt doesn't use the initial delay";
+    EXPECT_EQ(backoffDelay(5.0, 2, 2.0, 60.0), 10.0) << "delay doesn't grow by the factor";
+    EXPECT_EQ(backoffDelay(5.0, 4, 2.0, 60.0), 40.0) << "delay doesn't grow by the factor";
+    EXPECT_EQ(backoffDelay(5.0, 5, 2.0, 60.0), 60.0) << "delay isn't limited to the max";
+    EXPECT_EQ(backoffDelay(5.0, 1000, 2.0, 60.0), 60.0) << "delay isn't limited to the max";
+}
+
+TEST(ReconnectPolicyTest, backoffDelay_FixedInterval)
+{
+    EXPECT_EQ(backoffDelay(5.0, 10, 1.0, 60.0), 5.0) << "factor 1 doesn't keep a fixed interval";
+    EXPECT_EQ(backoffDelay(5.0, 10, 0.5, 60.0), 5.0) << "factor < 1 doesn't keep a fixed interval";
+    EXPECT_EQ(backoffDelay(5.0, 10, 2.0, 1.0), 5.0) << "max below the initial delay shortens it";
+}
+
+// Jitter
+
+TEST(ReconnectPolicyTest, jitterDelay_Range)
+{
+    EXPECT_EQ(jitterDelay(10.0, 0.0, 0.9), 10.0) << "no jitter changes the delay";
+    EXPECT_DOUBLE_EQ(jitterDelay(10.0, 0.2, 0.0), 8.0) << "lowest random number doesn't subtract the jitter";
+    EXPECT_DOUBLE_EQ(jitterDelay(10.0, 0.2, 0.5), 10.0) << "middle random number changes the delay";
+    EXPECT_LT(jitterDelay(10.0, 0.2, 0.9999), 12.0) << "jitter exceeds the fraction";
+}
+
+TEST(ReconnectPolicyTest, lcgRandom_RangeAndSpread)
+{
+    unsigned int seed = 42;
+    unsigned int low = 0, high = 0;
+    for (int i = 0; i < 10000; i++) {
+        double r = lcgRandom(seed);
+        ASSERT_GE(r, 0.0) << "random number below 0";
+        ASSERT_LT(r, 1.0) << "random number not below 1";
+        if (r < 0.5)
+            low++;
+        else
+            high++;
+    }
+    EXPECT_GT(low, 4500u) << "random numbers are not spread evenly";
+    EXPECT_GT(high, 4500u) << "random numbers are not spread evenly";
+
+    unsigned int a = 1, b = 2;
+    EXPECT_NE(lcgRandom(a), lcgRandom(b)) << "different seeds give the same sequence";
+}
+
+// Rate limiting
+
+TEST(ReconnectPolicyTest, TokenBucket_NoLimit)
+{
+    TokenBucket bucket;
+    epicsTime now = epicsTime::getCurrent();
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(bucket.take(now, 0.0), 0.0) << "rate 0 limits the attempts";
+}
+
+TEST(ReconnectPolicyTest, TokenBucket_BurstThenRate)
+{
+    TokenBucket bucket;
+    epicsTime now = epicsTime::getCurrent();
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(bucket.take(now, 4.0), 0.0) << "initial burst of 4 attempts is limited";
+    double wait = bucket.take(now, 4.0);
+    EXPECT_DOUBLE_EQ(wait, 0.25) << "empty bucket doesn't wait for the next token";
+
+    now += 0.25;
+    EXPECT_EQ(bucket.take(now, 4.0), 0.0) << "refilled token can't be taken";
+    EXPECT_GT(bucket.take(now, 4.0), 0.0) << "more tokens than refilled can be taken";
+
+    now += 100.0;
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(bucket.take(now, 4.0), 0.0) << "bucket doesn't refill to the burst size";
+    EXPECT_GT(bucket.take(now, 4.0), 0.0) << "bucket refills beyond the burst size";
+}
+
+TEST(ReconnectPolicyTest, TokenBucket_SlowRate)
+{
+    TokenBucket bucket;
+    epicsTime now = epicsTime::getCurrent();
+    EXPECT_EQ(bucket.take(now, 0.5), 0.0) << "first attempt is limited";
+    EXPECT_DOUBLE_EQ(bucket.take(now, 0.5), 2.0) << "rate below 1/s doesn't wait for a full token";
+    now += 1.0;
+    EXPECT_DOUBLE_EQ(bucket.take(now, 0.5), 1.0) << "half a token doesn't halve the wait";
+}
+
+} // namespace
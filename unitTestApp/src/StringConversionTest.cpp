@@ -0,0 +1,284 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <iostream>
+
+#include <epicsTypes.h>
+#include <epicsTime.h>
+
+#include "StringConversion.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+// Parsing integers
+
+TEST(StringConversionTest, parseNumber_Decimal)
+{
+    epicsInt32 i32 = 0;
+    EXPECT_TRUE(parseNumber("12345", i32)) << "parsing \"12345\" failed";
+    EXPECT_EQ(i32, 12345) << "parsing \"12345\" returned wrong value";
+    EXPECT_TRUE(parseNumber("  -42", i32)) << "parsing \"  -42\" failed";
+    EXPECT_EQ(i32, -42) << "parsing \"  -42\" returned wrong value";
+    EXPECT_TRUE(parseNumber("+7", i32)) << "parsing \"+7\" failed";
+    EXPECT_EQ(i32, 7) << "parsing \"+7\" returned wrong value";
+}
+
+TEST(StringConversionTest, parseNumber_HexAndOctal)
+{
+    epicsUInt32 u32 = 0;
+    EXPECT_TRUE(parseNumber("0x1F", u32)) << "parsing \"0x1F\" failed";
+    EXPECT_EQ(u32, 31u) << "parsing \"0x1F\" returned wrong value";
+    EXPECT_TRUE(parseNumber("010", u32)) << "parsing \"010\" failed";
+    EXPECT_EQ(u32, 8u) << "parsing \"010\" (octal) returned wrong value";
+    EXPECT_TRUE(parseNumber("0", u32)) << "parsing \"0\" failed";
+    EXPECT_EQ(u32, 0u) << "parsing \"0\" returned wrong value";
+}
+
+TEST(StringConversionTest, parseNumber_StopsAtGarbage)
+{
+    epicsInt64 i64 = 0;
+    const char *str = "123abc";
+    const char *end = nullptr;
+    EXPECT_TRUE(parseNumber(str, i64, &end)) << "parsing \"123abc\" failed";
+    EXPECT_EQ(i64, 123) << "parsing \"123abc\" returned wrong value";
+    EXPECT_EQ(end, str + 3) << "parsing \"123abc\" returned wrong end position";
+}
+
+TEST(StringConversionTest, parseNumber_NoNumber)
+{
+    epicsInt32 i32 = 99;
+    const char *str = "abc";
+    const char *end = nullptr;
+    EXPECT_FALSE(parseNumber(str, i32, &end)) << "parsing \"abc\" did not fail";
+    EXPECT_EQ(end, str) << "parsing \"abc\" did not return the start as end position";
+    EXPECT_EQ(i32, 99) << "failed parsing changed the value";
+    EXPECT_FALSE(parseNumber("", i32)) << "parsing empty string did not fail";
+    EXPECT_FALSE(parseNumber("-", i32)) << "parsing \"-\" did not fail";
+}
+
+TEST(StringConversionTest, parseNumber_Limits)
+{
+    epicsInt8 i8 = 0;
+    EXPECT_TRUE(parseNumber("-128", i8)) << "parsing minimum of epicsInt8 failed";
+    EXPECT_EQ(i8, -128) << "parsing minimum of epicsInt8 returned wrong value";
+    EXPECT_FALSE(parseNumber("128", i8)) << "parsing 128 into epicsInt8 did not fail";
+    EXPECT_FALSE(parseNumber("-129", i8)) << "parsing -129 into epicsInt8 did not fail";
+
+    epicsInt64 i64 = 0;
+    EXPECT_TRUE(parseNumber("-9223372036854775808", i64)) << "parsing minimum of epicsInt64 failed";
+    EXPECT_EQ(i64, std::numeric_limits<epicsInt64>::min())
+        << "parsing minimum of epicsInt64 returned wrong value";
+    EXPECT_FALSE(parseNumber("9223372036854775808", i64))
+        << "parsing maximum+1 of epicsInt64 did not fail";
+
+    epicsUInt64 u64 = 0;
+    EXPECT_TRUE(parseNumber("18446744073709551615", u64)) << "parsing maximum of epicsUInt64 failed";
+    EXPECT_EQ(u64, std::numeric_limits<epicsUInt64>::max())
+        << "parsing maximum of epicsUInt64 returned wrong value";
+    EXPECT_FALSE(parseNumber("18446744073709551616", u64))
+        << "parsing maximum+1 of epicsUInt64 did not fail (overflow)";
+}
+
+TEST(StringConversionTest, parseNumber_NegativeIntoUnsigned)
+{
+    epicsUInt16 u16 = 5;
+    EXPECT_FALSE(parseNumber("-1", u16)) << "parsing \"-1\" into unsigned did not fail";
+    EXPECT_EQ(u16, 5u) << "failed parsing changed the value";
+    EXPECT_TRUE(parseNumber("-0", u16)) << "parsing \"-0\" into unsigned failed";
+}
+
+TEST(StringConversionTest, parseNumber_NotNullTerminated)
+{
+    const char buf[] = {'4', '2', '7'};
+    epicsInt32 i32 = 0;
+    EXPECT_TRUE(parseNumber(buf, 2, i32)) << "parsing 2 chars of \"427\" failed";
+    EXPECT_EQ(i32, 42) << "parsing 2 chars of \"427\" returned wrong value";
+
+    epicsFloat64 f64 = 0.0;
+    const char fbuf[] = {'1', '.', '5', '9'};
+    EXPECT_TRUE(parseNumber(fbuf, 3, f64)) << "parsing 3 chars of \"1.59\" failed";
+    EXPECT_EQ(f64, 1.5) << "parsing 3 chars of \"1.59\" returned wrong value";
+
+    const char sbuf[] = {'2', '.', '5', ' ', '9'};
+    const char *end = nullptr;
+    EXPECT_TRUE(parseNumber(sbuf, 5, f64, &end)) << "parsing \"2.5 9\" failed";
+    EXPECT_EQ(f64, 2.5) << "parsing \"2.5 9\" returned wrong value";
+    EXPECT_EQ(end, sbuf + 3) << "parsing \"2.5 9\" returned wrong end position";
+
+    const char nbuf[] = {'3', '\0', '7'};
+    EXPECT_TRUE(parseNumber(nbuf, 3, f64, &end)) << "parsing \"3\\07\" failed";
+    EXPECT_EQ(f64, 3.0) << "parsing \"3\\07\" returned wrong value";
+    EXPECT_EQ(end, nbuf + 1) << "parsing \"3\\07\" returned wrong end position";
+}
+
+// Parsing floating point numbers
+
+TEST(StringConversionTest, parseNumber_Float)
+{
+    epicsFloat64 f64 = 0.0;
+    EXPECT_TRUE(parseNumber(" -2.5e3", f64)) << "parsing \" -2.5e3\" failed";
+    EXPECT_EQ(f64, -2500.0) << "parsing \" -2.5e3\" returned wrong value";
+    EXPECT_FALSE(parseNumber("1e999", f64)) << "parsing overflowing double did not fail";
+    EXPECT_FALSE(parseNumber("x1.0", f64)) << "parsing \"x1.0\" did not fail";
+
+    epicsFloat32 f32 = 0.0f;
+    EXPECT_TRUE(parseNumber("0.25", f32)) << "parsing \"0.25\" into float failed";
+    EXPECT_EQ(f32, 0.25f) << "parsing \"0.25\" into float returned wrong value";
+    EXPECT_FALSE(parseNumber("1e300", f32)) << "parsing 1e300 into float did not fail";
+}
+
+// Formatting
+
+TEST(StringConversionTest, formatNumber_MatchesToString)
+{
+    char buf[maxNumberStringLength + 1];
+    const epicsInt64 ints[] = {0, 1, -1, 42, -1234567, std::numeric_limits<epicsInt64>::min(),
+                               std::numeric_limits<epicsInt64>::max()};
+    for (auto v : ints) {
+        size_t n = formatNumber(buf, sizeof(buf), v);
+        EXPECT_EQ(std::string(buf, n), std::to_string(v)) << "formatting " << v << " differs";
+    }
+    const epicsUInt32 u = std::numeric_limits<epicsUInt32>::max();
+    size_t n = formatNumber(buf, sizeof(buf), u);
+    EXPECT_EQ(std::string(buf, n), std::to_string(u)) << "formatting " << u << " differs";
+    const epicsInt8 i8 = std::numeric_limits<epicsInt8>::min();
+    n = formatNumber(buf, sizeof(buf), i8);
+    EXPECT_EQ(std::string(buf, n), "-128") << "formatting epicsInt8 minimum differs";
+
+    const epicsFloat64 doubles[] = {0.0, -1.5, 3.14159265, 1e10, -1e-7,
+                                    std::numeric_limits<epicsFloat64>::max()};
+    for (auto v : doubles) {
+        n = formatNumber(buf, sizeof(buf), v);
+        EXPECT_EQ(std::string(buf, n), std::to_string(v)) << "formatting " << v << " differs";
+    }
+}
+
+TEST(StringConversionTest, formatNumber_BufferTooSmall)
+{
+    char buf[4];
+    EXPECT_EQ(formatNumber(buf, sizeof(buf), 12345), 0u)
+        << "formatting into a too small buffer doesn't return 0";
+    EXPECT_EQ(formatNumber(buf, sizeof(buf), 123), 3u)
+        << "formatting into an exactly fitting buffer fails";
+}
+
+// Benchmarks: throughput of numeric <-> string conversions
+// compared to the std::string based conversions used before
+
+const unsigned int noOfConversions = 1000000;
+
+void
+report (const char *what, const double elapsed)
+{
+    std::cout << "[ BENCHMARK] " << what << ": "
+              << noOfConversions / elapsed / 1e6 << " M conversions/s ("
+              << elapsed * 1e9 / noOfConversions << " ns each)" << std::endl;
+}
+
+TEST(StringConversionTest, benchmark_StringToInteger)
+{
+    std::vector<std::string> input;
+    for (unsigned int i = 0; i < 1000; i++)
+        input.push_back(std::to_string(static_cast<epicsInt32>(i * 2654435761u)));
+
+    epicsInt64 sum = 0;
+    epicsTime start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++) {
+        const std::string &s = input[i % input.size()];
+        epicsInt32 v;
+        if (parseNumber(s.data(), s.size(), v))
+            sum += v;
+    }
+    report("parseNumber<epicsInt32>", epicsTime::getCurrent() - start);
+
+    epicsInt64 refsum = 0;
+    start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++) {
+        const std::string &s = input[i % input.size()];
+        try {
+            refsum += static_cast<epicsInt32>(std::stol(s, 0, 0));
+        } catch (...) {
+        }
+    }
+    report("std::stol", epicsTime::getCurrent() - start);
+    EXPECT_EQ(sum, refsum) << "parseNumber and std::stol results differ";
+}
+
+TEST(StringConversionTest, benchmark_StringToDouble)
+{
+    std::vector<std::string> input;
+    for (unsigned int i = 0; i < 1000; i++)
+        input.push_back(std::to_string(i * 0.37 - 100.0));
+
+    epicsFloat64 sum = 0.0;
+    epicsTime start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++) {
+        const std::string &s = input[i % input.size()];
+        epicsFloat64 v;
+        if (parseNumber(s.c_str(), v))
+            sum += v;
+    }
+    report("parseNumber<epicsFloat64>", epicsTime::getCurrent() - start);
+
+    epicsFloat64 refsum = 0.0;
+    start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++) {
+        const std::string &s = input[i % input.size()];
+        try {
+            refsum += std::stod(s, 0);
+        } catch (...) {
+        }
+    }
+    report("std::stod", epicsTime::getCurrent() - start);
+    EXPECT_EQ(sum, refsum) << "parseNumber and std::stod results differ";
+}
+
+TEST(StringConversionTest, benchmark_IntegerToString)
+{
+    char buf[maxNumberStringLength + 1];
+    size_t total = 0;
+    epicsTime start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++)
+        total += formatNumber(buf, sizeof(buf), static_cast<epicsInt64>(i) * 2654435761LL);
+    report("formatNumber<epicsInt64>", epicsTime::getCurrent() - start);
+
+    size_t reftotal = 0;
+    start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++)
+        reftotal += std::to_string(static_cast<epicsInt64>(i) * 2654435761LL).length();
+    report("std::to_string(epicsInt64)", epicsTime::getCurrent() - start);
+    EXPECT_EQ(total, reftotal) << "formatNumber and std::to_string lengths differ";
+}
+
+TEST(StringConversionTest, benchmark_DoubleToString)
+{
+    char buf[maxNumberStringLength + 1];
+    size_t total = 0;
+    epicsTime start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++)
+        total += formatNumber(buf, sizeof(buf), i * 0.37 - 100.0);
+    report("formatNumber<epicsFloat64>", epicsTime::getCurrent() - start);
+
+    size_t reftotal = 0;
+    start = epicsTime::getCurrent();
+    for (unsigned int i = 0; i < noOfConversions; i++)
+        reftotal += std::to_string(i * 0.37 - 100.0).length();
+    report("std::to_string(epicsFloat64)", epicsTime::getCurrent() - start);
+    EXPECT_EQ(total, reftotal) << "formatNumber and std::to_string lengths differ";
+}
+
+} // namespace
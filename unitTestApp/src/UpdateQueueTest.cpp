@@ -9,6 +9,7 @@
  */
 
 #include <memory>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <epicsTime.h>
@@ -215,4 +216,17 @@ TEST_F(UpdateQueueTest, pushUpdate_EmptyQueue_wasFirstIsCorrect) {
     EXPECT_EQ(wasFirst, false) << "Second push does not set wasFirst = false";
 }
 
+TEST_F(UpdateQueueTest, forEach_UsedQueue_VisitsInOrder) {
+    std::vector<int> data;
+    q1.forEach([&data](const TestUpdate &u) { data.push_back(u.getData()); });
+    EXPECT_EQ(data.size(), 3lu) << "forEach visited " << data.size() << " updates, not 3";
+    for (int i = 0; i < static_cast<int>(data.size()); i++)
+        EXPECT_EQ(data[i], i) << "forEach visit " << i << " returned data " << data[i];
+    EXPECT_EQ(q1.size(), 3lu) << "After forEach, update queue returns size " << q1.size() << " not 3";
+
+    int visits = 0;
+    q0.forEach([&visits](const TestUpdate &) { visits++; });
+    EXPECT_EQ(visits, 0) << "forEach on empty queue visited " << visits << " updates";
+}
+
 } // namespace
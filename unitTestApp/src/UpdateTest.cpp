@@ -132,4 +132,24 @@ TEST(UpdateTest, override_2xWithCounter_OverriddenDataCorrect) {
     EXPECT_EQ(i, 1) << "Update data (" << i << ") changed";
 }
 
+int deleted = 0;
+struct CountingDeleter {
+    void operator()(int *p) const { deleted++; delete p; }
+};
+typedef Update<int, unsigned short, CountingDeleter> DeleterUpdate;
+
+TEST(UpdateTest, override_WithDeleter_DroppedDataDeleted) {
+    epicsTime ts0;
+    ts0.getCurrent();
+    deleted = 0;
+    {
+        DeleterUpdate u0(ts0, ProcessReason::incomingData, std::unique_ptr<int, CountingDeleter>(new int(0)), 100);
+        DeleterUpdate u1(ts0 + 1.0, ProcessReason::incomingData, std::unique_ptr<int, CountingDeleter>(new int(1)), 101);
+        u0.override(u1);
+        EXPECT_EQ(deleted, 1) << "Overridden data not released through the deleter";
+        EXPECT_EQ(u0.getData(), 1) << "Update data differs from override data (1)";
+    }
+    EXPECT_EQ(deleted, 2) << "Update data not released through the deleter";
+}
+
 } // namespace
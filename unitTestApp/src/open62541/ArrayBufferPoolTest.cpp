@@ -0,0 +1,157 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include "ArrayBufferPoolOpen62541.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+const size_t nelm = 4; // NELM of the record
+
+class ArrayBufferPoolTest : public ::testing::Test
+{
+protected:
+    ArrayBufferPoolTest()
+        : bptr(calloc(nelm, sizeof(UA_Double))) // like the record support
+    {}
+
+    ~ArrayBufferPoolTest() override { free(bptr); }
+
+    // Incoming update (array of n doubles, element i has the value base + i)
+    static UA_Variant incoming(const size_t n, const double base = 0.0)
+    {
+        UA_Variant v;
+        UA_Variant_init(&v);
+        UA_Double *data = static_cast<UA_Double *>(UA_Array_new(n, &UA_TYPES[UA_TYPES_DOUBLE]));
+        for (size_t i = 0; i < n; i++)
+            data[i] = base + i;
+        UA_Variant_setArray(&v, data, n, &UA_TYPES[UA_TYPES_DOUBLE]);
+        return v;
+    }
+
+    // Hand an update of NELM elements to the record, keeping the record's buffer in bptr
+    bool handOffNext(ArrayBufferPoolOpen62541 &pool, const double base = 0.0)
+    {
+        UA_Variant v = incoming(nelm, base);
+        bool done = pool.handOff(bptr, bptr, nelm, v);
+        UA_Variant_clear(&v);
+        return done;
+    }
+
+    void *bptr;
+};
+
+// Zero-copy hand-off
+
+TEST_F(ArrayBufferPoolTest, handOff_SwapsBuffer)
+{
+    {
+        ArrayBufferPoolOpen62541 pool(2);
+        UA_Variant v = incoming(nelm, 10.0);
+        void *data = v.data;
+        ASSERT_TRUE(pool.handOff(bptr, bptr, nelm, v)) << "matching array not handed off";
+        EXPECT_EQ(bptr, data) << "record doesn't use the update's buffer";
+        EXPECT_EQ(v.data, nullptr) << "update still owns its buffer";
+        EXPECT_EQ(v.arrayLength, 0u) << "update still has elements";
+        EXPECT_EQ(static_cast<UA_Double *>(bptr)[3], 13.0) << "record buffer has wrong contents";
+        EXPECT_EQ(pool.size(), 0u) << "record's own (calloc'd) buffer went to the pool";
+        UA_Variant_clear(&v);
+
+        ASSERT_TRUE(handOffNext(pool, 20.0)) << "second array not handed off";
+        EXPECT_EQ(static_cast<UA_Double *>(bptr)[0], 20.0) << "record buffer has wrong contents";
+        EXPECT_EQ(pool.size(), 1u) << "replaced buffer not pooled";
+        EXPECT_EQ(pool.memoryUsage(), nelm * sizeof(UA_Double)) << "wrong memory usage of the pool";
+    }
+    UA_free(bptr); // buffers handed to the record are allocated by open62541
+    bptr = nullptr;
+}
+
+TEST_F(ArrayBufferPoolTest, handOff_FallbackLengthMismatch)
+{
+    ArrayBufferPoolOpen62541 pool(2);
+    void *record = bptr;
+    UA_Variant shorter = incoming(nelm - 1);
+    EXPECT_FALSE(pool.handOff(bptr, bptr, nelm, shorter)) << "array with fewer than NELM elements handed off";
+    UA_Variant longer = incoming(nelm + 1);
+    EXPECT_FALSE(pool.handOff(bptr, bptr, nelm, longer)) << "array with more than NELM elements handed off";
+    EXPECT_EQ(bptr, record) << "record buffer replaced by mismatching array";
+    EXPECT_NE(shorter.data, nullptr) << "mismatching update lost its data";
+    EXPECT_EQ(shorter.arrayLength, nelm - 1) << "mismatching update changed";
+    UA_Variant_clear(&shorter);
+    UA_Variant_clear(&longer);
+}
+
+TEST_F(ArrayBufferPoolTest, handOff_FallbackOtherTarget)
+{
+    ArrayBufferPoolOpen62541 pool(2);
+    UA_Double other[nelm];
+    void *record = bptr;
+    UA_Variant v = incoming(nelm);
+    EXPECT_FALSE(pool.handOff(bptr, other, nelm, v)) << "array handed off when not reading into bptr";
+    EXPECT_EQ(bptr, record) << "record buffer replaced";
+
+    UA_Variant empty;
+    UA_Variant_init(&empty);
+    UA_Variant_setArray(&empty, UA_EMPTY_ARRAY_SENTINEL, 0, &UA_TYPES[UA_TYPES_DOUBLE]);
+    EXPECT_FALSE(pool.handOff(bptr, bptr, 0, empty)) << "empty array handed off";
+    EXPECT_EQ(bptr, record) << "record buffer replaced";
+    UA_Variant_clear(&v);
+}
+
+// Reusing pooled buffers
+
+TEST_F(ArrayBufferPoolTest, copy_UsesPooledBuffer)
+{
+    {
+        ArrayBufferPoolOpen62541 pool(2);
+        UA_Variant copy;
+        UA_Variant v = incoming(nelm, 5.0);
+        EXPECT_FALSE(pool.copy(v, &copy)) << "copy succeeded with an empty pool";
+
+        ASSERT_TRUE(handOffNext(pool));
+        void *pooled = bptr;
+        ASSERT_TRUE(handOffNext(pool));
+        ASSERT_EQ(pool.size(), 1u) << "replaced buffer not pooled";
+
+        UA_Variant other = incoming(nelm - 1);
+        EXPECT_FALSE(pool.copy(other, &copy)) << "pooled buffer used for a different size";
+        UA_Variant_clear(&other);
+
+        ASSERT_TRUE(pool.copy(v, &copy)) << "pooled buffer not used";
+        EXPECT_EQ(copy.data, pooled) << "copy doesn't use the pooled buffer";
+        EXPECT_EQ(copy.arrayLength, nelm) << "copy has wrong length";
+        EXPECT_EQ(copy.type, &UA_TYPES[UA_TYPES_DOUBLE]) << "copy has wrong type";
+        EXPECT_EQ(static_cast<UA_Double *>(copy.data)[2], 7.0) << "copy has wrong contents";
+        EXPECT_EQ(pool.size(), 0u) << "used buffer still in the pool";
+        UA_Variant_clear(&copy);
+        UA_Variant_clear(&v);
+    }
+    UA_free(bptr);
+    bptr = nullptr;
+}
+
+TEST_F(ArrayBufferPoolTest, pool_Bounded)
+{
+    {
+        ArrayBufferPoolOpen62541 pool(1);
+        for (int i = 0; i < 5; i++)
+            ASSERT_TRUE(handOffNext(pool, i)) << "array " << i << " not handed off";
+        EXPECT_EQ(pool.size(), 1u) << "pool grows beyond its max";
+    }
+    UA_free(bptr);
+    bptr = nullptr;
+}
+
+} // namespace
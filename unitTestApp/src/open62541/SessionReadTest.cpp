@@ -0,0 +1,168 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "SessionOpen62541.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+char nameA[] = "A";
+char nameB[] = "B";
+
+// Sharing nodes between the items of a read batch
+
+TEST(SessionReadTest, sortedNodeSet_RemovesDuplicates)
+{
+    std::vector<UA_NodeId> nodeIds = {
+        UA_NODEID_NUMERIC(2, 7),
+        UA_NODEID_STRING(2, nameB),
+        UA_NODEID_NUMERIC(2, 7),
+        UA_NODEID_NUMERIC(1, 9),
+        UA_NODEID_STRING(2, nameA),
+        UA_NODEID_STRING(2, nameB)
+    };
+    std::vector<UA_NodeId> nodeSet = sortedNodeSet(nodeIds);
+    ASSERT_EQ(nodeSet.size(), 4u) << "duplicate node ids not removed";
+    for (size_t i = 1; i < nodeSet.size(); i++)
+        EXPECT_TRUE(NodeIdLess()(nodeSet[i - 1], nodeSet[i])) << "node set not sorted at index " << i;
+}
+
+TEST(SessionReadTest, nodeSlots_DistinctInOrder)
+{
+    std::vector<UA_NodeId> nodeIds = {
+        UA_NODEID_NUMERIC(2, 1),
+        UA_NODEID_NUMERIC(2, 2),
+        UA_NODEID_NUMERIC(2, 3)
+    };
+    std::vector<UA_UInt32> slots = nodeSlots(nodeIds, sortedNodeSet(nodeIds));
+    EXPECT_EQ(slots, std::vector<UA_UInt32>({0, 1, 2})) << "sorted distinct items don't use their own slots";
+}
+
+TEST(SessionReadTest, nodeSlots_SharedNodes)
+{
+    std::vector<UA_NodeId> nodeIds = {
+        UA_NODEID_NUMERIC(2, 3),
+        UA_NODEID_STRING(2, nameA),
+        UA_NODEID_NUMERIC(2, 1),
+        UA_NODEID_NUMERIC(2, 3),
+        UA_NODEID_STRING(2, nameA),
+        UA_NODEID_NUMERIC(2, 3)
+    };
+    std::vector<UA_NodeId> nodeSet = sortedNodeSet(nodeIds);
+    ASSERT_EQ(nodeSet.size(), 3u) << "wrong number of distinct nodes";
+    std::vector<UA_UInt32> slots = nodeSlots(nodeIds, nodeSet);
+    ASSERT_EQ(slots.size(), nodeIds.size()) << "not one slot per item";
+    for (size_t k = 0; k < nodeIds.size(); k++) {
+        ASSERT_LT(slots[k], nodeSet.size()) << "slot of item " << k << " out of range";
+        EXPECT_TRUE(UA_NodeId_equal(&nodeSet[slots[k]], &nodeIds[k])) << "item " << k << " mapped to wrong node";
+    }
+    EXPECT_EQ(slots[0], slots[3]) << "items linking the same node don't share a slot";
+    EXPECT_EQ(slots[0], slots[5]) << "items linking the same node don't share a slot";
+    EXPECT_EQ(slots[1], slots[4]) << "items linking the same node don't share a slot";
+    EXPECT_NE(slots[0], slots[1]) << "items linking different nodes share a slot";
+    EXPECT_NE(slots[0], slots[2]) << "items linking different nodes share a slot";
+}
+
+// Fanning out the results to the items
+
+TEST(SessionReadTest, slotUsers_CountsItemsPerNode)
+{
+    EXPECT_TRUE(slotUsers(std::vector<UA_UInt32>()).empty()) << "empty batch has users";
+    EXPECT_EQ(slotUsers({0, 1, 2}), std::vector<UA_UInt32>({1, 1, 1})) << "distinct items don't have one user each";
+    EXPECT_EQ(slotUsers({2, 0, 1, 2, 0, 2}), std::vector<UA_UInt32>({2, 1, 3})) << "wrong number of users per node";
+}
+
+TEST(SessionReadTest, slotUsers_LastUserOfEveryNode)
+{
+    // readComplete hands the original result to the last item using a node, copies to the others
+    std::vector<UA_UInt32> slots = {2, 0, 1, 2, 0, 2};
+    std::vector<UA_UInt32> users = slotUsers(slots);
+    std::vector<size_t> originals;
+    for (size_t k = 0; k < slots.size(); k++)
+        if (!--users[slots[k]])
+            originals.push_back(k);
+    EXPECT_EQ(originals, std::vector<size_t>({2, 4, 5})) << "original results not handed to the last users";
+    EXPECT_EQ(users, std::vector<UA_UInt32>({0, 0, 0})) << "not all users served";
+}
+
+// Prepared reads
+
+typedef LruCache<std::vector<UA_NodeId>, PreparedRead, NodeIdsLess> PreparedReads;
+
+TEST(SessionReadTest, preparedRead_KeyIgnoresOrderAndDuplicates)
+{
+    std::vector<UA_NodeId> batch1 = {
+        UA_NODEID_NUMERIC(2, 3),
+        UA_NODEID_STRING(2, nameA),
+        UA_NODEID_NUMERIC(2, 1)
+    };
+    std::vector<UA_NodeId> batch2 = {
+        UA_NODEID_NUMERIC(2, 1),
+        UA_NODEID_NUMERIC(2, 3),
+        UA_NODEID_STRING(2, nameA),
+        UA_NODEID_NUMERIC(2, 3)
+    };
+    std::vector<UA_NodeId> batch3 = {
+        UA_NODEID_NUMERIC(2, 1),
+        UA_NODEID_NUMERIC(2, 3)
+    };
+
+    PreparedReads cache(4);
+    cache.insert(sortedNodeSet(batch1));
+    EXPECT_NE(cache.find(sortedNodeSet(batch2)), nullptr) << "same nodes in different order use a different key";
+    EXPECT_EQ(cache.find(sortedNodeSet(batch3)), nullptr) << "subset of the nodes uses the same key";
+    EXPECT_EQ(cache.size(), 1u) << "lookups added entries";
+}
+
+TEST(SessionReadTest, prepareRead_TwoOperationsPerNode)
+{
+    std::vector<UA_NodeId> nodeSet = sortedNodeSet({ UA_NODEID_NUMERIC(2, 3), UA_NODEID_STRING(2, nameA) });
+    PreparedRead prepared;
+    SessionOpen62541::prepareRead(nodeSet, prepared);
+    ASSERT_EQ(prepared.nodesToRead.size(), 2 * nodeSet.size()) << "wrong number of read operations";
+    for (size_t i = 0; i < nodeSet.size(); i++) {
+        EXPECT_TRUE(UA_NodeId_equal(&prepared.nodesToRead[2 * i].nodeId, &nodeSet[i]))
+            << "data type operation " << i << " reads the wrong node";
+        EXPECT_EQ(prepared.nodesToRead[2 * i].attributeId, UA_ATTRIBUTEID_DATATYPE)
+            << "operation " << 2 * i << " doesn't read the data type";
+        EXPECT_TRUE(UA_NodeId_equal(&prepared.nodesToRead[2 * i + 1].nodeId, &nodeSet[i]))
+            << "value operation " << i << " reads the wrong node";
+        EXPECT_EQ(prepared.nodesToRead[2 * i + 1].attributeId, UA_ATTRIBUTEID_VALUE)
+            << "operation " << 2 * i + 1 << " doesn't read the value";
+    }
+}
+
+TEST(SessionReadTest, preparedRead_EvictsLeastRecentlyUsedBatch)
+{
+    std::vector<UA_NodeId> batch1 = sortedNodeSet({ UA_NODEID_NUMERIC(2, 1) });
+    std::vector<UA_NodeId> batch2 = sortedNodeSet({ UA_NODEID_NUMERIC(2, 2), UA_NODEID_NUMERIC(2, 1) });
+    std::vector<UA_NodeId> batch3 = sortedNodeSet({ UA_NODEID_STRING(2, nameB) });
+
+    PreparedReads cache(2);
+    SessionOpen62541::prepareRead(batch1, cache.insert(batch1));
+    SessionOpen62541::prepareRead(batch2, cache.insert(batch2));
+    ASSERT_NE(cache.find(batch1), nullptr) << "prepared read not found";
+    SessionOpen62541::prepareRead(batch3, cache.insert(batch3));
+
+    EXPECT_EQ(cache.size(), 2u) << "cache grows beyond its capacity";
+    EXPECT_EQ(cache.evicted(), 1u) << "wrong number of evictions";
+    EXPECT_EQ(cache.find(batch2), nullptr) << "least recently used batch not evicted";
+    PreparedRead *entry = cache.find(batch1);
+    ASSERT_NE(entry, nullptr) << "recently used batch evicted";
+    EXPECT_EQ(entry->nodesToRead.size(), 2u) << "kept prepared read was changed";
+    EXPECT_NE(cache.find(batch3), nullptr) << "new batch not added";
+}
+
+} // namespace
@@ -0,0 +1,118 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <menuPriority.h>
+
+#include "SubscriptionOpen62541.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+const size_t noTrigger = static_cast<size_t>(-1);
+
+ShardCandidate
+candidate (const int priority, const double samplingInterval, const size_t trigger = noTrigger)
+{
+    ShardCandidate c;
+    c.priority = priority;
+    c.samplingInterval = samplingInterval;
+    c.triggered = trigger != noTrigger;
+    c.trigger = trigger;
+    return c;
+}
+
+TEST(SubscriptionPlanTest, planShardGroups_Empty)
+{
+    std::vector<ShardCandidate> candidates;
+    EXPECT_TRUE(SubscriptionOpen62541::planShardGroups(candidates, 100.0, 0).empty())
+        << "empty node table creates shards";
+}
+
+TEST(SubscriptionPlanTest, planShardGroups_ByPriorityHighestFirst)
+{
+    std::vector<ShardCandidate> candidates = {
+        candidate(menuPriorityLOW, 100.0),
+        candidate(menuPriorityHIGH, 100.0),
+        candidate(menuPriorityLOW, 100.0),
+        candidate(menuPriorityMEDIUM, 100.0)
+    };
+    auto plans = SubscriptionOpen62541::planShardGroups(candidates, 100.0, 0);
+    ASSERT_EQ(plans.size(), 3u) << "wrong number of shards for 3 priorities";
+    EXPECT_EQ(plans[0].priority, menuPriorityHIGH) << "first shard is not the highest priority";
+    EXPECT_EQ(plans[0].members, std::vector<size_t>({1})) << "wrong members in HIGH shard";
+    EXPECT_EQ(plans[1].priority, menuPriorityMEDIUM) << "second shard is not MEDIUM priority";
+    EXPECT_EQ(plans[2].priority, menuPriorityLOW) << "last shard is not LOW priority";
+    EXPECT_EQ(plans[2].members, std::vector<size_t>({0, 2})) << "wrong members in LOW shard";
+}
+
+TEST(SubscriptionPlanTest, planShardGroups_BySamplingBand)
+{
+    std::vector<ShardCandidate> candidates = {
+        candidate(menuPriorityLOW, 100.0),
+        candidate(menuPriorityLOW, 1000.0),
+        candidate(menuPriorityLOW, 120.0),
+        candidate(menuPriorityLOW, 0.0),    // uses the default interval (1000 ms)
+        candidate(menuPriorityLOW, -1.0)    // uses the default interval (1000 ms)
+    };
+    auto plans = SubscriptionOpen62541::planShardGroups(candidates, 1000.0, 0);
+    ASSERT_EQ(plans.size(), 2u) << "wrong number of shards for 2 sampling bands";
+    EXPECT_EQ(plans[0].members, std::vector<size_t>({0, 2})) << "100 ms and 120 ms are not in the same shard";
+    EXPECT_EQ(plans[0].fastestSampling, 100.0) << "wrong fastest sampling interval in fast shard";
+    EXPECT_EQ(plans[1].members, std::vector<size_t>({1, 3, 4}))
+        << "default sampling interval does not join the publishing interval band";
+    EXPECT_EQ(plans[1].fastestSampling, 1000.0) << "wrong fastest sampling interval in slow shard";
+}
+
+TEST(SubscriptionPlanTest, planShardGroups_FastestSamplingNone)
+{
+    std::vector<ShardCandidate> candidates = { candidate(menuPriorityLOW, 0.0) };
+    auto plans = SubscriptionOpen62541::planShardGroups(candidates, 500.0, 0);
+    ASSERT_EQ(plans.size(), 1u) << "wrong number of shards";
+    EXPECT_EQ(plans[0].fastestSampling, 0.0) << "default sampling interval counts as fastest sampling";
+}
+
+TEST(SubscriptionPlanTest, planShardGroups_SplitAtMax)
+{
+    std::vector<ShardCandidate> candidates(5, candidate(menuPriorityLOW, 100.0));
+    candidates[4].samplingInterval = 70.0;
+    auto plans = SubscriptionOpen62541::planShardGroups(candidates, 100.0, 2);
+    ASSERT_EQ(plans.size(), 3u) << "5 entries with max 2 are not split into 3 shards";
+    EXPECT_EQ(plans[0].members, std::vector<size_t>({0, 1})) << "wrong members in first shard";
+    EXPECT_EQ(plans[1].members, std::vector<size_t>({2, 3})) << "wrong members in second shard";
+    EXPECT_EQ(plans[2].members, std::vector<size_t>({4})) << "wrong members in last shard";
+    EXPECT_EQ(plans[0].fastestSampling, 100.0) << "fastest sampling not computed per shard";
+    EXPECT_EQ(plans[2].fastestSampling, 70.0) << "fastest sampling not computed per shard";
+}
+
+TEST(SubscriptionPlanTest, planShardGroups_TriggeredJoinTheirTrigger)
+{
+    std::vector<ShardCandidate> candidates = {
+        candidate(menuPriorityHIGH, 100.0),
+        candidate(menuPriorityLOW, 5000.0, 0),      // triggered by 0
+        candidate(menuPriorityLOW, 5000.0),
+        candidate(menuPriorityHIGH, 5000.0, 1),     // triggered by a triggered entry
+        candidate(menuPriorityMEDIUM, 100.0, 99)    // unknown trigger
+    };
+    auto plans = SubscriptionOpen62541::planShardGroups(candidates, 1000.0, 0);
+    ASSERT_EQ(plans.size(), 3u) << "wrong number of shards";
+    EXPECT_EQ(plans[0].priority, menuPriorityHIGH) << "trigger shard has wrong priority";
+    EXPECT_EQ(plans[0].members, std::vector<size_t>({0, 1})) << "triggered entry doesn't join its trigger";
+    EXPECT_EQ(plans[1].priority, menuPriorityLOW) << "default shard has wrong priority";
+    EXPECT_EQ(plans[1].members, std::vector<size_t>({3, 4}))
+        << "entries with unknown or triggered trigger don't join the default group";
+    EXPECT_EQ(plans[2].members, std::vector<size_t>({2})) << "wrong members in slow LOW shard";
+}
+
+} // namespace
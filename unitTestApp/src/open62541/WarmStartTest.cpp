@@ -0,0 +1,171 @@
+/*************************************************************************\
+* Copyright (c) 2026 ITER Organization.
+* This module is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Author: Ralph Lange <ralph.lange@gmx.de>
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "ItemOpen62541.h"
+
+namespace {
+
+using namespace DevOpcua;
+
+std::string
+roundTrip (const UA_DataValue &in, UA_DataValue &out)
+{
+    std::stringstream ss;
+    ItemOpen62541::writeWarmStartValue(ss, in);
+    ss << " end";
+    UA_DataValue_init(&out);
+    if (!ItemOpen62541::readWarmStartValue(ss, out))
+        return "can't read back value";
+    std::string rest;
+    ss >> rest;
+    if (rest != "end")
+        return "value read didn't stop at the end of the entry";
+    return "";
+}
+
+// Warm-start file entries
+
+TEST(WarmStartTest, RoundTrip_ScalarWithTimeStamps)
+{
+    UA_Double d = 3.25;
+    UA_DataValue in;
+    UA_DataValue_init(&in);
+    UA_Variant_setScalarCopy(&in.value, &d, &UA_TYPES[UA_TYPES_DOUBLE]);
+    in.hasValue = true;
+    in.status = UA_STATUSCODE_UNCERTAININITIALVALUE;
+    in.hasStatus = true;
+    in.sourceTimestamp = 132000000000000000LL;
+    in.hasSourceTimestamp = true;
+    in.sourcePicoseconds = 42;
+    in.hasSourcePicoseconds = true;
+
+    UA_DataValue out;
+    ASSERT_EQ(roundTrip(in, out), "");
+    EXPECT_TRUE(UA_Variant_hasScalarType(&out.value, &UA_TYPES[UA_TYPES_DOUBLE])) << "wrong type or not a scalar";
+    EXPECT_EQ(*static_cast<UA_Double *>(out.value.data), d) << "value changed";
+    EXPECT_EQ(out.status, in.status) << "status changed";
+    EXPECT_TRUE(out.hasSourceTimestamp) << "source time stamp lost";
+    EXPECT_EQ(out.sourceTimestamp, in.sourceTimestamp) << "source time stamp changed";
+    EXPECT_EQ(out.sourcePicoseconds, 42) << "source picoseconds changed";
+    EXPECT_FALSE(out.hasServerTimestamp) << "missing server time stamp appeared";
+    UA_DataValue_clear(&in);
+    UA_DataValue_clear(&out);
+}
+
+TEST(WarmStartTest, RoundTrip_Int32Array)
+{
+    UA_Int32 a[] = { -1, 0, 7, 0x7fffffff };
+    UA_DataValue in;
+    UA_DataValue_init(&in);
+    UA_Variant_setArrayCopy(&in.value, a, 4, &UA_TYPES[UA_TYPES_INT32]);
+    in.hasValue = true;
+
+    UA_DataValue out;
+    ASSERT_EQ(roundTrip(in, out), "");
+    ASSERT_TRUE(UA_Variant_hasArrayType(&out.value, &UA_TYPES[UA_TYPES_INT32])) << "wrong type or not an array";
+    ASSERT_EQ(out.value.arrayLength, 4u) << "array length changed";
+    for (size_t i = 0; i < 4; i++)
+        EXPECT_EQ(static_cast<UA_Int32 *>(out.value.data)[i], a[i]) << "element " << i << " changed";
+    UA_DataValue_clear(&in);
+    UA_DataValue_clear(&out);
+}
+
+TEST(WarmStartTest, RoundTrip_StringArray)
+{
+    UA_String s[] = { UA_STRING_STATIC("with blanks\nand new line"), UA_STRING_STATIC(""), UA_STRING_STATIC("x") };
+    UA_DataValue in;
+    UA_DataValue_init(&in);
+    UA_Variant_setArrayCopy(&in.value, s, 3, &UA_TYPES[UA_TYPES_STRING]);
+    in.hasValue = true;
+
+    UA_DataValue out;
+    ASSERT_EQ(roundTrip(in, out), "");
+    ASSERT_TRUE(UA_Variant_hasArrayType(&out.value, &UA_TYPES[UA_TYPES_STRING])) << "wrong type or not an array";
+    ASSERT_EQ(out.value.arrayLength, 3u) << "array length changed";
+    for (size_t i = 0; i < 3; i++)
+        EXPECT_TRUE(UA_String_equal(&static_cast<UA_String *>(out.value.data)[i], &s[i]))
+            << "element " << i << " changed";
+    UA_DataValue_clear(&in);
+    UA_DataValue_clear(&out);
+}
+
+TEST(WarmStartTest, Read_RejectsUnsupportedAndDamaged)
+{
+    UA_DataValue out;
+    UA_DataValue_init(&out);
+
+    std::stringstream unsupported;
+    unsupported << UA_TYPES_LOCALIZEDTEXT << " 1 1 0 0 0 0 0 0:";
+    EXPECT_FALSE(ItemOpen62541::readWarmStartValue(unsupported, out)) << "unsupported data type accepted";
+
+    std::stringstream badType;
+    badType << UA_TYPES_COUNT << " 1 1 0 0 0 0 0 8:12345678";
+    EXPECT_FALSE(ItemOpen62541::readWarmStartValue(badType, out)) << "data type index out of range accepted";
+
+    std::stringstream scalarArray;
+    scalarArray << UA_TYPES_DOUBLE << " 1 2 0 0 0 0 0 16:1234567812345678";
+    EXPECT_FALSE(ItemOpen62541::readWarmStartValue(scalarArray, out)) << "scalar with 2 elements accepted";
+
+    std::stringstream shortData;
+    shortData << UA_TYPES_DOUBLE << " 0 2 0 0 0 0 0 8:12345678";
+    EXPECT_FALSE(ItemOpen62541::readWarmStartValue(shortData, out)) << "data shorter than the array accepted";
+
+    std::stringstream missingString;
+    missingString << UA_TYPES_STRING << " 0 2 0 0 0 0 0 1:a";
+    EXPECT_FALSE(ItemOpen62541::readWarmStartValue(missingString, out)) << "missing array element accepted";
+
+    EXPECT_FALSE(out.hasValue) << "value set by failed read";
+}
+
+// Size limit
+
+TEST(WarmStartTest, warmStartBytes_CountsStringPayloads)
+{
+    UA_Double d[10] = {};
+    UA_Variant doubles;
+    UA_Variant_setArray(&doubles, d, 10, &UA_TYPES[UA_TYPES_DOUBLE]);
+    EXPECT_EQ(ItemOpen62541::warmStartBytes(doubles, &UA_TYPES[UA_TYPES_DOUBLE]), 10 * sizeof(UA_Double))
+        << "wrong size of a double array";
+
+    UA_String s[2] = { UA_STRING_STATIC("abc"), UA_STRING_STATIC("de") };
+    UA_Variant strings;
+    UA_Variant_setArray(&strings, s, 2, &UA_TYPES[UA_TYPES_STRING]);
+    EXPECT_EQ(ItemOpen62541::warmStartBytes(strings, &UA_TYPES[UA_TYPES_STRING]), 2 * sizeof(UA_String) + 5)
+        << "string payloads not counted";
+
+    UA_Variant empty;
+    UA_Variant_setArray(&empty, UA_EMPTY_ARRAY_SENTINEL, 0, &UA_TYPES[UA_TYPES_STRING]);
+    EXPECT_EQ(ItemOpen62541::warmStartBytes(empty, &UA_TYPES[UA_TYPES_STRING]), 0u)
+        << "empty array has a size";
+}
+
+TEST(WarmStartTest, warmStartBytes_CapAppliesToPayloads)
+{
+    const size_t half = ItemOpen62541::warmStartMaxBytes / 2;
+    std::string big(half, 'x');
+    UA_String s[2];
+    s[0].length = s[1].length = big.length();
+    s[0].data = s[1].data = reinterpret_cast<UA_Byte *>(&big[0]);
+    UA_Variant strings;
+
+    UA_Variant_setArray(&strings, s, 1, &UA_TYPES[UA_TYPES_STRING]);
+    EXPECT_LE(ItemOpen62541::warmStartBytes(strings, &UA_TYPES[UA_TYPES_STRING]), ItemOpen62541::warmStartMaxBytes)
+        << "half the max size is above the cap";
+    UA_Variant_setArray(&strings, s, 2, &UA_TYPES[UA_TYPES_STRING]);
+    EXPECT_GT(ItemOpen62541::warmStartBytes(strings, &UA_TYPES[UA_TYPES_STRING]), ItemOpen62541::warmStartMaxBytes)
+        << "two strings of half the max size are not above the cap";
+}
+
+} // namespace